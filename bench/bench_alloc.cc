@@ -0,0 +1,39 @@
+#include "bench_utils.h"
+
+#include <cstdlib>
+#include <new>
+
+/* count every global allocation so benchmarks can report allocations per operation */
+/* counters are per thread, so counting adds no contention to multithreaded runs */
+static thread_local size_t allocation_count = 0;
+static thread_local size_t allocated_bytes  = 0;
+
+size_t bench::AllocationCount()
+{
+    return allocation_count;
+}
+
+size_t bench::AllocatedBytes()
+{
+    return allocated_bytes;
+}
+
+/* forward to malloc, so an allocator linked in or preloaded in its place is what gets measured */
+void* operator new(size_t size)
+{
+    allocation_count++;
+    allocated_bytes += size;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
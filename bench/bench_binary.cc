@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+static std::string const& Document()
+{
+    static std::string content = [] {
+        std::string result = "[";
+        for (int i = 0; i < 500; i++) {
+            if (i > 0)
+                result += ",";
+            result += R"({"id":)" + std::to_string(1000000 + i) + R"(,"user":"user_)" +
+                      std::to_string(i) + R"(","text":"a reasonably long message body number )" +
+                      std::to_string(i) + R"(","coords":[)" + std::to_string(i * 0.125) + "," +
+                      std::to_string(-i * 0.5) + R"(],"retweets":)" + std::to_string(i % 17) +
+                      R"(,"verified":)" + (i % 3 ? "true" : "false") + R"(,"reply":null})";
+        }
+        return result + "]";
+    }();
+    return content;
+}
+
+static void BM_BinaryStringify(benchmark::State& state)
+{
+    auto   root = tijson::Parser::Parse(Document());
+    size_t size = 0;
+    for (auto _ : state) {
+        auto out = root.Stringify();
+        size     = out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["size"] = static_cast<double>(size);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_BinaryStringify);
+
+template<class Codec>
+static void BM_BinaryEncode(benchmark::State& state)
+{
+    auto        root = tijson::Parser::Parse(Document());
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        Codec::Encode(root, out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["size"] = static_cast<double>(out.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+BENCHMARK_TEMPLATE(BM_BinaryEncode, tijson::MsgPack);
+BENCHMARK_TEMPLATE(BM_BinaryEncode, tijson::Cbor);
+
+static void BM_BinaryParse(benchmark::State& state)
+{
+    auto text = tijson::Parser::Parse(Document()).Stringify();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tijson::Parser::Parse(text));
+    state.counters["size"] = static_cast<double>(text.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_BinaryParse);
+
+template<class Codec>
+static void BM_BinaryDecode(benchmark::State& state)
+{
+    auto data = Codec::Encode(tijson::Parser::Parse(Document()));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Codec::Decode(data));
+    state.counters["size"] = static_cast<double>(data.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK_TEMPLATE(BM_BinaryDecode, tijson::MsgPack);
+BENCHMARK_TEMPLATE(BM_BinaryDecode, tijson::Cbor);
@@ -0,0 +1,51 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <tijson.h>
+
+// Columnar extraction of record arrays: throughput of a DOM parse against Columns::FromJson on
+// the twitter statuses, and summing one field row by row against summing its INT64 column.
+
+using bench::CORPUS;
+
+static std::string const& Records()
+{
+    static std::string const records =
+        tijson::Parser::Parse(bench::Corpus(CORPUS::TWITTER))["statuses"].Stringify();
+    return records;
+}
+
+static void BM_ColumnsExtract(benchmark::State& state)
+{
+    auto const& content = Records();
+    for (auto _ : state) {
+        if (state.range(0))
+            benchmark::DoNotOptimize(tijson::Columns::FromJson(content));
+        else
+            benchmark::DoNotOptimize(tijson::Parser::Parse(content));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * Records().size()));
+}
+
+static void BM_ColumnsSum(benchmark::State& state)
+{
+    auto const& content = Records();
+    auto        val     = tijson::Parser::Parse(content);
+    auto        columns = tijson::Columns::FromJson(content);
+    auto const& retweet = columns.Find("retweet_count")->GetInt64s();
+    for (auto _ : state) {
+        int64_t sum = 0;
+        if (state.range(0)) {
+            sum = std::accumulate(retweet.begin(), retweet.end(), int64_t(0));
+        }
+        else {
+            for (auto const& status : val.GetArray())
+                sum += static_cast<int64_t>(status.Find("retweet_count")->GetNumber());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_ColumnsExtract)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ColumnsSum)->Arg(0)->Arg(1);
@@ -0,0 +1,47 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Reformatting json text: Formatter against Parse followed by Stringify, on every corpus, and
+// the formatter fed in 4 KiB chunks as if read from a stream.
+
+using bench::CORPUS;
+
+static void BM_FormatMinify(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS(state.range(0)));
+    for (auto _ : state) {
+        if (state.range(1))
+            benchmark::DoNotOptimize(tijson::Formatter::Minify(content));
+        else
+            benchmark::DoNotOptimize(tijson::Parser::Parse(content).Stringify());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_FormatChunks(benchmark::State& state)
+{
+    auto const&       content = bench::Corpus(CORPUS(state.range(0)));
+    std::string_view  view(content);
+    tijson::Formatter formatter(tijson::Formatter::STYLE::PRETTY, 2);
+    std::string       out;
+    for (auto _ : state) {
+        out.clear();
+        for (size_t pos = 0; pos < view.size(); pos += 4096)
+            formatter.Feed(view.substr(pos, 4096), out);
+        formatter.Finish();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+BENCHMARK(BM_FormatMinify)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::TWITTER), int(CORPUS::CITM),
+                    int(CORPUS::STRINGS), int(CORPUS::ESCAPES)},
+                   {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FormatChunks)
+    ->Arg(int(CORPUS::TWITTER))
+    ->Arg(int(CORPUS::CITM))
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,45 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <tijson.h>
+
+// Concurrent reads of a shared document: each read looks up a few fields of one status of the
+// twitter corpus, under a mutex around a plain Value against a SharedDocument snapshot of the
+// frozen Value, on one and on several threads.
+
+using bench::CORPUS;
+
+static tijson::Value const& Document()
+{
+    static tijson::Value const val = tijson::Parser::Parse(bench::Corpus(CORPUS::TWITTER));
+    return val;
+}
+
+static double ReadStatus(tijson::Value const& val, size_t index)
+{
+    auto const& status = val["statuses"][index % 100];
+    return status["user"]["followers_count"].GetNumber() + status["retweet_count"].GetNumber();
+}
+
+static void BM_FrozenRead(benchmark::State& state)
+{
+    static std::mutex             mutex;
+    static tijson::Value          locked = Document();
+    static tijson::SharedDocument shared(Document());
+    size_t                        index = static_cast<size_t>(state.thread_index()) * 7;
+    for (auto _ : state) {
+        double sum = 0;
+        if (state.range(0)) {
+            auto snapshot = shared.Load();
+            sum           = ReadStatus(*snapshot, index++);
+        }
+        else {
+            std::lock_guard<std::mutex> lock(mutex);
+            sum = ReadStatus(locked, index++);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_FrozenRead)->Arg(0)->Arg(1)->Threads(1)->Threads(4)->UseRealTime();
@@ -0,0 +1,41 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Structural hashing: Hash of a whole document, and change detection with operator== between a
+// document and a copy changed in one deep leaf, on plain values against frozen values whose
+// stored hashes let the comparison stop at the root.
+
+using bench::CORPUS;
+
+static void BM_Hash(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS(state.range(0)));
+    auto        val     = tijson::Parser::Parse(content);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(val.Hash());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_HashEqual(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS::TWITTER);
+    auto        val     = tijson::Parser::Parse(content);
+    auto        changed = val;
+    auto&       last    = changed["statuses"].GetArray().back();
+    last["user"]["followers_count"] = last["user"]["followers_count"].GetNumber() + 1;
+    if (state.range(0)) {
+        val.Freeze();
+        changed.Freeze();
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(val == changed);
+}
+
+BENCHMARK(BM_Hash)
+    ->Arg(int(CORPUS::CANADA))
+    ->Arg(int(CORPUS::TWITTER))
+    ->Arg(int(CORPUS::CITM))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashEqual)->Arg(0)->Arg(1);
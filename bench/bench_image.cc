@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+static std::string const& Document()
+{
+    static std::string content = [] {
+        std::string result = "{";
+        for (int i = 0; i < 2000; i++) {
+            if (i > 0)
+                result += ",";
+            result += R"("key_)" + std::to_string(i) + R"(":{"id":)" + std::to_string(i) +
+                      R"(,"name":"entry number )" + std::to_string(i) + R"(","weight":)" +
+                      std::to_string(i * 0.25) + R"(,"flags":[true,false,null]})";
+        }
+        return result + "}";
+    }();
+    return content;
+}
+
+/* startup of a reader: parse the text, then look one entry up */
+static void BM_StartupParse(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto root = tijson::Parser::Parse(Document());
+        benchmark::DoNotOptimize(root["key_1234"]["weight"].GetNumber());
+    }
+}
+BENCHMARK(BM_StartupParse);
+
+/* startup of a reader: open a shared image in place, then look one entry up */
+static void BM_StartupImage(benchmark::State& state)
+{
+    auto image = tijson::Image::Write(tijson::Parser::Parse(Document()));
+    for (auto _ : state) {
+        auto root = tijson::Image::Open(image.data(), image.size());
+        benchmark::DoNotOptimize(root["key_1234"]["weight"].GetNumber());
+    }
+    state.counters["size"] = static_cast<double>(image.size());
+}
+BENCHMARK(BM_StartupImage);
+
+static void BM_ImageWrite(benchmark::State& state)
+{
+    auto        root = tijson::Parser::Parse(Document());
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        tijson::Image::Write(root, out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+BENCHMARK(BM_ImageWrite);
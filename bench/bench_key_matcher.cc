@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// fixed-shape records: every record carries the same ten keys
+static constexpr std::string_view kRecord = R"({
+    "id" : 1024, "ts" : 1700000000, "user" : "meow", "score" : 98.5, "active" : true,
+    "region" : "eu-west", "retries" : 3, "latency" : 12.25, "status" : "ok", "parent" : null
+})";
+
+static constexpr auto kKeys = tijson::MakeKeyMatcher(
+    "id", "ts", "user", "score", "active", "region", "retries", "latency", "status", "parent");
+
+static void BM_ParseObjectInto(benchmark::State& state)
+{
+    std::array<tijson::Value, kKeys.size()> slots;
+    for (auto _ : state) {
+        tijson::Parser::ParseObjectInto(kRecord, kKeys, slots);
+        double sum = slots[0].GetNumber() + slots[3].GetNumber() + slots[6].GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kRecord.size()));
+}
+BENCHMARK(BM_ParseObjectInto);
+
+static void BM_ParseThenIndex(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto   root = tijson::Parser::Parse(kRecord);
+        double sum  = root["id"].GetNumber() + root["score"].GetNumber() +
+                     root["retries"].GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kRecord.size()));
+}
+BENCHMARK(BM_ParseThenIndex);
+
+static void BM_KeyMatcherFind(benchmark::State& state)
+{
+    for (auto _ : state) {
+        for (size_t i = 0; i < kKeys.size(); i++)
+            benchmark::DoNotOptimize(kKeys.Find(kKeys.Key(i)));
+    }
+}
+BENCHMARK(BM_KeyMatcherFind);
+
+static void BM_UnorderedMapFind(benchmark::State& state)
+{
+    tijson::Object object;
+    for (size_t i = 0; i < kKeys.size(); i++)
+        object[std::string(kKeys.Key(i))] = static_cast<double>(i);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kKeys.size(); i++)
+            benchmark::DoNotOptimize(object.find(std::string(kKeys.Key(i))));
+    }
+}
+BENCHMARK(BM_UnorderedMapFind);
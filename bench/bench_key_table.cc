@@ -0,0 +1,76 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Key interning on record-array corpora: throughput of a plain parse against a parse with a
+// fresh or a shared KeyTable, and the heap bytes the resulting document holds.
+
+using bench::CORPUS;
+
+static void SetMemory(benchmark::State& state, tijson::Value const& val, tijson::KeyTable const* table)
+{
+    auto report                   = val.MemoryUsage();
+    state.counters["doc_bytes"]   = static_cast<double>(report.Total());
+    state.counters["table_bytes"] = table ? static_cast<double>(table->MemoryUsage()) : 0;
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * bench::Corpus(CORPUS(state.range(0))).size()));
+}
+
+static void BM_KeyTableParsePlain(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS(state.range(0)));
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content);
+    SetMemory(state, val, nullptr);
+}
+
+static void BM_KeyTableParseFresh(benchmark::State& state)
+{
+    auto const&                       content = bench::Corpus(CORPUS(state.range(0)));
+    tijson::Value                     val;
+    std::shared_ptr<tijson::KeyTable> table;
+    for (auto _ : state) {
+        table = std::make_shared<tijson::KeyTable>();
+        val   = tijson::Parser::Parse(content, table);
+    }
+    SetMemory(state, val, table.get());
+}
+
+/* a long-lived table, keys are interned once and every later parse only looks them up */
+static void BM_KeyTableParseShared(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS(state.range(0)));
+    auto          table   = std::make_shared<tijson::KeyTable>(true);
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content, table);
+    SetMemory(state, val, table.get());
+}
+
+/* lookup of one field per record, by string and by interned key */
+static void BM_KeyTableLookup(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS::TWITTER);
+    auto        table   = std::make_shared<tijson::KeyTable>();
+    auto        val     = state.range(0) ? tijson::Parser::Parse(content, table)
+                                         : tijson::Parser::Parse(content);
+    auto const& statuses = val["statuses"].GetArray();
+    auto        key      = table->Intern("retweet_count");
+    for (auto _ : state) {
+        double sum = 0;
+        for (auto const& status : statuses)
+            sum += state.range(0) ? status.Find(key)->GetNumber()
+                                  : status.Find("retweet_count")->GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+#define RECORD_CORPORA(BM) \
+    BENCHMARK(BM)->Arg(int(CORPUS::TWITTER))->Arg(int(CORPUS::CITM))->Unit(benchmark::kMillisecond)
+
+RECORD_CORPORA(BM_KeyTableParsePlain);
+RECORD_CORPORA(BM_KeyTableParseFresh);
+RECORD_CORPORA(BM_KeyTableParseShared);
+BENCHMARK(BM_KeyTableLookup)->Arg(0)->Arg(1);
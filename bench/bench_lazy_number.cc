@@ -0,0 +1,44 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Lazy numbers on numeric corpora: a parse converting every number against a parse with
+// lazy_numbers, and a parse followed by Stringify, where unread numbers are written from their
+// text instead of being formatted with %.17g.
+
+using bench::CORPUS;
+
+static tijson::ParseOptions LazyNumbers()
+{
+    tijson::ParseOptions options;
+    options.lazy_numbers = true;
+    return options;
+}
+
+static void BM_LazyNumberParse(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS(state.range(0)));
+    auto          options = state.range(1) ? LazyNumbers() : tijson::ParseOptions();
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content, options);
+    state.counters["doc_bytes"] = static_cast<double>(val.MemoryUsage().Total());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_LazyNumberRoundTrip(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS(state.range(0)));
+    auto        options = state.range(1) ? LazyNumbers() : tijson::ParseOptions();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tijson::Parser::Parse(content, options).Stringify());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+BENCHMARK(BM_LazyNumberParse)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::NUMBERS)}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LazyNumberRoundTrip)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::NUMBERS)}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <tijson.h>
+
+// Packed number arrays on numeric corpora: throughput of a plain parse against a parse with
+// pack_numbers, the heap bytes the resulting document holds, and summing an array item by item
+// against summing its NumberSpan.
+
+using bench::CORPUS;
+
+static tijson::ParseOptions PackNumbers()
+{
+    tijson::ParseOptions options;
+    options.pack_numbers = true;
+    return options;
+}
+
+static void BM_PackedParse(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS(state.range(0)));
+    auto          options = state.range(1) ? PackNumbers() : tijson::ParseOptions();
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content, options);
+    state.counters["doc_bytes"] = static_cast<double>(val.MemoryUsage().Total());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_PackedSum(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS::NUMBERS);
+    auto        plain   = tijson::Parser::Parse(content);
+    auto        pack    = tijson::Parser::Parse(content, PackNumbers());
+    for (auto _ : state) {
+        double sum = 0;
+        if (state.range(0)) {
+            auto span = pack.GetNumberSpan();
+            sum       = std::accumulate(span.begin(), span.end(), 0.0);
+        }
+        else {
+            for (auto const& item : plain.GetArray())
+                sum += item.GetNumber();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_PackedParse)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::NUMBERS)}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PackedSum)->Arg(0)->Arg(1);
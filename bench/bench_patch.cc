@@ -0,0 +1,43 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// JSON Patch on a record corpus changed in one leaf: time to diff the two documents and to apply
+// the patch, with the bytes of the patch against the bytes of the whole document it replaces.
+
+using bench::CORPUS;
+
+static tijson::Value Changed(tijson::Value val)
+{
+    auto& statuses = val["statuses"].GetArray();
+    statuses[statuses.size() / 2]["user"]["followers_count"] = -1;
+    return val;
+}
+
+static void BM_PatchDiff(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS::TWITTER);
+    auto          from    = tijson::Parser::Parse(content);
+    auto          to      = Changed(from);
+    tijson::Value patch;
+    for (auto _ : state)
+        patch = tijson::Patch::Diff(from, to);
+    state.counters["patch_bytes"] = static_cast<double>(patch.Stringify().size());
+    state.counters["doc_bytes"]   = static_cast<double>(to.Stringify().size());
+}
+
+static void BM_PatchApply(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS::TWITTER);
+    auto        from    = tijson::Parser::Parse(content);
+    auto        patch   = tijson::Patch::Diff(from, Changed(from));
+    auto        undo    = tijson::Patch::Diff(Changed(from), from);
+    for (auto _ : state) {
+        tijson::Patch::Apply(from, patch);
+        tijson::Patch::Apply(from, undo);
+    }
+}
+
+BENCHMARK(BM_PatchDiff)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PatchApply)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,40 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+static tijson::Value const& Document()
+{
+    static tijson::Value root = tijson::Parser::Parse(bench::Corpus(bench::CORPUS::TWITTER));
+    return root;
+}
+
+static void BM_PointerOperatorIndex(benchmark::State& state)
+{
+    auto const& root = Document();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(root["statuses"][size_t(123)]["entities"]["urls"][size_t(0)]
+                                     ["indices"][size_t(1)]
+                                         .GetNumber());
+}
+BENCHMARK(BM_PointerOperatorIndex);
+
+static void BM_PointerGet(benchmark::State& state)
+{
+    auto const&     root = Document();
+    tijson::Pointer pointer("/statuses/123/entities/urls/0/indices/1");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pointer.Get(root)->GetNumber());
+}
+BENCHMARK(BM_PointerGet);
+
+static void BM_PointerResolve(benchmark::State& state)
+{
+    auto const&                  root = Document();
+    std::vector<tijson::Pointer> pointers;
+    for (auto field : {"id", "text", "retweet_count", "user/name", "user/followers_count"})
+        pointers.emplace_back(std::string("/statuses/123/") + field);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tijson::Pointer::Resolve(root, pointers));
+}
+BENCHMARK(BM_PointerResolve);
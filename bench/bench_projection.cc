@@ -0,0 +1,60 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+/* a batch of wide records, of which the ingest keeps about ten fields */
+static std::string const& Records()
+{
+    static std::string content = [] {
+        bench::Random rand(7);
+        std::string   result = "[";
+        for (int i = 0; i < 200; i++) {
+            result += i ? ",{" : "{";
+            result += R"("user":{"id":)" + std::to_string(i) + R"(,"name":")" +
+                      bench::Word(rand, 12) + R"(","bio":")" + bench::Word(rand, 80) + R"("},)";
+            result += R"("ts":)" + std::to_string(1700000000 + i) + ",";
+            result += R"("items":[{"sku":")" + bench::Word(rand, 8) + R"(","qty":1,"price":9.5},)"
+                      R"({"sku":")" + bench::Word(rand, 8) + R"(","qty":2,"price":0.25}],)";
+            for (int f = 0; f < 200; f++)
+                result += R"("field_)" + std::to_string(f) + R"(":)" +
+                          (f % 3 == 0   ? "\"" + bench::Word(rand, 16) + "\""
+                           : f % 3 == 1 ? bench::Format("%.17g", rand.Real(-1e3, 1e3))
+                                        : std::string("[true,null,{\"x\":1}]")) +
+                          (f + 1 < 200 ? "," : "");
+            result += "}";
+        }
+        return result + "]";
+    }();
+    return content;
+}
+
+static void BM_ProjectionFullParse(benchmark::State& state)
+{
+    size_t allocations = bench::AllocationCount();
+    for (auto _ : state) {
+        auto root = tijson::Parser::Parse(Records());
+        benchmark::DoNotOptimize(root);
+    }
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(bench::AllocationCount() - allocations),
+                           benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * Records().size()));
+}
+BENCHMARK(BM_ProjectionFullParse)->Unit(benchmark::kMicrosecond);
+
+static void BM_ProjectionParse(benchmark::State& state)
+{
+    tijson::Projection projection{"/*/user/id", "/*/ts", "/*/items/*/sku", "/*/field_7",
+                                  "/*/field_100"};
+    size_t             allocations = bench::AllocationCount();
+    for (auto _ : state) {
+        auto root = tijson::Parser::Parse(Records(), projection);
+        benchmark::DoNotOptimize(root);
+    }
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(bench::AllocationCount() - allocations),
+                           benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * Records().size()));
+}
+BENCHMARK(BM_ProjectionParse)->Unit(benchmark::kMicrosecond);
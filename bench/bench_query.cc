@@ -0,0 +1,67 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+/* a routed message: a small header followed by a large body */
+static std::string const& Message()
+{
+    static std::string content = [] {
+        bench::Random rand(11);
+        std::string   result = R"({"header":{"type":"order","id":42,"source":"edge-7"},"body":[)";
+        for (int i = 0; i < 100; i++)
+            result += std::string(i ? "," : "") + R"({"sku":")" + bench::Word(rand, 10) +
+                      R"(","qty":)" + std::to_string(rand.Next() % 10) + R"(,"note":")" +
+                      bench::Word(rand, 40) + R"("})";
+        return result + "]}";
+    }();
+    return content;
+}
+
+static void BM_QueryParseThenIndex(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto root = tijson::Parser::Parse(Message());
+        benchmark::DoNotOptimize(root["header"]["type"].GetStringView());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * Message().size()));
+}
+BENCHMARK(BM_QueryParseThenIndex);
+
+static void BM_QueryPointer(benchmark::State& state)
+{
+    auto query = tijson::Query::Compile("/header/type");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(query.First(Message())->GetRawString());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * Message().size()));
+}
+BENCHMARK(BM_QueryPointer);
+
+/* every id of a document, the whole text is walked */
+static void BM_QueryWildcardParseThenIndex(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(bench::CORPUS::TWITTER);
+    for (auto _ : state) {
+        auto   root = tijson::Parser::Parse(content);
+        double sum  = 0;
+        for (auto const& status : root["statuses"].GetArray())
+            sum += status["id"].GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+BENCHMARK(BM_QueryWildcardParseThenIndex);
+
+static void BM_QueryWildcard(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(bench::CORPUS::TWITTER);
+    auto        query   = tijson::Query::Compile("$.statuses[*].id");
+    for (auto _ : state) {
+        double sum = 0;
+        for (auto const& match : query.Evaluate(content))
+            sum += match.GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+BENCHMARK(BM_QueryWildcard);
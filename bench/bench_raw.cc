@@ -0,0 +1,39 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Raw passthrough: wrapping an upstream body in an envelope by parsing and stringifying it,
+// against keeping it as a checked raw fragment, and parsing a document with one subtree kept raw.
+
+using bench::CORPUS;
+
+static void BM_RawEnvelope(benchmark::State& state)
+{
+    auto const& content = bench::Corpus(CORPUS::TWITTER);
+    for (auto _ : state) {
+        tijson::Value envelope = tijson::Object{{"status", 200}};
+        if (state.range(0))
+            envelope["body"].SetRaw(std::string(content));
+        else
+            envelope["body"] = tijson::Parser::Parse(content);
+        benchmark::DoNotOptimize(envelope.Stringify());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_RawParse(benchmark::State& state)
+{
+    auto const&          content = bench::Corpus(CORPUS::TWITTER);
+    tijson::ParseOptions options;
+    if (state.range(0))
+        options.raw = tijson::Projection{"/statuses"};
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content, options);
+    state.counters["doc_bytes"] = static_cast<double>(val.MemoryUsage().Total());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+BENCHMARK(BM_RawEnvelope)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RawParse)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
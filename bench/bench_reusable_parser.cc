@@ -0,0 +1,64 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Parsing one document after another: Parse into a new Value against a ReusableParser that
+// parses into the Value of the previous document, with the heap allocations of each call. The
+// records case parses the statuses of the twitter corpus as separate documents.
+
+using bench::CORPUS;
+
+static void Count(benchmark::State& state, size_t allocations, size_t bytes)
+{
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(bench::AllocationCount() - allocations),
+                           benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+static void BM_ReuseDocument(benchmark::State& state)
+{
+    auto const&            content = bench::Corpus(CORPUS(state.range(0)));
+    tijson::ReusableParser parser;
+    tijson::Value          val;
+    parser.ParseInto(content, val);
+    size_t allocations = bench::AllocationCount();
+    for (auto _ : state) {
+        if (state.range(1))
+            parser.ParseInto(content, val);
+        else
+            val = tijson::Parser::Parse(content);
+    }
+    Count(state, allocations, content.size());
+}
+
+static void BM_ReuseRecords(benchmark::State& state)
+{
+    auto                     twitter = tijson::Parser::Parse(bench::Corpus(CORPUS::TWITTER));
+    std::vector<std::string> records;
+    size_t                   bytes = 0;
+    for (auto const& status : twitter["statuses"].GetArray())
+        bytes += records.emplace_back(status.Stringify()).size();
+    tijson::ReusableParser parser;
+    tijson::Value          val;
+    for (auto const& record : records)
+        parser.ParseInto(record, val);
+    size_t allocations = bench::AllocationCount();
+    for (auto _ : state) {
+        for (auto const& record : records) {
+            if (state.range(0))
+                parser.ParseInto(record, val);
+            else
+                val = tijson::Parser::Parse(record);
+        }
+    }
+    Count(state, allocations, bytes);
+}
+
+BENCHMARK(BM_ReuseDocument)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::TWITTER), int(CORPUS::CITM),
+                    int(CORPUS::STRINGS), int(CORPUS::ESCAPES)},
+                   {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReuseRecords)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
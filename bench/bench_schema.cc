@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+static std::string const& Orders()
+{
+    static std::string content = [] {
+        std::string result = "[";
+        for (int i = 0; i < 1000; i++) {
+            if (i > 0)
+                result += ",";
+            result += R"({"id":)" + std::to_string(i + 1) + R"(,"price":)" +
+                      std::to_string(i % 97 + 0.25) + R"(,"status":")" +
+                      (i % 2 ? "paid" : "new") + R"(","sku":"ab-)" + std::to_string(i) +
+                      R"(","items":[{"n":1},{"n":2}]})";
+        }
+        return result + "]";
+    }();
+    return content;
+}
+
+static tijson::Schema const& OrdersSchema()
+{
+    static auto schema = tijson::Schema::Compile(tijson::Parse(R"({
+        "type" : "array",
+        "items" : {
+            "type" : "object",
+            "required" : [ "id", "items" ],
+            "properties" : {
+                "id" : { "type" : "integer", "minimum" : 1 },
+                "price" : { "type" : "number", "exclusiveMinimum" : 0 },
+                "status" : { "enum" : [ "new", "paid" ] },
+                "sku" : { "type" : "string", "maxLength" : 16 },
+                "items" : { "type" : "array", "items" : { "required" : [ "n" ] } }
+            }
+        }
+    })"));
+    return schema;
+}
+
+static void BM_SchemaParseThenValidate(benchmark::State& state)
+{
+    auto const& content = Orders();
+    auto const& schema  = OrdersSchema();
+    for (auto _ : state) {
+        auto root = tijson::Parser::Parse(content);
+        benchmark::DoNotOptimize(schema.Validate(root));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+BENCHMARK(BM_SchemaParseThenValidate);
+
+static void BM_SchemaValidateStream(benchmark::State& state)
+{
+    auto const& content = Orders();
+    auto const& schema  = OrdersSchema();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(schema.ValidateStream(content));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+BENCHMARK(BM_SchemaValidateStream);
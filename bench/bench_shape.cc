@@ -0,0 +1,50 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Shape sharing on record corpora: throughput of a plain parse against a parse with
+// share_shapes, the heap bytes the resulting document holds, and field lookup by string against
+// a cached ShapeKey.
+
+using bench::CORPUS;
+
+static tijson::ParseOptions ShareShapes()
+{
+    tijson::ParseOptions options;
+    options.share_shapes = true;
+    return options;
+}
+
+static void BM_ShapeParse(benchmark::State& state)
+{
+    auto const&   content = bench::Corpus(CORPUS(state.range(0)));
+    auto          options = state.range(1) ? ShareShapes() : tijson::ParseOptions();
+    tijson::Value val;
+    for (auto _ : state)
+        val = tijson::Parser::Parse(content, options);
+    state.counters["doc_bytes"] = static_cast<double>(val.MemoryUsage().Total());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+/* sum of one nested field per record: by string, and by ShapeKey */
+static void BM_ShapeLookup(benchmark::State& state)
+{
+    auto const& content  = bench::Corpus(CORPUS::TWITTER);
+    auto        val      = tijson::Parser::Parse(content, ShareShapes());
+    auto const& statuses = val["statuses"].GetArray();
+    tijson::ShapeKey user("user");
+    tijson::ShapeKey followers("followers_count");
+    for (auto _ : state) {
+        double sum = 0;
+        for (auto const& status : statuses)
+            sum += state.range(0) ? status.Find(user)->Find(followers)->GetNumber()
+                                  : status.Find("user")->Find("followers_count")->GetNumber();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_ShapeParse)
+    ->ArgsProduct({{int(CORPUS::TWITTER), int(CORPUS::CITM)}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ShapeLookup)->Arg(0)->Arg(1);
@@ -0,0 +1,162 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Parse, stringify, traverse, copy and destroy over every corpus shape, in the spirit of
+// nativejson-benchmark. Run with --benchmark_out=result.json --benchmark_out_format=json to
+// keep results for regression tracking.
+
+using bench::CORPUS;
+
+/* report throughput against the corpus size and allocations per iteration */
+class AllocationScope final
+{
+public:
+    explicit AllocationScope(benchmark::State& state)
+        : state_(state), count_(bench::AllocationCount()), bytes_(bench::AllocatedBytes())
+    {}
+    ~AllocationScope()
+    {
+        auto avg = benchmark::Counter::kAvgIterations;
+        state_.counters["allocs"] =
+            benchmark::Counter(static_cast<double>(bench::AllocationCount() - count_), avg);
+        state_.counters["alloc_bytes"] =
+            benchmark::Counter(static_cast<double>(bench::AllocatedBytes() - bytes_), avg);
+    }
+
+private:
+    benchmark::State& state_;
+    size_t            count_;
+    size_t            bytes_;
+};
+
+static void SetCorpusBytes(benchmark::State& state, CORPUS kind)
+{
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * bench::Corpus(kind).size()));
+}
+
+/* statistics walk, as nativejson-benchmark does to check the whole tree is reachable */
+struct Statistics
+{
+    size_t objects = 0, arrays = 0, numbers = 0, strings = 0, trues = 0, falses = 0, nulls = 0;
+    size_t members = 0, elements = 0, string_length = 0;
+    double sum = 0;
+};
+
+static void Traverse(tijson::Value const& val, Statistics& stat)
+{
+    switch (val.GetType()) {
+    case tijson::Value::TYPE::OBJECT:
+        stat.objects++;
+        for (auto const& [key, member] : val.GetObject()) {
+            stat.members++;
+            stat.string_length += key.size();
+            Traverse(member, stat);
+        }
+        break;
+    case tijson::Value::TYPE::ARRAY:
+        stat.arrays++;
+        for (auto const& element : val.GetArray()) {
+            stat.elements++;
+            Traverse(element, stat);
+        }
+        break;
+    case tijson::Value::TYPE::STRING:
+        stat.strings++;
+        stat.string_length += val.GetStringView().size();
+        break;
+    case tijson::Value::TYPE::NUMBER:
+        stat.numbers++;
+        stat.sum += val.GetNumber();
+        break;
+    case tijson::Value::TYPE::TRUE: stat.trues++; break;
+    case tijson::Value::TYPE::FALSE: stat.falses++; break;
+    default: stat.nulls++; break;
+    }
+}
+
+static void BM_Parse(benchmark::State& state, CORPUS kind)
+{
+    auto const& content = bench::Corpus(kind);
+    {
+        AllocationScope scope(state);
+        for (auto _ : state) {
+            auto root = tijson::Parser::Parse(content);
+            benchmark::DoNotOptimize(root);
+        }
+    }
+    SetCorpusBytes(state, kind);
+}
+
+static void BM_Stringify(benchmark::State& state, CORPUS kind)
+{
+    auto root = tijson::Parser::Parse(bench::Corpus(kind));
+    {
+        AllocationScope scope(state);
+        for (auto _ : state) {
+            auto str = root.Stringify();
+            benchmark::DoNotOptimize(str);
+        }
+    }
+    SetCorpusBytes(state, kind);
+}
+
+static void BM_Traverse(benchmark::State& state, CORPUS kind)
+{
+    auto root = tijson::Parser::Parse(bench::Corpus(kind));
+    {
+        AllocationScope scope(state);
+        for (auto _ : state) {
+            Statistics stat;
+            Traverse(root, stat);
+            benchmark::DoNotOptimize(stat);
+        }
+    }
+    SetCorpusBytes(state, kind);
+}
+
+static void BM_Copy(benchmark::State& state, CORPUS kind)
+{
+    auto root = tijson::Parser::Parse(bench::Corpus(kind));
+    {
+        AllocationScope scope(state);
+        for (auto _ : state) {
+            tijson::Value copy(root);
+            benchmark::DoNotOptimize(copy);
+            /* keep the destruction out of the measurement */
+            state.PauseTiming();
+            copy.SetNull();
+            state.ResumeTiming();
+        }
+    }
+    SetCorpusBytes(state, kind);
+}
+
+static void BM_Destroy(benchmark::State& state, CORPUS kind)
+{
+    auto root = tijson::Parser::Parse(bench::Corpus(kind));
+    for (auto _ : state) {
+        state.PauseTiming();
+        tijson::Value copy(root);
+        state.ResumeTiming();
+        copy.SetNull();
+        benchmark::DoNotOptimize(copy);
+    }
+    SetCorpusBytes(state, kind);
+}
+
+#define BENCH_CORPORA(FUNC)                                                           \
+    BENCHMARK_CAPTURE(FUNC, canada, CORPUS::CANADA)->Unit(benchmark::kMicrosecond);   \
+    BENCHMARK_CAPTURE(FUNC, twitter, CORPUS::TWITTER)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_CAPTURE(FUNC, citm, CORPUS::CITM)->Unit(benchmark::kMicrosecond);       \
+    BENCHMARK_CAPTURE(FUNC, numbers, CORPUS::NUMBERS)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_CAPTURE(FUNC, strings, CORPUS::STRINGS)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_CAPTURE(FUNC, escapes, CORPUS::ESCAPES)->Unit(benchmark::kMicrosecond)
+
+BENCH_CORPORA(BM_Parse);
+BENCH_CORPORA(BM_Stringify);
+BENCH_CORPORA(BM_Traverse);
+BENCH_CORPORA(BM_Copy);
+BENCH_CORPORA(BM_Destroy);
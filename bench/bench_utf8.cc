@@ -0,0 +1,63 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <tijson.h>
+
+// UTF-8 validation over the whole input: FindInvalidUtf8 against a memcpy of the same bytes, on
+// an ascii corpus and on text with two-, three- and four-byte sequences, and a parse with
+// strict_utf8 against a plain parse. Build with TIJSON_BENCH_NATIVE for the SSSE3 kernel.
+
+using bench::CORPUS;
+
+static std::string const& MixedText()
+{
+    static std::string const text = [] {
+        bench::Random rand(5);
+        char const*   pieces[] = {"plain words ", "caf\xC3\xA9 ", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+                                  "\xE4\xB8\xAD\xE6\x96\x87"};
+        std::string   result;
+        while (result.size() < (1 << 20))
+            result += pieces[rand.Next() % 5];
+        return result;
+    }();
+    return text;
+}
+
+static std::string const& Text(int64_t which)
+{
+    return which ? MixedText() : bench::Corpus(CORPUS::TWITTER);
+}
+
+static void BM_Utf8Memcpy(benchmark::State& state)
+{
+    auto const&       text = Text(state.range(0));
+    std::vector<char> copy(text.size());
+    for (auto _ : state) {
+        std::memcpy(copy.data(), text.data(), text.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+static void BM_Utf8Validate(benchmark::State& state)
+{
+    auto const& text = Text(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tijson::Parser::FindInvalidUtf8(text));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+static void BM_Utf8StrictParse(benchmark::State& state)
+{
+    auto const&          content = bench::Corpus(CORPUS::TWITTER);
+    tijson::ParseOptions options;
+    options.strict_utf8 = state.range(0) != 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tijson::Parser::Parse(content, options));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+BENCHMARK(BM_Utf8Memcpy)->Arg(0)->Arg(1);
+BENCHMARK(BM_Utf8Validate)->Arg(0)->Arg(1);
+BENCHMARK(BM_Utf8StrictParse)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
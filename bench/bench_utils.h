@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+/* global operator new calls and bytes by the calling thread, counted in bench_alloc.cc */
+size_t AllocationCount();
+size_t AllocatedBytes();
+
+/* corpus shapes modelled on nativejson-benchmark, generated locally */
+enum class CORPUS : char
+{
+    CANADA,    // deeply nested arrays of coordinate pairs
+    TWITTER,   // mixed objects with strings, numbers, bools and nulls
+    CITM,      // nested catalog objects keyed by ids, small integer arrays
+    NUMBERS,   // flat array of integers and doubles
+    STRINGS,   // flat array of plain ascii strings
+    ESCAPES,   // strings full of escapes and \u sequences
+};
+
+class Random final
+{
+public:
+    explicit Random(uint64_t seed) : state_(seed) {}
+
+    uint64_t Next()
+    {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state_ >> 33;
+    }
+    double Real(double lo, double hi) { return lo + (hi - lo) * (Next() % 1000000) / 1e6; }
+
+private:
+    uint64_t state_;
+};
+
+inline std::string Format(char const* fmt, double n)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), fmt, n);
+    return buf;
+}
+
+inline std::string Word(Random& rand, size_t len)
+{
+    std::string result;
+    for (size_t i = 0; i < len; i++)
+        result += static_cast<char>('a' + rand.Next() % 26);
+    return result;
+}
+
+inline std::string MakeCanada()
+{
+    Random      rand(1);
+    std::string result = R"({"type":"FeatureCollection","features":[)";
+    for (int f = 0; f < 8; f++) {
+        result += f ? "," : "";
+        result += R"({"type":"Feature","properties":{"name":"Canada"},)"
+                  R"("geometry":{"type":"Polygon","coordinates":[)";
+        for (int r = 0; r < 30; r++) {
+            result += r ? ",[" : "[";
+            for (int p = 0; p < 200; p++) {
+                result += p ? "," : "";
+                result += "[" + Format("%.15g", rand.Real(-141, -52)) + "," +
+                          Format("%.15g", rand.Real(41, 83)) + "]";
+            }
+            result += "]";
+        }
+        result += "]}}";
+    }
+    return result + "]}";
+}
+
+inline std::string MakeTwitter()
+{
+    Random      rand(2);
+    std::string result = R"({"statuses":[)";
+    for (int i = 0; i < 400; i++) {
+        result += i ? "," : "";
+        result += R"({"created_at":"Sun Aug 31 00:29:15 +0000 2014","id":)" +
+                  std::to_string(505874924095815681ULL + rand.Next()) + R"(,"text":")" +
+                  Word(rand, 8) + " " + Word(rand, 12) + " " + Word(rand, 40) +
+                  R"(","truncated":false,"in_reply_to_status_id":null,"user":{"id":)" +
+                  std::to_string(rand.Next()) + R"(,"name":")" + Word(rand, 10) +
+                  R"(","screen_name":")" + Word(rand, 8) +
+                  R"(","description":"ムサシのように )" +
+                  Word(rand, 30) + R"(","followers_count":)" + std::to_string(rand.Next() % 10000) +
+                  R"(,"verified":)" + (rand.Next() % 2 ? "true" : "false") +
+                  R"(},"entities":{"hashtags":[],"urls":[{"url":"http:\/\/t.co\/)" +
+                  Word(rand, 10) + R"(","indices":[)" + std::to_string(rand.Next() % 140) + "," +
+                  std::to_string(rand.Next() % 140) +
+                  R"(]}]},"retweet_count":)" + std::to_string(rand.Next() % 100) +
+                  R"(,"favorited":false,"lang":"ja"})";
+    }
+    return result + "]}";
+}
+
+inline std::string MakeCitm()
+{
+    Random      rand(3);
+    std::string result = R"({"areaNames":{)";
+    for (int i = 0; i < 200; i++)
+        result += (i ? ",\"" : "\"") + std::to_string(205705993 + i) + R"(":")" + Word(rand, 12) +
+                  "\"";
+    result += R"(},"events":{)";
+    for (int i = 0; i < 600; i++) {
+        result += (i ? ",\"" : "\"") + std::to_string(138586341 + i) +
+                  R"(":{"description":null,"id":)" + std::to_string(138586341 + i) +
+                  R"(,"logo":null,"name":")" + Word(rand, 20) + R"(","subTopicIds":[)";
+        for (int j = 0; j < 5; j++)
+            result += (j ? "," : "") + std::to_string(337184262 + rand.Next() % 100);
+        result += R"(],"subjectCode":null,"subtitle":null,"topicIds":[324846099,107888604]})";
+    }
+    result += R"(},"performances":[)";
+    for (int i = 0; i < 300; i++) {
+        result += i ? "," : "";
+        result += R"({"eventId":)" + std::to_string(138586341 + i) +
+                  R"(,"id":)" + std::to_string(339887544 + i) +
+                  R"(,"logo":"\/images\/UE0AAAAACEKo6QAAAAZDSVRN","name":null,"prices":[)";
+        for (int j = 0; j < 4; j++)
+            result += (j ? "," : "") + std::string(R"({"amount":)") +
+                      std::to_string(rand.Next() % 100000) +
+                      R"(,"audienceSubCategoryId":337100890,"seatCategoryId":338937295})";
+        result += R"(],"seatCategories":[{"areas":[{"areaId":205705999,"blockIds":[]}],)"
+                  R"("seatCategoryId":338937295}],"start":1372701600000,"venueCode":"PLEYEL"})";
+    }
+    return result + "]}";
+}
+
+inline std::string MakeNumbers()
+{
+    Random      rand(4);
+    std::string result = "[";
+    for (int i = 0; i < 50000; i++) {
+        result += i ? "," : "";
+        if (i % 2)
+            result += std::to_string(static_cast<int64_t>(rand.Next()) - (1LL << 30));
+        else
+            result += Format("%.17g", rand.Real(-1e6, 1e6) * 1e-3);
+    }
+    return result + "]";
+}
+
+inline std::string MakeStrings()
+{
+    Random      rand(5);
+    std::string result = "[";
+    for (int i = 0; i < 20000; i++)
+        result += (i ? ",\"" : "\"") + Word(rand, 4 + rand.Next() % 60) + "\"";
+    return result + "]";
+}
+
+inline std::string MakeEscapes()
+{
+    Random      rand(6);
+    std::string result = "[";
+    char const* escapes[] = {R"(\")", R"(\\)", R"(\/)", R"(\b)", R"(\f)", R"(\n)", R"(\r)",
+                             R"(\t)", R"(\u00e9)", R"(\u4e2d)", R"(\ud83d\ude00)"};
+    for (int i = 0; i < 20000; i++) {
+        result += i ? ",\"" : "\"";
+        for (int j = 0; j < 8; j++)
+            result += Word(rand, rand.Next() % 4) + escapes[rand.Next() % 11];
+        result += "\"";
+    }
+    return result + "]";
+}
+
+inline std::string const& Corpus(CORPUS kind)
+{
+    static std::string const corpora[] = {MakeCanada(),  MakeTwitter(), MakeCitm(),
+                                          MakeNumbers(), MakeStrings(), MakeEscapes()};
+    return corpora[static_cast<size_t>(kind)];
+}
+
+} /* namespace bench */
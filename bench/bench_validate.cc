@@ -0,0 +1,31 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <tijson.h>
+
+// Validation only: Validate against a parse whose Value is discarded, on every corpus, with the
+// heap allocations of each call.
+
+using bench::CORPUS;
+
+static void BM_Validate(benchmark::State& state)
+{
+    auto const& content     = bench::Corpus(CORPUS(state.range(0)));
+    size_t      allocations = bench::AllocationCount();
+    for (auto _ : state) {
+        if (state.range(1))
+            benchmark::DoNotOptimize(tijson::Validate(content));
+        else
+            benchmark::DoNotOptimize(tijson::Parse(content));
+    }
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(bench::AllocationCount() - allocations),
+                           benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+BENCHMARK(BM_Validate)
+    ->ArgsProduct({{int(CORPUS::CANADA), int(CORPUS::TWITTER), int(CORPUS::CITM),
+                    int(CORPUS::STRINGS), int(CORPUS::ESCAPES)},
+                   {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,204 @@
+#include "../bench_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <tijson.h>
+#include <vector>
+
+// Parse and stringify latency under concurrency. For every thread count, each thread runs the
+// configured operation over a mixed corpus, either as fast as it can or at a fixed rate, and the
+// run reports latency percentiles, throughput and allocations per operation.
+//
+//   latency --threads=1,8,32 --seconds=5 --rate=200 --op=parse --corpus=twitter,citm
+//
+// With a rate, latency is measured from the scheduled start of each operation, so a stalled
+// thread is charged for the operations it delays. To compare allocators, link one through the
+// TIJSON_BENCH_ALLOCATOR cmake option or preload it, and name the run with --label.
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    std::vector<size_t>        threads = {1, 2, 4, 8, 16, 32};
+    double                     seconds = 3;
+    double                     rate    = 0;   // operations per second per thread, 0 is unlimited
+    std::string                op      = "parse";
+    std::vector<bench::CORPUS> corpora = {bench::CORPUS::CANADA,  bench::CORPUS::TWITTER,
+                                          bench::CORPUS::CITM,    bench::CORPUS::NUMBERS,
+                                          bench::CORPUS::STRINGS, bench::CORPUS::ESCAPES};
+    std::string                label   = "malloc";
+    bool                       json    = false;
+};
+
+struct ThreadResult
+{
+    std::vector<double> latencies;   // nanoseconds
+    size_t              bytes       = 0;
+    size_t              allocations = 0;
+};
+
+static std::vector<std::string> Split(std::string const& list)
+{
+    std::vector<std::string> result;
+    size_t                   begin = 0;
+    while (begin <= list.size()) {
+        size_t end = std::min(list.find(',', begin), list.size());
+        result.push_back(list.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return result;
+}
+
+static bool ParseOptions(int argc, char** argv, Options& opt)
+{
+    char const* names[] = {"canada", "twitter", "citm", "numbers", "strings", "escapes"};
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto        eq  = arg.find('=');
+        std::string key = arg.substr(0, eq), val = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--threads") {
+            opt.threads.clear();
+            for (auto const& n : Split(val))
+                opt.threads.push_back(std::stoul(n));
+        }
+        else if (key == "--seconds")
+            opt.seconds = std::stod(val);
+        else if (key == "--rate")
+            opt.rate = std::stod(val);
+        else if (key == "--op" && (val == "parse" || val == "stringify" || val == "roundtrip"))
+            opt.op = val;
+        else if (key == "--corpus") {
+            opt.corpora.clear();
+            for (auto const& name : Split(val)) {
+                auto it = std::find(std::begin(names), std::end(names), name);
+                if (it == std::end(names))
+                    return false;
+                opt.corpora.push_back(static_cast<bench::CORPUS>(it - std::begin(names)));
+            }
+        }
+        else if (key == "--label")
+            opt.label = val;
+        else if (key == "--json")
+            opt.json = true;
+        else
+            return false;
+    }
+    return !opt.threads.empty() && !opt.corpora.empty() && opt.seconds > 0;
+}
+
+static void Worker(Options const& opt, std::vector<tijson::Value> const& roots, size_t seed,
+                   Clock::time_point start, std::atomic<bool> const& go, ThreadResult& result)
+{
+    while (!go.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    auto   deadline   = start + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(opt.seconds));
+    auto   interval   = opt.rate > 0 ? std::chrono::duration_cast<Clock::duration>(
+                                         std::chrono::duration<double>(1 / opt.rate))
+                                     : Clock::duration::zero();
+    auto   scheduled  = start;
+    size_t allocation = bench::AllocationCount();
+    for (size_t i = seed;; i++) {
+        if (opt.rate > 0) {
+            std::this_thread::sleep_until(scheduled);
+        }
+        else
+            scheduled = Clock::now();
+        if (scheduled >= deadline)
+            break;
+
+        size_t      doc     = i % opt.corpora.size();
+        auto const& content = bench::Corpus(opt.corpora[doc]);
+        if (opt.op == "parse") {
+            auto root = tijson::Parser::Parse(content);
+            result.bytes += content.size();
+        }
+        else if (opt.op == "stringify")
+            result.bytes += roots[doc].Stringify().size();
+        else
+            result.bytes += tijson::Parser::Parse(content).Stringify().size() + content.size();
+
+        result.latencies.push_back(
+            std::chrono::duration<double, std::nano>(Clock::now() - scheduled).count());
+        scheduled += interval;
+    }
+    result.allocations = bench::AllocationCount() - allocation;
+}
+
+static double Percentile(std::vector<double> const& sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt)) {
+        std::cerr << "usage: latency [--threads=1,2,4] [--seconds=3] [--rate=ops_per_thread]\n"
+                     "               [--op=parse|stringify|roundtrip] [--corpus=twitter,citm]\n"
+                     "               [--label=name] [--json]\n";
+        return 1;
+    }
+
+    std::vector<tijson::Value> roots;
+    for (auto kind : opt.corpora)
+        roots.push_back(tijson::Parser::Parse(bench::Corpus(kind)));
+
+    if (!opt.json)
+        std::printf("%-10s %7s %9s %10s %9s %10s %10s %10s %10s %10s\n", "label", "threads",
+                    "ops", "ops/s", "MB/s", "p50(us)", "p99(us)", "p999(us)", "max(us)",
+                    "allocs/op");
+    else
+        std::printf("[\n");
+
+    for (size_t t = 0; t < opt.threads.size(); t++) {
+        size_t                    n = opt.threads[t];
+        std::vector<ThreadResult> results(n);
+        std::vector<std::thread>  workers;
+        std::atomic<bool>         go{false};
+        auto                      start = Clock::now() + std::chrono::milliseconds(10);
+        for (size_t i = 0; i < n; i++)
+            workers.emplace_back(Worker, std::cref(opt), std::cref(roots), i, start,
+                                 std::cref(go), std::ref(results[i]));
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers)
+            worker.join();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<double> latencies;
+        size_t              bytes = 0, allocations = 0;
+        for (auto const& result : results) {
+            latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+            bytes += result.bytes;
+            allocations += result.allocations;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double ops       = static_cast<double>(latencies.size());
+        double per_op    = ops > 0 ? allocations / ops : 0;
+        double latency[] = {Percentile(latencies, 0.5) / 1e3, Percentile(latencies, 0.99) / 1e3,
+                            Percentile(latencies, 0.999) / 1e3,
+                            latencies.empty() ? 0 : latencies.back() / 1e3};
+        if (!opt.json)
+            std::printf("%-10s %7zu %9.0f %10.1f %9.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                        opt.label.c_str(), n, ops, ops / elapsed, bytes / elapsed / 1e6,
+                        latency[0], latency[1], latency[2], latency[3], per_op);
+        else
+            std::printf(R"(  { "label":"%s", "op":"%s", "threads":%zu, "ops":%.0f, )"
+                        R"("ops_per_second":%.1f, "mb_per_second":%.1f, "p50_us":%.1f, )"
+                        R"("p99_us":%.1f, "p999_us":%.1f, "max_us":%.1f, "allocs_per_op":%.1f }%s)"
+                        "\n",
+                        opt.label.c_str(), opt.op.c_str(), n, ops, ops / elapsed,
+                        bytes / elapsed / 1e6, latency[0], latency[1], latency[2], latency[3],
+                        per_op, t + 1 < opt.threads.size() ? "," : "");
+    }
+    if (opt.json)
+        std::printf("]\n");
+    return 0;
+}
@@ -3,19 +3,54 @@
 
 /* NOTE: INCLUDE */
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
 #include <cmath>
-#include <codecvt>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <initializer_list>
+#include <limits>
 #include <locale>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* without -mssse3, gcc and clang on x86 still build the SSSE3 utf-8 kernel and pick it at run
+   time if the cpu has it */
+#if !defined(__SSSE3__) && defined(__SSE2__) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#define TIJSON_SSSE3_DISPATCH
+#define TIJSON_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define TIJSON_SSSE3_TARGET
+#endif
+
 namespace tijson {
 
 /* NOTE: ENUM CLASS PARSER ERROR CODE */
@@ -34,7 +69,10 @@ enum class PARSE_ERROR : size_t
     MISS_COMMA_OR_SQUARE_BRACKET,
     MISS_KEY,
     MISS_COLON,
-    MISS_COMMA_OR_CURLY_BRACKET
+    MISS_COMMA_OR_CURLY_BRACKET,
+    BIND_TYPE_MISMATCH,
+    UNKNOWN_KEY,
+    INVALID_UTF8
 };
 
 enum class ACCESS_ERROR : size_t
@@ -44,23 +82,383 @@ enum class ACCESS_ERROR : size_t
     ARRAY_INDEX_OUT_OF_RANGE,
 };
 
+enum class SCHEMA_ERROR : size_t
+{
+    NO_ERROR = 0,
+    INVALID_SCHEMA,
+    INVALID_JSON,
+    TYPE_MISMATCH,
+    REQUIRED_MISSING,
+    ADDITIONAL_PROPERTY,
+    ENUM_MISMATCH,
+    BELOW_MINIMUM,
+    ABOVE_MAXIMUM,
+    STRING_TOO_SHORT,
+    STRING_TOO_LONG,
+    PATTERN_MISMATCH,
+    TOO_FEW_ITEMS,
+    TOO_MANY_ITEMS,
+};
+
+enum class DECODE_ERROR : size_t
+{
+    NO_ERROR = 0,
+    UNEXPECTED_END,
+    UNSUPPORTED_TYPE,
+    INVALID_KEY,
+    TRAILING_DATA,
+    INVALID_IMAGE,
+};
+
+enum class PATCH_ERROR : size_t
+{
+    NO_ERROR = 0,
+    INVALID_PATCH,
+    PATH_NOT_FOUND,
+    TEST_FAILED,
+};
+
 template<class T>
 class Exception;
 /*  NOTE: CUSTOM EXCEPTION */
 using ParseException  = Exception<PARSE_ERROR>;
 using AccessException = Exception<ACCESS_ERROR>;
+using SchemaException = Exception<SCHEMA_ERROR>;
+using DecodeException = Exception<DECODE_ERROR>;
+using PatchException  = Exception<PATCH_ERROR>;
 
 class Value;
+class ReusableParser;
 /* NOTE: JSON ARRAY AND OBJECT */
 using Array  = std::vector<Value>;
 using Object = std::unordered_map<std::string, Value>;
+/* an array of numbers packed by a parse with pack_numbers */
+using NumberArray = std::vector<double>;
+
+/* NOTE: INSTRUMENTATION */
+// Per-call counters for Parser and the serializers, compiled in only when TIJSON_ENABLE_STATS
+// is defined; otherwise every hook expands to nothing. Once compiled in, counters are collected
+// only while a callback is installed, and the callback receives the Stats of each top-level
+// Parse, ParseInto, ParseEvents, ParseObjectInto, Value::Stringify or Stringify call on the
+// calling thread. Define the macro identically in every translation unit, and install the
+// callback before parsing starts on other threads.
+#ifdef TIJSON_ENABLE_STATS
+struct Stats
+{
+    enum class OPERATION : char
+    {
+        PARSE,
+        STRINGIFY,
+    };
+
+    OPERATION operation = OPERATION::PARSE;
+    bool      failed    = false;   // the call ended with an exception
+
+    size_t bytes = 0;   // bytes of content parsed, or bytes of text written
+
+    /* values parsed into a Value, a bound type or as events, or written from either */
+    size_t nulls   = 0;
+    size_t bools   = 0;
+    size_t numbers = 0;
+    size_t strings = 0;
+    size_t arrays  = 0;
+    size_t objects = 0;
+    size_t keys    = 0;
+
+    size_t max_depth         = 0;
+    size_t escapes           = 0;   // escape sequences decoded or written
+    size_t numbers_converted = 0;   // conversions between number text and double
+
+    /* estimated from the containers and strings a parse leaves in the Value */
+    size_t allocations     = 0;
+    size_t allocated_bytes = 0;
+
+    /* phase timings in nanoseconds, strings and numbers are included in total */
+    uint64_t total_ns  = 0;
+    uint64_t string_ns = 0;
+    uint64_t number_ns = 0;
+};
+
+using StatsCallback = std::function<void(Stats const&)>;
+
+inline StatsCallback& GetStatsCallback()
+{
+    static StatsCallback callback;
+    return callback;
+}
+
+/* install or, with nullptr, remove the callback that receives the stats of each call */
+inline void SetStatsCallback(StatsCallback callback)
+{
+    GetStatsCallback() = std::move(callback);
+}
+
+/* stats of the running top-level call on this thread, nullptr when not collecting */
+inline Stats*& CurrentStats()
+{
+    static thread_local Stats* current = nullptr;
+    return current;
+}
+
+inline size_t& CurrentDepth()
+{
+    static thread_local size_t depth = 0;
+    return depth;
+}
+
+/* collects the stats of a top-level call, nested calls share the outer scope */
+class StatsScope final
+{
+public:
+    explicit StatsScope(Stats::OPERATION op)
+    {
+        if (CurrentStats() != nullptr || !GetStatsCallback())
+            return;
+        stats_.operation = op;
+        CurrentStats()   = &stats_;
+        CurrentDepth()   = 0;
+        exceptions_      = std::uncaught_exceptions();
+        start_           = std::chrono::steady_clock::now();
+    }
+    ~StatsScope()
+    {
+        if (CurrentStats() != &stats_)
+            return;
+        stats_.total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start_)
+                              .count();
+        stats_.failed  = std::uncaught_exceptions() > exceptions_;
+        CurrentStats() = nullptr;
+        GetStatsCallback()(stats_);
+    }
+    StatsScope(StatsScope const&)            = delete;
+    StatsScope& operator=(StatsScope const&) = delete;
+
+    void SetBytes(size_t bytes)
+    {
+        if (CurrentStats() == &stats_)
+            stats_.bytes = bytes;
+    }
+
+private:
+    Stats                                 stats_;
+    int                                   exceptions_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/* adds the time until the end of the enclosing block to a timing field */
+class StatsTimer final
+{
+public:
+    explicit StatsTimer(uint64_t Stats::*field) : field_(field)
+    {
+        if (CurrentStats() != nullptr)
+            start_ = std::chrono::steady_clock::now();
+    }
+    ~StatsTimer()
+    {
+        if (auto stats = CurrentStats())
+            stats->*field_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start_)
+                                  .count();
+    }
+    StatsTimer(StatsTimer const&)            = delete;
+    StatsTimer& operator=(StatsTimer const&) = delete;
+
+private:
+    uint64_t Stats::*                     field_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/* characters written as an escape sequence */
+inline bool StatsIsEscape(char ch)
+{
+    return ch == '\"' || ch == '\\' || ch == '/' || static_cast<unsigned char>(ch) < 0x20;
+}
+
+inline void StatsAllocation(size_t count, size_t bytes)
+{
+    if (auto stats = CurrentStats()) {
+        stats->allocations += count;
+        stats->allocated_bytes += bytes;
+    }
+}
+
+inline void StatsEnter()
+{
+    if (auto stats = CurrentStats())
+        stats->max_depth = std::max(stats->max_depth, ++CurrentDepth());
+}
+
+inline void StatsLeave()
+{
+    if (CurrentStats() != nullptr)
+        --CurrentDepth();
+}
+
+/* estimated heap use of a string, nothing while it fits the small string buffer */
+inline void StatsString(std::string const& str)
+{
+    if (str.capacity() > std::string().capacity())
+        StatsAllocation(1, str.capacity() + 1);
+}
+
+#define TIJSON_STATS_SCOPE(OP)    tijson::StatsScope tijson_stats_scope(tijson::Stats::OPERATION::OP)
+#define TIJSON_STATS_BYTES(N)     tijson_stats_scope.SetBytes(N)
+#define TIJSON_STATS_TIMER(FIELD) tijson::StatsTimer tijson_stats_timer(&tijson::Stats::FIELD)
+#define TIJSON_STATS_ADD(FIELD, N)                                                      \
+    (tijson::CurrentStats() != nullptr ? void(tijson::CurrentStats()->FIELD += (N)) : void())
+#define TIJSON_STATS_ENTER()                  tijson::StatsEnter()
+#define TIJSON_STATS_LEAVE()                  tijson::StatsLeave()
+#define TIJSON_STATS_ALLOCATION(COUNT, BYTES) tijson::StatsAllocation(COUNT, BYTES)
+#define TIJSON_STATS_STRING(STR)              tijson::StatsString(STR)
+#else
+#define TIJSON_STATS_SCOPE(OP)                (void)0
+#define TIJSON_STATS_BYTES(N)                 (void)0
+#define TIJSON_STATS_TIMER(FIELD)             (void)0
+#define TIJSON_STATS_ADD(FIELD, N)            (void)0
+#define TIJSON_STATS_ENTER()                  (void)0
+#define TIJSON_STATS_LEAVE()                  (void)0
+#define TIJSON_STATS_ALLOCATION(COUNT, BYTES) (void)0
+#define TIJSON_STATS_STRING(STR)              (void)0
+#endif
+
+/* heap bytes owned by a Value tree, the root Value itself is not counted */
+struct MemoryReport
+{
+    size_t containers  = 0;   // array and object headers, and the used part of array buffers
+    size_t strings     = 0;   // string buffers outside the small string storage, keys included
+    size_t map_nodes   = 0;   // one node per object member: link, cached hash, key and value
+    size_t map_buckets = 0;   // object bucket arrays
+    size_t slack       = 0;   // unused capacity of array and string buffers
+    size_t allocations = 0;   // number of heap blocks
+
+    [[nodiscard]] size_t Total() const
+    {
+        return containers + strings + map_nodes + map_buckets + slack;
+    }
+};
+
+/* NOTE: CLASS KEY TABLE */
+// Interns object keys, so a key repeated across objects and documents is stored once and two
+// interned keys are equal exactly when their addresses are. A table serves one parser at a time
+// unless it is made thread safe. Values parsed with a table keep it alive.
+class KeyTable final
+{
+public:
+    using Key = std::string const*;
+
+    explicit KeyTable(bool thread_safe = false) : thread_safe_(thread_safe) {}
+
+    KeyTable(KeyTable const&)            = delete;
+    KeyTable& operator=(KeyTable const&) = delete;
+
+    /* the interned key equal to key, interning it first if needed */
+    Key Intern(std::string_view key);
+    /* the interned key equal to key, nullptr if it was never interned */
+    [[nodiscard]] Key Find(std::string_view key) const;
+
+    [[nodiscard]] size_t size() const;
+    /* approximate heap bytes held by the table */
+    [[nodiscard]] size_t MemoryUsage() const;
+
+private:
+    std::deque<std::string>                   keys_;
+    std::unordered_map<std::string_view, Key> index_;
+    bool                                      thread_safe_;
+    mutable std::shared_mutex                 mutex_;
+};
+
+/* an object parsed with a KeyTable: interned keys and values in document order */
+struct CompactObject
+{
+    std::shared_ptr<KeyTable const>              table;
+    std::vector<std::pair<KeyTable::Key, Value>> members;
+};
+
+/* NOTE: CLASS SHAPE */
+// The ordered, distinct keys of objects that share a layout. A parse with share_shapes stores an
+// object with the keys of the object in the same place of the previous record as that object's
+// Shape and a vector of values, so the keys and their lookup table are paid once per run of
+// equal records: array items, members of a map of records, and the objects nested in them.
+class Shape final
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    Shape() = default;
+
+    /* a shape is shared by address, copies would not be found by ShapeKey */
+    Shape(Shape const&)            = delete;
+    Shape& operator=(Shape const&) = delete;
+
+    /* append key unless present, return its slot */
+    size_t Add(std::string_view key);
+
+    /* key -> slot, or npos */
+    [[nodiscard]] size_t             Find(std::string_view key) const;
+    [[nodiscard]] std::string const& Key(size_t slot) const { return keys_[slot]; }
+    [[nodiscard]] size_t             size() const { return keys_.size(); }
+
+    /* approximate heap bytes held by the shape */
+    [[nodiscard]] size_t MemoryUsage() const;
+
+private:
+    std::deque<std::string>                      keys_;
+    std::unordered_map<std::string_view, size_t> index_;
+};
+
+/* an object stored with a shared Shape, values[i] is the member of shape->Key(i) */
+struct ShapedObject
+{
+    std::shared_ptr<Shape const> shape;
+    std::vector<Value>           values;
+};
+
+/* a key that remembers its slot in the last Shape it was looked up in, so looking it up in
+   objects of that shape is one comparison and an indexed load. Not safe to share across threads */
+class ShapeKey final
+{
+public:
+    explicit ShapeKey(std::string key) : key_(std::move(key)) {}
+
+    [[nodiscard]] std::string const& GetKey() const { return key_; }
+
+private:
+    friend class Value;
+
+    std::string          key_;
+    mutable Shape const* shape_ = nullptr;
+    mutable size_t       slot_  = Shape::npos;
+};
+
+/* a read-only view of the numbers of a packed array */
+class NumberSpan final
+{
+public:
+    NumberSpan() = default;
+    NumberSpan(double const* data, size_t size) : data_(data), size_(size) {}
+
+    [[nodiscard]] double const* data() const { return data_; }
+    [[nodiscard]] size_t        size() const { return size_; }
+    [[nodiscard]] bool          empty() const { return size_ == 0; }
+    [[nodiscard]] double const* begin() const { return data_; }
+    [[nodiscard]] double const* end() const { return data_ + size_; }
+    double                      operator[](size_t index) const { return data_[index]; }
+
+private:
+    double const* data_ = nullptr;
+    size_t        size_ = 0;
+};
 
 /*  NOTE: CLASS VALUE */
 class Value final
 {
 
-    using ArrayUPtr  = std::unique_ptr<Array>;
-    using ObjectUPtr = std::unique_ptr<Object>;
+    using ArrayUPtr         = std::unique_ptr<Array>;
+    using ObjectUPtr        = std::unique_ptr<Object>;
+    using CompactObjectUPtr = std::unique_ptr<CompactObject>;
+    using ShapedObjectUPtr  = std::unique_ptr<ShapedObject>;
 
 public:
     /* the type of json value */
@@ -101,28 +499,39 @@ public:
     Value(Value const& rhs);
     Value& operator=(Value const& rhs);
 
-    // move
+    // move, terminate for a value under a frozen one
     Value(Value&&) noexcept;
     Value& operator=(Value&&) noexcept;
 
+    /* assign anything a Value converts from, throw AccessException under a frozen value */
+    template<class T,
+             std::enable_if_t<!std::is_same_v<std::decay_t<T>, Value> &&
+                                  std::is_convertible_v<T&&, Value>,
+                              int> = 0>
+    Value& operator=(T&& v);
+
     /* type check */
-    bool IsInvalid() { return type_ == TYPE::INVALID ? true : false; }
-    bool IsNull() { return type_ == TYPE::NUL ? true : false; }
-    bool IsTrue() { return type_ == TYPE::TRUE ? true : false; }
-    bool IsFalse() { return type_ == TYPE::FALSE ? true : false; }
-    bool IsNumber() { return type_ == TYPE::NUMBER ? true : false; }
-    bool IsString() { return type_ == TYPE::STRING ? true : false; }
-    bool IsArray() { return type_ == TYPE::ARRAY ? true : false; }
-    bool IsObject() { return type_ == TYPE::OBJECT ? true : false; }
+    bool IsInvalid() { return GetType() == TYPE::INVALID ? true : false; }
+    bool IsNull() { return GetType() == TYPE::NUL ? true : false; }
+    bool IsTrue() { return GetType() == TYPE::TRUE ? true : false; }
+    bool IsFalse() { return GetType() == TYPE::FALSE ? true : false; }
+    bool IsNumber() { return GetType() == TYPE::NUMBER ? true : false; }
+    bool IsString() { return GetType() == TYPE::STRING ? true : false; }
+    bool IsArray() { return GetType() == TYPE::ARRAY ? true : false; }
+    bool IsObject() { return GetType() == TYPE::OBJECT ? true : false; }
 
     /* getter setter */
-    [[nodiscard]] TYPE        GetType() const;
-    [[nodiscard]] bool        GetBool() const;
-    [[nodiscard]] double      GetNumber() const;
-    [[nodiscard]] std::string GetString() const;
-    [[nodiscard]] Array&      GetArray() const;
-    [[nodiscard]] Object&     GetObject() const;
-    [[nodiscard]] PARSE_ERROR GetParseErrorCode() const;
+    [[nodiscard]] TYPE             GetType() const;
+    [[nodiscard]] bool             GetBool() const;
+    [[nodiscard]] double           GetNumber() const;
+    [[nodiscard]] std::string      GetString() const;
+    [[nodiscard]] std::string_view GetStringView() const;
+    [[nodiscard]] Array&           GetArray() const;
+    [[nodiscard]] Object&          GetObject() const;
+    /* read-only GetArray and GetObject, these work on a frozen value too */
+    [[nodiscard]] Array const&  GetArrayView() const;
+    [[nodiscard]] Object const& GetObjectView() const;
+    [[nodiscard]] PARSE_ERROR      GetParseErrorCode() const;
 
     void SetInvalid(PARSE_ERROR);
     void SetNull();
@@ -130,7 +539,19 @@ public:
     void SetNumber(double);
     void SetString(std::string&&);
     void SetArray(Array&&);
+    void SetArray(NumberArray&&);
     void SetObject(Object&&);
+    void SetObject(CompactObject&&);
+    void SetObject(ShapedObject&&);
+    /* keep a json fragment as text, Stringify splices it verbatim and the other accessors
+       parse it into a real value on first use. The fragment is checked now and ParseException
+       thrown if it is not valid json, or with lazy checked on first use */
+    void SetRaw(std::string&& json, bool lazy = false);
+
+    /* the value is a fragment not parsed yet, GetType tells the type of the fragment */
+    [[nodiscard]] bool IsRaw() const { return std::holds_alternative<RawJson>(data_); }
+    /* the text of a fragment, throw AccessException if the value is not raw */
+    [[nodiscard]] std::string_view GetRawJson() const;
 
     /* value to json string */
     [[nodiscard]] std::string Stringify() const;
@@ -145,12 +566,66 @@ public:
     template<class T>
     bool operator==(T const& arg) const = delete;
 
+    /* an object lookup converts the object to Object first and inserts a missing key */
     Value& operator[](size_t) const;
     Value& operator[](std::string const&) const;
     Value& operator[](char const* p) const;
 
+    /* object lookup that never inserts, nullptr if absent, valid until GetObject */
+    [[nodiscard]] Value* Find(std::string_view key) const;
+    [[nodiscard]] Value* Find(std::string const& key) const;
+    [[nodiscard]] Value* Find(char const* key) const;
+    /* an interned key is compared by address against objects parsed with its table */
+    [[nodiscard]] Value* Find(KeyTable::Key key) const;
+    /* a shaped object of the key's cached shape is looked up by slot, without hashing */
+    [[nodiscard]] Value* Find(ShapeKey const& key) const;
+
+    /* number of members of an object */
+    [[nodiscard]] size_t MemberCount() const;
+    /* visit each member as (std::string_view key, Value const& member), without converting a
+       compact or shaped object to Object the way GetObject does */
+    template<class Func>
+    void ForEachMember(Func&& func) const;
+    /* the object still has the compact layout of a parse with a KeyTable */
+    [[nodiscard]] bool IsCompactObject() const;
+    /* the object still has the shared Shape layout of a parse with share_shapes */
+    [[nodiscard]] bool IsShapedObject() const;
+
+    /* number of items of an array */
+    [[nodiscard]] size_t ItemCount() const;
+    /* visit each item as Value const&, without converting a packed array to Array the way
+       GetArray does */
+    template<class Func>
+    void ForEachItem(Func&& func) const;
+    /* the numbers of a packed array, throw AccessException if the array is not packed */
+    [[nodiscard]] NumberSpan GetNumberSpan() const;
+    /* store an Array of nothing but numbers packed, false if it is not one */
+    bool PackNumbers();
+    /* the array still has the packed layout of a parse with pack_numbers */
+    [[nodiscard]] bool IsPackedArray() const;
+    /* the number still holds its text from a parse with lazy_numbers, Stringify writes the
+       text as it was. GetNumber converts it once and keeps the double instead */
+    [[nodiscard]] bool IsLazyNumber() const;
+
+    /* heap bytes owned by this value, by kind */
+    [[nodiscard]] MemoryReport MemoryUsage() const;
+    /* release the unused capacity of arrays, strings, keys and bucket arrays */
+    void ShrinkToFit();
+
+    /* make the value and everything under it read-only, writes throw AccessException */
+    void Freeze();
+    [[nodiscard]] bool IsFrozen() const { return frozen_; }
+
+    /* a structural hash, equal whatever the layout and the order of members. Only when both
+       sides are frozen does operator== return early on a hash stored by Freeze */
+    [[nodiscard]] size_t Hash() const;
+
 
 private:
+    /* memory utils */
+    void MemoryUsage(MemoryReport& report) const;
+    static void StringMemoryUsage(std::string const& str, MemoryReport& report);
+
     /* stringify utils */
     [[nodiscard]] std::string StringifyNumber() const;
     [[nodiscard]] std::string StringifyString() const;
@@ -158,743 +633,6637 @@ private:
     [[nodiscard]] std::string StringifyObject() const;
     [[nodiscard]] std::string StringifyString(std::string_view) const;
 
-    std::variant<PARSE_ERROR, std::string, double, ArrayUPtr, ObjectUPtr> data_{
-        PARSE_ERROR::NO_ERROR};
-    TYPE type_{TYPE::NUL};
-};
+    /* convert a compact or shaped object into Object */
+    void MaterializeObject() const;
+    /* convert a packed array into Array */
+    void MaterializeArray() const;
+    /* check a raw fragment once, and parse it into the value */
+    void CheckRaw() const;
+    void MaterializeRaw() const;
+    /* the type of a fragment from its first character, INVALID if it has none */
+    static TYPE RawType(std::string_view json);
 
+    /* freeze utils, FreezeTree returns the HashValue of the value */
+    uint64_t FreezeTree(bool below);
+    void CheckNotFrozen() const;
+    /* GetArray and GetObject without the frozen check */
+    [[nodiscard]] Array&  Items() const;
+    [[nodiscard]] Object& Members() const;
 
-/* NOTE: CLASS PARSER */
-class Parser final
-{
-    using str_itr = std::string_view::iterator;
+    /* hash utils */
+    [[nodiscard]] uint64_t HashValue() const;
+    static uint64_t        MixHash(uint64_t h);
+    static uint64_t        MixMember(std::string_view key, uint64_t member);
+    static uint32_t        FoldHash(uint64_t h);
 
-public:
-    /* copy deleted */
-    Parser(Parser const&)            = delete;
-    Parser& operator=(Parser const&) = delete;
+    /* the parser reads the shape of the previous sibling */
+    friend class Parser;
+    /* refuses to parse into a value under a frozen one */
+    friend class ReusableParser;
 
-    /* move undeclared */
+    /* the text of a fragment, see SetRaw */
+    struct RawJson
+    {
+        std::string json;
+    };
 
-    ~Parser() = default;
+    /* mutable, so that const accessors can convert raw, compact, shaped and packed storage */
+    mutable std::variant<PARSE_ERROR,
+                         std::string,
+                         double,
+                         ArrayUPtr,
+                         NumberArray,
+                         ObjectUPtr,
+                         CompactObjectUPtr,
+                         ShapedObjectUPtr,
+                         RawJson>
+                 data_{PARSE_ERROR::NO_ERROR};
+    mutable TYPE type_{TYPE::NUL};
+    /* a raw fragment has been checked to be valid json */
+    mutable bool raw_checked_{false};
+    /* const accessors do not write, see Freeze */
+    bool frozen_{false};
+    /* the value is under a frozen one and can not be assigned to or moved from */
+    bool frozen_member_{false};
+    /* the hash of a frozen array or object, 0 if not stored. It fits the padding of Value */
+    uint32_t hash_{0};
+};
 
-    /* parse content to json value */
-    static Value Parse(std::string_view content);
+/* NOTE: CLASS SHARED DOCUMENT */
+// Hands a frozen Value to reader threads and replaces it while they read, in the way of RCU.
+// Store freezes a new version and swaps it in, Load returns the current one. A reader keeps
+// the version it loaded alive for as long as it holds it, so a reload never waits for readers
+// and readers never see a document half replaced. Only Load and Store are synchronized, reads
+// of the loaded Value are plain.
+class SharedDocument final
+{
+public:
+    explicit SharedDocument(Value value = Value()) { Store(std::move(value)); }
 
-private:
-    /* constructor private */
-    Parser(str_itr cur, str_itr end) : cur_(cur), end_(end) {}
+    SharedDocument(SharedDocument const&)            = delete;
+    SharedDocument& operator=(SharedDocument const&) = delete;
 
-    /* real parse */
-    Value Parse();
+    [[nodiscard]] std::shared_ptr<Value const> Load() const;
+    /* freeze value and publish it, return the version it replaces */
+    std::shared_ptr<Value const> Store(Value value);
 
-    /* parse utils */
-    Value ParseValue();
-    void  ParseWhitespace();
-    void  ParseNull(Value&);
-    void  ParseTrue(Value&);
-    void  ParseFalse(Value&);
-    void  ParseNumber(Value&);
-    void  ParseString(Value&);
-    void  ParseArray(Value&);
-    void  ParseObject(Value&);
+private:
+    std::shared_ptr<Value const> current_;
+};
 
-    /* parse string, return raw string */
-    std::string ParseString();
 
+/* NOTE: COMPILE-TIME KEY MATCHER */
+// A perfect hash over a fixed key list, built in a constant expression. The hash only samples the
+// length and a few bytes of the key when that is enough to separate the keys, so a lookup costs
+// a couple of loads and one string comparison. Longer lists, where a single seed rarely maps
+// every key to its own slot, hash and displace: the full hash picks a bucket, and the
+// displacement stored for the bucket moves its keys to free slots, at the cost of one more load.
+constexpr size_t KeyTableSize(size_t n)
+{
+    size_t size = 1;
+    while (size < 2 * n)
+        size <<= 1;
+    return size;
+}
 
-    /* parse number util */
-    template<char lower, char upper>
-    bool IsDigital(char ch);
+template<size_t N>
+class KeyMatcher final
+{
+public:
+    /* slot returned for keys outside the list */
+    static constexpr size_t npos = N;
 
-    /* parse string util */
-    bool IsInvalidChar(char ch);
+    constexpr explicit KeyMatcher(std::array<std::string_view, N> const& keys) : keys_(keys)
+    {
+        for (size_t i = 0; i < N; i++) {
+            for (size_t j = i + 1; j < N; j++) {
+                if (keys_[i] == keys_[j])
+                    throw std::invalid_argument("KeyMatcher: duplicate key");
+            }
+        }
+        for (int full = 0; full < 2; full++) {
+            for (uint32_t seed = 0; seed < 1024; seed++) {
+                if (TryBuild(seed, full == 1))
+                    return;
+            }
+        }
+        for (uint32_t seed = 0; seed < 64; seed++) {
+            if (TryDisplace(seed))
+                return;
+        }
+        throw std::logic_error("KeyMatcher: no perfect hash found");
+    }
 
-    /* parse unicode util */
-    char16_t    ParseStringHex4();
-    std::string ParseStringUtf8();
+    /* key -> slot index in [0, N), or npos */
+    [[nodiscard]] constexpr size_t Find(std::string_view key) const
+    {
+        uint32_t h = Hash(key, seed_, full_);
+        if (displaced_)
+            h = Mix(h ^ displacement_[h & (TableSize() - 1)]);
+        size_t slot = table_[h & (TableSize() - 1)];
+        return slot != npos && keys_[slot] == key ? slot : npos;
+    }
 
-    /* data */
-    str_itr cur_;
-    str_itr end_;
-};
+    [[nodiscard]] constexpr std::string_view Key(size_t slot) const { return keys_[slot]; }
+    [[nodiscard]] static constexpr size_t    size() { return N; }
 
-/* NOTE: CLASS PARSER EXCEPTION */
-template<class T>
-class Exception : public std::exception
-{
-public:
-    Exception() = default;
-    Exception(std::string what) : what_(std::move(what)){};
-    Exception(T type, std::string what) : what_(std::move(what)), type_(type){};
+private:
+    static constexpr size_t TableSize() { return KeyTableSize(N); }
 
-    Exception(Exception const&)            = default;
-    Exception& operator=(Exception const&) = default;
+    static constexpr uint32_t Hash(std::string_view key, uint32_t seed, bool full)
+    {
+        uint32_t h = seed ^ (static_cast<uint32_t>(key.size()) * 0x9E3779B1u);
+        if (full) {
+            for (auto ch : key)
+                h = (h ^ static_cast<unsigned char>(ch)) * 0x01000193u;
+        }
+        else if (!key.empty()) {
+            h = (h ^ static_cast<unsigned char>(key.front())) * 0x01000193u;
+            h = (h ^ static_cast<unsigned char>(key[key.size() / 2])) * 0x01000193u;
+            h = (h ^ static_cast<unsigned char>(key.back())) * 0x01000193u;
+        }
+        return h ^ (h >> 15);
+    }
 
-    Exception(Exception&&) noexcept            = default;
-    Exception& operator=(Exception&&) noexcept = default;
+    /* the slot hash of a displaced key, independent of the low bits that chose its bucket */
+    static constexpr uint32_t Mix(uint32_t h)
+    {
+        h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+        h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+        return h ^ (h >> 16);
+    }
 
-    ~Exception() noexcept override = default;
+    constexpr bool TryBuild(uint32_t seed, bool full)
+    {
+        for (auto& slot : table_)
+            slot = npos;
+        for (size_t i = 0; i < N; i++) {
+            auto& slot = table_[Hash(keys_[i], seed, full) & (TableSize() - 1)];
+            if (slot != npos)
+                return false;
+            slot = i;
+        }
+        seed_ = seed;
+        full_ = full;
+        return true;
+    }
 
-    [[nodiscard]] const char* what() const noexcept override
+    /* place the buckets largest first, each at the first displacement that finds free slots */
+    constexpr bool TryDisplace(uint32_t seed)
     {
-        return what_.empty() ? "Unknown exception" : what_.c_str();
+        constexpr size_t                mask = TableSize() - 1;
+        std::array<uint32_t, N>         hashes{};
+        std::array<size_t, TableSize()> counts{};
+        size_t                          largest = 0;
+        for (size_t i = 0; i < N; i++) {
+            hashes[i] = Hash(keys_[i], seed, true);
+            for (size_t j = 0; j < i; j++) {
+                /* no displacement separates keys of the same full hash */
+                if (hashes[j] == hashes[i])
+                    return false;
+            }
+            largest = std::max(largest, ++counts[hashes[i] & mask]);
+        }
+        for (auto& slot : table_)
+            slot = npos;
+        for (auto& displacement : displacement_)
+            displacement = 0;
+        for (size_t count = largest; count > 0; count--) {
+            for (size_t bucket = 0; bucket <= mask; bucket++) {
+                if (counts[bucket] == count && !PlaceBucket(bucket, hashes))
+                    return false;
+            }
+        }
+        seed_      = seed;
+        full_      = true;
+        displaced_ = true;
+        return true;
     }
 
-    /* get error_code */
-    T GetErrorCode() { return type_; }
+    constexpr bool PlaceBucket(size_t bucket, std::array<uint32_t, N> const& hashes)
+    {
+        constexpr size_t mask = TableSize() - 1;
+        for (uint32_t displacement = 1; displacement < (1u << 16); displacement++) {
+            size_t placed = 0;
+            for (size_t i = 0; i < N; i++) {
+                if ((hashes[i] & mask) != bucket)
+                    continue;
+                auto& slot = table_[Mix(hashes[i] ^ displacement) & mask];
+                if (slot != npos)
+                    break;
+                slot = i;
+                placed++;
+            }
+            if (placed == CountBucket(bucket, hashes)) {
+                displacement_[bucket] = displacement;
+                return true;
+            }
+            /* undo the keys placed before the collision */
+            for (size_t i = 0; i < N; i++) {
+                auto& slot = table_[Mix(hashes[i] ^ displacement) & mask];
+                if ((hashes[i] & mask) == bucket && slot == i)
+                    slot = npos;
+            }
+        }
+        return false;
+    }
 
-    /* construct ParseError with string matched enum */
-    template<T N>
-    static Exception ConstructWithErrorCode()
+    static constexpr size_t CountBucket(size_t bucket, std::array<uint32_t, N> const& hashes)
     {
-        constexpr std::string_view sv        = __PRETTY_FUNCTION__;
-        constexpr size_t           pos       = sv.find("N = tijson::") + 12;
-        constexpr size_t           begin_pos = sv.find_first_of("::", pos) + 2;
-#if defined(__clang__)
-        constexpr size_t end_pos = sv.find_first_of(']', begin_pos);
-#elif defined(__GNUC__)
-        constexpr size_t end_pos = sv.find_first_of(';', begin_pos);
-#endif
-        return {N, std::string(sv.substr(begin_pos, end_pos - begin_pos))};
+        size_t count = 0;
+        for (auto h : hashes)
+            count += (h & (TableSize() - 1)) == bucket;
+        return count;
     }
 
-private:
-    std::string what_;
-    T           type_;
+    std::array<std::string_view, N>       keys_{};
+    std::array<size_t, KeyTableSize(N)>   table_{};
+    std::array<uint32_t, KeyTableSize(N)> displacement_{};
+    uint32_t                              seed_{0};
+    bool                                  full_{false};
+    bool                                  displaced_{false};
 };
 
-/* parse json string to value, if failed, throw an exception */
+/* build a KeyMatcher from string literals: constexpr auto keys = MakeKeyMatcher("id", "ts"); */
+template<class... K>
+constexpr KeyMatcher<sizeof...(K)> MakeKeyMatcher(K const&... keys)
+{
+    return KeyMatcher<sizeof...(K)>(std::array<std::string_view, sizeof...(K)>{keys...});
+}
+
+/* what ParseObjectInto does with keys that are not in the matcher */
+enum class UNKNOWN_KEY : char
+{
+    SKIP,
+    ERROR,
+};
+
+/* NOTE: STRUCT BINDING */
+// TIJSON_DEFINE(Order, id, price, items) maps the listed members to json keys of the same name.
+// Use it at namespace scope, in the namespace of the struct, so the fields are found by ADL.
+#define TIJSON_DEFINE(Type, ...)                                                  \
+    [[maybe_unused]] constexpr auto TijsonFields(Type const*)                     \
+    {                                                                             \
+        return std::make_tuple(TIJSON_FOR_EACH(TIJSON_FIELD, Type, __VA_ARGS__)); \
+    }
+
+#define TIJSON_FIELD(Type, member) \
+    ::tijson::Field<Type, decltype(Type::member)> { #member, &Type::member }
+
+#define TIJSON_EXPAND(x) x
+#define TIJSON_FE_1(F, T, x) F(T, x)
+#define TIJSON_FE_2(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_1(F, T, __VA_ARGS__))
+#define TIJSON_FE_3(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_2(F, T, __VA_ARGS__))
+#define TIJSON_FE_4(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_3(F, T, __VA_ARGS__))
+#define TIJSON_FE_5(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_4(F, T, __VA_ARGS__))
+#define TIJSON_FE_6(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_5(F, T, __VA_ARGS__))
+#define TIJSON_FE_7(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_6(F, T, __VA_ARGS__))
+#define TIJSON_FE_8(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_7(F, T, __VA_ARGS__))
+#define TIJSON_FE_9(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_8(F, T, __VA_ARGS__))
+#define TIJSON_FE_10(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_9(F, T, __VA_ARGS__))
+#define TIJSON_FE_11(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_10(F, T, __VA_ARGS__))
+#define TIJSON_FE_12(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_11(F, T, __VA_ARGS__))
+#define TIJSON_FE_13(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_12(F, T, __VA_ARGS__))
+#define TIJSON_FE_14(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_13(F, T, __VA_ARGS__))
+#define TIJSON_FE_15(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_14(F, T, __VA_ARGS__))
+#define TIJSON_FE_16(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_15(F, T, __VA_ARGS__))
+#define TIJSON_FE_17(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_16(F, T, __VA_ARGS__))
+#define TIJSON_FE_18(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_17(F, T, __VA_ARGS__))
+#define TIJSON_FE_19(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_18(F, T, __VA_ARGS__))
+#define TIJSON_FE_20(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_19(F, T, __VA_ARGS__))
+#define TIJSON_FE_21(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_20(F, T, __VA_ARGS__))
+#define TIJSON_FE_22(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_21(F, T, __VA_ARGS__))
+#define TIJSON_FE_23(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_22(F, T, __VA_ARGS__))
+#define TIJSON_FE_24(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_23(F, T, __VA_ARGS__))
+#define TIJSON_FE_25(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_24(F, T, __VA_ARGS__))
+#define TIJSON_FE_26(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_25(F, T, __VA_ARGS__))
+#define TIJSON_FE_27(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_26(F, T, __VA_ARGS__))
+#define TIJSON_FE_28(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_27(F, T, __VA_ARGS__))
+#define TIJSON_FE_29(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_28(F, T, __VA_ARGS__))
+#define TIJSON_FE_30(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_29(F, T, __VA_ARGS__))
+#define TIJSON_FE_31(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_30(F, T, __VA_ARGS__))
+#define TIJSON_FE_32(F, T, x, ...) F(T, x), TIJSON_EXPAND(TIJSON_FE_31(F, T, __VA_ARGS__))
+#define TIJSON_FE_SELECT( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, \
+    _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define TIJSON_FOR_EACH(F, T, ...) \
+    TIJSON_EXPAND(TIJSON_FE_SELECT(__VA_ARGS__, TIJSON_FE_32, TIJSON_FE_31, TIJSON_FE_30, \
+    TIJSON_FE_29, TIJSON_FE_28, TIJSON_FE_27, TIJSON_FE_26, TIJSON_FE_25, TIJSON_FE_24, \
+    TIJSON_FE_23, TIJSON_FE_22, TIJSON_FE_21, TIJSON_FE_20, TIJSON_FE_19, TIJSON_FE_18, \
+    TIJSON_FE_17, TIJSON_FE_16, TIJSON_FE_15, TIJSON_FE_14, TIJSON_FE_13, TIJSON_FE_12, \
+    TIJSON_FE_11, TIJSON_FE_10, TIJSON_FE_9, TIJSON_FE_8, TIJSON_FE_7, TIJSON_FE_6, \
+    TIJSON_FE_5, TIJSON_FE_4, TIJSON_FE_3, TIJSON_FE_2, TIJSON_FE_1)(F, T, __VA_ARGS__))
+
+/* a json key bound to a data member */
+template<class C, class M>
+struct Field
+{
+    std::string_view name;
+    M C::*member;
+};
+
+/* binding traits */
+template<class T, class = void>
+struct IsBound : std::false_type
+{};
+template<class T>
+struct IsBound<T, std::void_t<decltype(TijsonFields(std::declval<T const*>()))>> : std::true_type
+{};
+
+template<class T>
+struct IsVector : std::false_type
+{};
+template<class T, class A>
+struct IsVector<std::vector<T, A>> : std::true_type
+{};
+
+template<class T>
+struct IsOptional : std::false_type
+{};
+template<class T>
+struct IsOptional<std::optional<T>> : std::true_type
+{};
+
+template<class T>
+struct IsStringMap : std::false_type
+{};
+template<class V, class C, class A>
+struct IsStringMap<std::map<std::string, V, C, A>> : std::true_type
+{};
+template<class V, class H, class E, class A>
+struct IsStringMap<std::unordered_map<std::string, V, H, E, A>> : std::true_type
+{};
+
+template<class T>
+inline constexpr bool always_false = false;
+
+/* the field tuple of a bound type, usable in constant expressions */
+template<class T>
+constexpr auto FieldsOf()
+{
+    return TijsonFields(static_cast<T const*>(nullptr));
+}
+
+/* the key matcher of a bound type, slot i is the i-th field */
+template<class T>
+constexpr auto FieldMatcherOf()
+{
+    return std::apply(
+        [](auto const&... field) {
+            return KeyMatcher<sizeof...(field)>(
+                std::array<std::string_view, sizeof...(field)>{field.name...});
+        },
+        FieldsOf<T>());
+}
+
+/* NOTE: CLASS WRITER */
+class Writer final
+{
+public:
+    /* serialize Value, bound types and the supported std containers */
+    template<class T>
+    static void Write(T const& val, std::string& out);
+
+private:
+    static void WriteNumber(double, std::string& out);
+    static void WriteString(std::string_view, std::string& out);
+};
+
+/* NOTE: CLASS PROJECTION */
+// A set of JSON Pointer paths (RFC 6901) selecting the subtrees a parse should build, a "*"
+// segment matches every array item or object member. Objects keep only the selected members
+// and arrays only the selected items, everything else is validated and skipped.
+class Projection final
+{
+public:
+    /* throw std::invalid_argument if a path is neither empty nor starts with '/' */
+    Projection(std::initializer_list<std::string_view> paths);
+
+    /* a node of the path trie, a leaf selects its whole subtree */
+    struct Node
+    {
+        std::vector<std::pair<std::string, size_t>> children;
+        size_t                                       wildcard = 0;   // 0 when absent
+        bool                                         leaf     = false;
+    };
+
+    /* child of node matching key, 0 when the key is not selected */
+    [[nodiscard]] size_t Find(size_t node, std::string_view key) const;
+    [[nodiscard]] size_t FindIndex(size_t node, size_t index) const;
+
+    [[nodiscard]] Node const& operator[](size_t node) const { return nodes_[node]; }
+
+    /* root node of the trie */
+    static constexpr size_t kRoot = 0;
+
+private:
+    void AddPath(std::string_view path);
+
+    std::vector<Node> nodes_;
+};
+
+/* NOTE: CLASS QUERY */
+// A JSON Pointer (RFC 6901) or a JSONPath subset compiled once and evaluated over raw text,
+// without building a Value. JSONPath supports $, .name, ['name'], [index], .* and [*]. Values
+// off the path are skipped, and a query without wildcards stops reading at its first match, so
+// the text after it is not validated.
+class QueryMatch final
+{
+public:
+    QueryMatch() = default;
+    explicit QueryMatch(std::string_view text) : text_(text) {}
+
+    /* the raw text of the matched value */
+    [[nodiscard]] std::string_view GetText() const { return text_; }
+
+    /* getter, throw AccessException on type mismatch */
+    [[nodiscard]] Value::TYPE GetType() const;
+    [[nodiscard]] bool        GetBool() const;
+    [[nodiscard]] double      GetNumber() const;
+    /* decoded string */
+    [[nodiscard]] std::string GetString() const;
+    /* string between the quotes, escapes are left as they are */
+    [[nodiscard]] std::string_view GetRawString() const;
+
+    /* parse the matched text into a Value */
+    [[nodiscard]] Value ToValue() const;
+
+private:
+    std::string_view text_;
+};
+
+class Query final
+{
+public:
+    /* compile a JSON Pointer ("" or starting with '/') or a JSONPath (starting with '$') */
+    /* throw std::invalid_argument if expr is neither */
+    static Query Compile(std::string_view expr);
+
+    /* every match in document order, throw ParseException on malformed text */
+    [[nodiscard]] std::vector<QueryMatch> Evaluate(std::string_view content) const;
+    /* the first match, reading no further than it */
+    [[nodiscard]] std::optional<QueryMatch> First(std::string_view content) const;
+
+    struct Step
+    {
+        enum class KIND : char
+        {
+            KEY,            // object member
+            INDEX,          // array item
+            KEY_OR_INDEX,   // a pointer segment, an object member or a decimal array index
+            ANY,            // every member or item
+        };
+        KIND        kind  = KIND::ANY;
+        std::string key;
+        size_t      index = 0;
+    };
+
+private:
+    Query() = default;
+
+    void        AddPointerSegment(std::string segment);
+    static bool IsDecimal(std::string_view str);
+
+    std::vector<Step> steps_;
+    bool              wildcard_ = false;
+};
+
+/* how a parse stores values, every option is off by default */
+struct ParseOptions
+{
+    /* not an aggregate, so Parse(content, {"/path"}) still selects Projection */
+    ParseOptions() {}
+
+    /* objects with the keys of the previous record share its Shape, see class Shape */
+    bool share_shapes = false;
+    /* arrays of nothing but numbers are stored as NumberArray, see Value::GetNumberSpan. Not
+       with lazy_numbers, whose numbers keep their text */
+    bool pack_numbers = false;
+    /* content that is not valid utf-8 fails with INVALID_UTF8, see Parser::FindInvalidUtf8 */
+    bool strict_utf8 = false;
+    /* numbers keep their text until the first GetNumber, see Value::IsLazyNumber */
+    bool lazy_numbers = false;
+    /* the subtrees selected by these paths are checked and kept as raw slices of the content,
+       see Value::SetRaw. The rest of the document is parsed without share_shapes */
+    std::optional<Projection> raw;
+};
+
+/* NOTE: CLASS PARSER */
+class Parser final
+{
+    using str_itr = std::string_view::iterator;
+
+public:
+    /* copy deleted */
+    Parser(Parser const&)            = delete;
+    Parser& operator=(Parser const&) = delete;
+
+    /* move undeclared */
+
+    ~Parser() = default;
+
+    /* parse content to json value */
+    static Value Parse(std::string_view content);
+
+    /* parse content, building only the subtrees selected by projection */
+    static Value Parse(std::string_view content, Projection const& projection);
+
+    /* parse content, interning object keys in keys, objects keep the table alive */
+    static Value Parse(std::string_view content, std::shared_ptr<KeyTable> const& keys);
+
+    /* parse content with storage options */
+    static Value Parse(std::string_view content, ParseOptions const& options);
+
+    /* check that content is well-formed json whose strings are valid utf-8, without building
+       a Value or allocating. An INVALID_UTF8 exception has the offset of the bad sequence */
+    static void Validate(std::string_view content);
+
+    /* offset of the first byte that does not start a well-formed utf-8 sequence, or npos. On
+       x86 a cpu with SSSE3 checks 16 bytes at a time */
+    static size_t FindInvalidUtf8(std::string_view content);
+
+    /* parse content directly into a bound type, without building a Value */
+    template<class T>
+    static void ParseInto(std::string_view content, T& out);
+
+    /* parse content as a stream of events without building a Value, the handler provides:
+       Null(), Bool(bool), Number(double, string_view text), String(string_view),
+       StartArray(), EndArray(size_t count), StartObject(), Key(string_view),
+       EndObject(size_t count). The string views are only valid during the call. */
+    template<class Handler>
+    static void ParseEvents(std::string_view content, Handler& handler);
+
+    /* parse an object into the slots of a fixed key list, absent keys become invalid values */
+    template<size_t N>
+    static void ParseObjectInto(std::string_view      content,
+                                KeyMatcher<N> const&  keys,
+                                std::array<Value, N>& slots,
+                                UNKNOWN_KEY           policy = UNKNOWN_KEY::SKIP);
+
+private:
+    /* constructor private */
+    Parser(str_itr cur, str_itr end) : cur_(cur), end_(end) {}
+
+    /* real parse */
+    Value Parse();
+
+    /* parse utils */
+    Value ParseValue();
+    void  ParseWhitespace();
+    void  ParseNull(Value&);
+    void  ParseTrue(Value&);
+    void  ParseFalse(Value&);
+    void  ParseNumber(Value&);
+    void  ParseString(Value&);
+    void  ParseArray(Value&);
+    void  ParseObject(Value&);
+    void  ParseCompactObject(Value&);
+    /* with pack_numbers, parse an array item into numbers while every item is a number */
+    bool  ParsePackedItem(NumberArray& numbers, Array& items);
+
+    /* parse with share_shapes, prev is the value in the same place of the previous sibling
+       record, or else the previous sibling itself, and lends its Shape to objects */
+    void ParseShaped(Value&, Value const* prev);
+    void ParseShapedArray(Value&, Value const* prev);
+    void ParseShapedObject(Value&, Value const* prev);
+
+    /* parse string, return raw string */
+    std::string ParseString();
+    /* parse string, append it to s */
+    void ParseString(std::string& s);
+
+    /* parse number, return raw number */
+    double ParseNumber();
+    /* validate a number without converting it, return true if it may be out of range */
+    bool SkipNumber();
+
+    /* parse string, return a view into content unless it has escapes */
+    std::string_view ParseStringView();
+
+    /* columns read records with the skip and string utils */
+    friend class Columns;
+    /* the formatter copies string bodies with ScanPlain */
+    friend class Formatter;
+
+    /* number of leading bytes of data that are neither a quote, a backslash nor a control
+       character, 16 at a time with SSE2 */
+    static size_t ScanPlain(char const* data, size_t size);
+
+    /* evaluate query steps over a value, return true once on_match asks to stop */
+    friend class Query;
+    template<class OnMatch>
+    bool ParseQuery(std::vector<Query::Step> const& steps, size_t step, OnMatch& on_match);
+
+    /* parse a value, building only the subtrees under a projection node */
+    void ParseProjected(Value& val, Projection const& projection, size_t node);
+    /* parse a value, keeping the subtrees selected by options_.raw as text */
+    void ParseKeepRaw(Value& val, size_t node);
+
+    /* parse into val, reusing the strings, arrays and objects it holds and the spares of
+       reuse, see class ReusableParser */
+    friend class ReusableParser;
+    void ParseReuse(Value& val, ReusableParser& reuse);
+    void ParseReuseString(Value& val);
+    void ParseReuseArray(Value& val, ReusableParser& reuse);
+    void ParseReuseObject(Value& val, ReusableParser& reuse);
+
+
+    /* skip a value, validating it without building it */
+    void SkipValue();
+    void SkipString();
+
+    /* utf-8 utils: bytes of the well-formed sequence at data, 0 if it is not well-formed, and
+       the scalar scan from pos, which must be the start of a sequence */
+    static size_t Utf8SequenceSize(unsigned char const* data, size_t size);
+    static size_t FindInvalidUtf8(unsigned char const* data, size_t pos, size_t size);
+#if defined(__SSSE3__) || defined(TIJSON_SSSE3_DISPATCH)
+    /* the SSSE3 scan, the offset of the first 16-byte block it does not pass */
+    TIJSON_SSSE3_TARGET static size_t ScanUtf8Ssse3(unsigned char const* data, size_t size);
+#endif
+    /* throw INVALID_UTF8 with the offset if content is not valid utf-8 */
+    static void CheckUtf8(std::string_view content);
+
+    /* parse into bound types */
+    template<class T>
+    void ParseValueInto(T& out);
+    template<class T>
+    bool ParseFieldInto(T& out, std::string_view key);
+    template<class T, size_t... I>
+    bool ParseFieldInto(T& out, size_t slot, std::index_sequence<I...>);
+
+    /* parse into events */
+    template<class Handler>
+    void ParseEvent(Handler& handler);
+
+
+    /* parse number util */
+    template<char lower, char upper>
+    bool IsDigital(char ch);
+
+    /* parse string util */
+    bool IsInvalidChar(char ch);
+
+    /* parse unicode util */
+    char16_t    ParseStringHex4();
+    void        ParseStringUtf8(std::string& s);
+
+    /* objects with more members are stored as Object, where lookup is not a linear scan */
+    static constexpr size_t kMaxCompactMembers = 64;
+
+    /* data */
+    str_itr                   cur_;
+    str_itr                   end_;
+    std::string               str_buffer_;
+    std::shared_ptr<KeyTable> keys_;
+    ParseOptions              options_;
+};
+
+/* NOTE: CLASS REUSABLE PARSER */
+// A parser kept across documents, for one thread. ParseInto parses into a Value that holds the
+// previous document and reuses its storage: strings are overwritten in place, arrays and
+// objects keep their capacity and bucket arrays, and a member is parsed into the member with
+// the same key of the previous document. Items and members left over are kept as spares for
+// the next arrays and objects, so documents of a similar shape are parsed with almost no
+// allocation. Values are stored as Parse stores them, without the ParseOptions layouts.
+class ReusableParser final
+{
+public:
+    ReusableParser() = default;
+
+    ReusableParser(ReusableParser const&)            = delete;
+    ReusableParser& operator=(ReusableParser const&) = delete;
+
+    /* parse content into val, throw ParseException if it is malformed. On error val holds
+       what was parsed so far, and it can still be passed to the next ParseInto */
+    void ParseInto(std::string_view content, Value& val);
+
+    /* number of items and members kept for later documents */
+    [[nodiscard]] size_t SpareCount() const { return values_.size() + members_.size(); }
+    /* free the spares and buffers */
+    void ReleaseSpares();
+
+private:
+    friend class Parser;
+
+    std::vector<Value>             values_;    // items left over from longer arrays
+    std::vector<Object::node_type> members_;   // members taken out of objects being parsed
+    std::string                    buffer_;    // keys with escapes
+};
+
+/* NOTE: CLASS PARSER EXCEPTION */
+template<class T>
+class Exception : public std::exception
+{
+public:
+    Exception() = default;
+    Exception(std::string what) : what_(std::move(what)){};
+    Exception(T type, std::string what) : what_(std::move(what)), type_(type){};
+
+    Exception(Exception const&)            = default;
+    Exception& operator=(Exception const&) = default;
+
+    Exception(Exception&&) noexcept            = default;
+    Exception& operator=(Exception&&) noexcept = default;
+
+    ~Exception() noexcept override = default;
+
+    [[nodiscard]] const char* what() const noexcept override
+    {
+        return what_.empty() ? "Unknown exception" : what_.c_str();
+    }
+
+    /* get error_code */
+    T GetErrorCode() { return type_; }
+
+    /* byte offset into the input where the error was found, npos when it is not known */
+    [[nodiscard]] size_t GetOffset() const { return offset_; }
+    Exception&           SetOffset(size_t offset)
+    {
+        offset_ = offset;
+        return *this;
+    }
+
+    /* construct ParseError with string matched enum */
+    template<T N>
+    static Exception ConstructWithErrorCode()
+    {
+        constexpr std::string_view sv        = __PRETTY_FUNCTION__;
+        constexpr size_t           pos       = sv.find("N = tijson::") + 12;
+        constexpr size_t           begin_pos = sv.find_first_of("::", pos) + 2;
+#if defined(__clang__)
+        constexpr size_t end_pos = sv.find_first_of(']', begin_pos);
+#elif defined(__GNUC__)
+        constexpr size_t end_pos = sv.find_first_of(';', begin_pos);
+#endif
+        return {N, std::string(sv.substr(begin_pos, end_pos - begin_pos))};
+    }
+
+private:
+    std::string what_;
+    T           type_;
+    size_t      offset_ = std::string_view::npos;
+};
+
+/* parse json string to value, if failed, throw an exception */
 static Value Parse(std::string_view content)
 {
-    Value result;
-    try {
-        result = Parser::Parse(content);
+    Value result;
+    try {
+        result = Parser::Parse(content);
+    }
+    catch (ParseException& e) {
+        result.SetInvalid(e.GetErrorCode());
+    }
+    return result;
+}
+
+/* parse the subtrees selected by projection, if failed, return a value with the error code */
+inline Value Parse(std::string_view content, Projection const& projection)
+{
+    Value result;
+    try {
+        result = Parser::Parse(content, projection);
+    }
+    catch (ParseException& e) {
+        result.SetInvalid(e.GetErrorCode());
+    }
+    return result;
+}
+
+/* parse json string interning object keys in keys, if failed, return a value with the error code */
+inline Value Parse(std::string_view content, std::shared_ptr<KeyTable> const& keys)
+{
+    Value result;
+    try {
+        result = Parser::Parse(content, keys);
+    }
+    catch (ParseException& e) {
+        result.SetInvalid(e.GetErrorCode());
+    }
+    return result;
+}
+
+/* parse json string with storage options, if failed, return a value with the error code */
+inline Value Parse(std::string_view content, ParseOptions const& options)
+{
+    Value result;
+    try {
+        result = Parser::Parse(content, options);
+    }
+    catch (ParseException& e) {
+        result.SetInvalid(e.GetErrorCode());
+    }
+    return result;
+}
+
+/* check that content is well-formed json with valid utf-8 strings, return the error code */
+inline PARSE_ERROR Validate(std::string_view content)
+{
+    try {
+        Parser::Validate(content);
+    }
+    catch (ParseException& e) {
+        return e.GetErrorCode();
+    }
+    return PARSE_ERROR::NO_ERROR;
+}
+
+/* parse json string into a bound type, if failed, return the error code */
+template<class T>
+PARSE_ERROR ParseInto(std::string_view content, T& out)
+{
+    try {
+        Parser::ParseInto(content, out);
+    }
+    catch (ParseException& e) {
+        return e.GetErrorCode();
+    }
+    return PARSE_ERROR::NO_ERROR;
+}
+
+/* serialize a bound type directly, without building a Value */
+template<class T>
+std::string Stringify(T const& val)
+{
+    TIJSON_STATS_SCOPE(STRINGIFY);
+    std::string result;
+    Writer::Write(val, result);
+    TIJSON_STATS_BYTES(result.size());
+    return result;
+}
+
+/* NOTE: CLASS SCHEMA */
+// A JSON Schema compiled once into a flat table of nodes. Supported keywords: type, enum,
+// minimum, maximum, exclusiveMinimum, exclusiveMaximum, minLength, maxLength, pattern, items,
+// minItems, maxItems, properties, required and the boolean form of additionalProperties. The
+// boolean schemas true and false accept and reject every value.
+class Schema final
+{
+public:
+    /* compile a schema value, throw SchemaException if the schema is malformed */
+    static Schema Compile(Value const& schema);
+
+    /* validate a built value */
+    [[nodiscard]] SCHEMA_ERROR Validate(Value const& val) const;
+
+    /* parse and validate content in one pass without building a Value, stop at the first error */
+    [[nodiscard]] SCHEMA_ERROR ValidateStream(std::string_view content) const;
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /* json types accepted by a node */
+    enum TYPE_MASK : uint8_t
+    {
+        NUL     = 1,
+        BOOLEAN = 2,
+        INTEGER = 4,
+        NUMBER  = 8,
+        STRING  = 16,
+        ARRAY   = 32,
+        OBJECT  = 64,
+        ANY     = 127,
+    };
+
+    struct Node
+    {
+        uint8_t                                     types = ANY;
+        std::vector<Value>                          enums;
+        std::optional<double>                       minimum;
+        std::optional<double>                       maximum;
+        std::optional<double>                       exclusive_minimum;
+        std::optional<double>                       exclusive_maximum;
+        // the draft 4 boolean exclusiveMinimum/exclusiveMaximum, modifying minimum/maximum
+        bool                                        minimum_is_exclusive = false;
+        bool                                        maximum_is_exclusive = false;
+        size_t                                      min_length           = 0;
+        size_t                                      max_length           = npos;
+        std::optional<std::regex>                   pattern;
+        size_t                                      items     = npos;
+        size_t                                      min_items = 0;
+        size_t                                      max_items = npos;
+        std::vector<std::pair<std::string, size_t>> properties;   // sorted by key
+        std::vector<std::string>                    required;     // sorted
+        bool                                        additional_properties = true;
+    };
+
+    /* event handler used by ValidateStream */
+    class StreamValidator;
+
+    /* compile utils */
+    size_t CompileNode(Value const& schema);
+
+    /* validate utils, throw SchemaException on the first violation */
+    void   ValidateNode(size_t node, Value const& val) const;
+    void   CheckType(size_t node, uint8_t type) const;
+    void   CheckNumber(size_t node, double number) const;
+    void   CheckString(size_t node, std::string_view str) const;
+    void   CheckItems(size_t node, size_t count) const;
+    void   CheckEnum(size_t node, Value const& val) const;
+    size_t FindProperty(size_t node, std::string_view key) const;
+    size_t FindRequired(size_t node, std::string_view key) const;
+
+    std::vector<Node> nodes_;
+};
+
+/* NOTE: CLASS MSGPACK AND CBOR */
+// Binary codecs for Value. Integral numbers that fit in 64 bits are written as integers, other
+// numbers as float32 when that is lossless and float64 otherwise. Decoding reserves arrays and
+// objects up front from the length prefixes and builds strings directly in the Value.
+class MsgPack final
+{
+public:
+    /* encode val, appending to out */
+    static void        Encode(Value const& val, std::string& out);
+    static std::string Encode(Value const& val);
+
+    /* decode data to a value, if failed, throw a DecodeException */
+    static Value Decode(std::string_view data);
+
+private:
+    MsgPack(char const* cur, char const* end) : cur_(cur), end_(end) {}
+
+    static void EncodeString(std::string_view str, std::string& out);
+
+    Value       DecodeValue();
+    std::string DecodeString(size_t length);
+    Value       DecodeArray(size_t length);
+    Value       DecodeObject(size_t length);
+    uint64_t    ReadUInt(size_t bytes);
+
+    char const* cur_;
+    char const* end_;
+};
+
+class Cbor final
+{
+public:
+    /* encode val, appending to out */
+    static void        Encode(Value const& val, std::string& out);
+    static std::string Encode(Value const& val);
+
+    /* decode data to a value, if failed, throw a DecodeException */
+    static Value Decode(std::string_view data);
+
+private:
+    Cbor(char const* cur, char const* end) : cur_(cur), end_(end) {}
+
+    static void EncodeHead(uint8_t major, uint64_t argument, std::string& out);
+
+    Value       DecodeValue();
+    std::string DecodeString(uint8_t major, uint8_t info);
+    uint64_t    ReadArgument(uint8_t info);
+    uint64_t    ReadUInt(size_t bytes);
+    bool        IsBreak();
+
+    char const* cur_;
+    char const* end_;
+};
+
+/* NOTE: CLASS IMAGE */
+// A position-independent, read-only binary image of a document. Every reference inside the image
+// is an offset from its first byte, so the bytes can be written once to a file or to shared
+// memory and viewed in place, at any address, by many processes. Opening an image checks that
+// every slot lies inside it, once, so views never read out of bounds. Images use the byte order
+// of the writer.
+struct ImageSlot
+{
+    Value::TYPE type;
+    char        reserved[3];
+    uint32_t    length;    // bytes of a string, items of an array, members of an object
+    uint64_t    payload;   // number bits, or offset of the string bytes / items / members
+};
+
+class ImageView final
+{
+public:
+    ImageView() = default;
+
+    /* type check */
+    [[nodiscard]] Value::TYPE GetType() const { return slot_ ? slot_->type : Value::TYPE::INVALID; }
+    explicit                  operator bool() const { return slot_ != nullptr; }
+
+    /* getter, throw AccessException on type mismatch */
+    [[nodiscard]] bool             GetBool() const;
+    [[nodiscard]] double           GetNumber() const;
+    [[nodiscard]] std::string_view GetString() const;
+
+    /* number of items of an array or members of an object */
+    [[nodiscard]] size_t size() const;
+
+    /* array item, or the value of the i-th member of an object in key order */
+    ImageView operator[](size_t index) const;
+    /* i-th key of an object, keys are sorted */
+    [[nodiscard]] std::string_view Key(size_t index) const;
+    /* member lookup by binary search, throw AccessException if the key is absent */
+    ImageView operator[](std::string_view key) const;
+    /* member lookup, return an invalid view if the key is absent */
+    [[nodiscard]] ImageView Find(std::string_view key) const;
+
+    /* copy into a heap Value */
+    [[nodiscard]] Value ToValue() const;
+
+private:
+    friend class Image;
+
+    ImageView(char const* base, ImageSlot const* slot) : base_(base), slot_(slot) {}
+
+    [[nodiscard]] ImageSlot const* Children() const
+    {
+        return reinterpret_cast<ImageSlot const*>(base_ + slot_->payload);
+    }
+    [[nodiscard]] std::string_view String(ImageSlot const& slot) const
+    {
+        return {base_ + slot.payload, slot.length};
+    }
+
+    char const*      base_ = nullptr;
+    ImageSlot const* slot_ = nullptr;
+};
+
+class Image final
+{
+public:
+    /* serialize val into an image, appending to out which must start 8-byte aligned. Throw
+       std::length_error if a string, array or object has more than UINT32_MAX bytes or entries */
+    static void        Write(Value const& val, std::string& out);
+    static std::string Write(Value const& val);
+
+    /* view an image in place, data must be 8-byte aligned and outlive the views */
+    /* throw a DecodeException if the header does not describe an image of this size, or a slot
+       points outside of it */
+    static ImageView Open(void const* data, size_t size);
+
+private:
+    struct Header
+    {
+        char      magic[4];
+        uint32_t  version;
+        uint64_t  size;
+        ImageSlot root;
+    };
+
+    static constexpr uint32_t kVersion = 1;
+
+    explicit Image(std::string& out) : out_(out), begin_(out.size()) {}
+
+    static void Verify(char const* base, uint64_t size);
+    static uint32_t Length(size_t length);
+
+    size_t Allocate(size_t bytes);
+    void   WriteValue(Value const& val, size_t slot_offset);
+    void   WriteString(std::string_view str, size_t slot_offset);
+    void   SetSlot(size_t slot_offset, ImageSlot const& slot);
+
+    std::string&                                   out_;
+    size_t                                         begin_;
+    std::unordered_map<std::string_view, uint64_t> strings_;
+};
+
+/* NOTE: CLASS POINTER */
+// A JSON Pointer (RFC 6901) compiled once into decoded segments, so resolving it against a
+// Value neither allocates nor inserts missing members.
+class Pointer final
+{
+public:
+    struct Segment
+    {
+        std::string key;                // decoded reference token
+        size_t      index    = 0;       // array index when is_index
+        bool        is_index = false;   // decimal without leading zeros
+    };
+
+    Pointer() = default;
+    /* throw std::invalid_argument if pointer is neither empty nor starts with '/' */
+    explicit Pointer(std::string_view pointer);
+
+    /* the referenced value, nullptr if it does not exist */
+    [[nodiscard]] Value*       Get(Value& root) const;
+    [[nodiscard]] Value const* Get(Value const& root) const;
+
+    /* replace the referenced value, or add it to an existing parent object or array, "-"
+       appends to an array. Return false if the parent does not exist or the index is out of range,
+       throw AccessException if the parent is frozen */
+    bool Set(Value& root, Value val) const;
+
+    /* remove the referenced value from its parent, return false if it does not exist, throw
+       AccessException if the parent is frozen */
+    bool Erase(Value& root) const;
+
+    /* resolve many pointers in one traversal, sharing common prefixes */
+    [[nodiscard]] static std::vector<Value const*> Resolve(Value const&                root,
+                                                           std::vector<Pointer> const& pointers);
+
+    /* segments and their encoded form */
+    [[nodiscard]] std::vector<Segment> const& Segments() const { return segments_; }
+    [[nodiscard]] std::string                 ToString() const;
+
+    /* pointer to a child member or item */
+    [[nodiscard]] Pointer Append(std::string_view key) const;
+    [[nodiscard]] Pointer Append(size_t index) const;
+
+private:
+    /* patches insert and move through the parent of a pointer */
+    friend class Patch;
+
+    static Segment MakeSegment(std::string key);
+    static Value*  Step(Value const& val, Segment const& segment);
+    Value*        GetParent(Value const& root) const;
+
+    std::vector<Segment> segments_;
+};
+
+/* NOTE: CLASS COLUMNS */
+// Typed columns of the records of a json array of objects or of NDJSON, built in one pass over
+// the text without building a Value per record. Each key becomes a column with one entry per
+// record, in order of first appearance. A column takes the type of its values: integers that
+// fit in int64 are INT64, other numbers make it DOUBLE, and mixed types, arrays or objects make
+// it JSON, where each entry is the json text of the value. Null and absent entries are cleared
+// in the validity bitmap and hold 0 or an empty string.
+class Column final
+{
+public:
+    enum class TYPE : char
+    {
+        NUL,   // every entry is null or absent
+        BOOL,
+        INT64,
+        DOUBLE,
+        STRING,
+        JSON,
+    };
+
+    explicit Column(std::string name) : name_(std::move(name)) {}
+
+    [[nodiscard]] std::string const& GetName() const { return name_; }
+    [[nodiscard]] TYPE               GetType() const { return type_; }
+    [[nodiscard]] size_t             size() const { return size_; }
+
+    /* bit row % 64 of word row / 64 is set when the entry is neither null nor absent */
+    [[nodiscard]] std::vector<uint64_t> const& GetValidity() const { return validity_; }
+    [[nodiscard]] bool IsValid(size_t row) const { return validity_[row / 64] >> (row % 64) & 1; }
+
+    /* the entries of a column of that type */
+    [[nodiscard]] std::vector<uint8_t> const& GetBools() const { return bools_; }
+    [[nodiscard]] std::vector<int64_t> const& GetInt64s() const { return int64s_; }
+    [[nodiscard]] std::vector<double> const&  GetDoubles() const { return doubles_; }
+    /* STRING and JSON: entry row is bytes [offsets[row], offsets[row + 1]) */
+    [[nodiscard]] std::vector<size_t> const& GetOffsets() const { return offsets_; }
+    [[nodiscard]] std::string const&         GetBytes() const { return bytes_; }
+    [[nodiscard]] std::string_view           GetString(size_t row) const;
+
+private:
+    friend class Columns;
+
+    /* append an entry, text is its json text and str the decoded string of a STRING */
+    void Append(TYPE type, std::string_view text, std::string_view str = {});
+    /* remove the last entry, for a key repeated in a record */
+    void PopBack();
+    /* change the type, converting the entries so far */
+    void        ConvertTo(TYPE type);
+    static bool ToInt64(std::string_view text, int64_t& out);
+
+    std::string           name_;
+    TYPE                  type_ = TYPE::NUL;
+    size_t                size_ = 0;
+    std::vector<uint64_t> validity_;
+    std::vector<uint8_t>  bools_;
+    std::vector<int64_t>  int64s_;
+    std::vector<double>   doubles_;
+    std::vector<size_t>   offsets_;
+    std::string           bytes_;
+};
+
+class Columns final
+{
+public:
+    /* columns of a json array of objects, throw ParseException if content is malformed and
+       DecodeException if the root is not an array or an item is not an object */
+    static Columns FromJson(std::string_view content);
+    /* columns of objects separated by newlines, blank lines are skipped */
+    static Columns FromNdjson(std::string_view content);
+    /* columns of an array of objects already built */
+    static Columns FromValue(Value const& val);
+
+    [[nodiscard]] size_t                     rows() const { return rows_; }
+    [[nodiscard]] std::vector<Column> const& GetColumns() const { return columns_; }
+    /* column by key, nullptr if no record has the key */
+    [[nodiscard]] Column const* Find(std::string_view name) const;
+
+private:
+    Columns() = default;
+
+    /* parse one record at the parser position */
+    void   ParseRecord(Parser& parser);
+    /* column of key, added if new, hint is the slot expected from the previous record */
+    size_t FindColumn(std::string_view key, size_t hint);
+
+    std::vector<Column>                     columns_;
+    std::unordered_map<std::string, size_t> index_;
+    size_t                                  rows_ = 0;
+};
+
+/* NOTE: CLASS FORMATTER */
+// A text-to-text transducer that checks json and writes it again in compact or pretty form in
+// one pass, without building a Value. Key order and the text of numbers and strings are kept
+// as they are. Content can be fed in chunks split anywhere, even inside a token. Numbers are
+// checked against the grammar but not converted, so NUMBER_TOO_BIG is not reported.
+class Formatter final
+{
+public:
+    enum class STYLE : char
+    {
+        COMPACT,   // no whitespace
+        PRETTY,    // one member or item per line, nested by indent spaces
+    };
+
+    explicit Formatter(STYLE style = STYLE::COMPACT, size_t indent = 4)
+        : style_(style), indent_(indent)
+    {}
+
+    /* write the next chunk of content to out, throw ParseException with the offset into the
+       whole content if it is malformed */
+    void Feed(std::string_view chunk, std::string& out);
+    /* check that the content fed so far is one complete value, and reset the formatter */
+    void Finish();
+
+    /* format a whole buffer */
+    static std::string Minify(std::string_view content);
+    static std::string Prettify(std::string_view content, size_t indent = 4);
+
+private:
+    /* what the next structural character must be */
+    enum class EXPECT : char
+    {
+        VALUE,
+        VALUE_OR_CLOSE,
+        KEY,
+        KEY_OR_CLOSE,
+        COLON,
+        COMMA_OR_CLOSE,
+        END,
+    };
+    /* the token being copied, which may continue in the next chunk */
+    enum class TOKEN : char
+    {
+        NONE,
+        STRING,
+        NUMBER,
+        LITERAL,
+    };
+    /* the part of a number read last */
+    enum class NUMBER : char
+    {
+        MINUS,
+        ZERO,
+        INT,
+        DOT,
+        FRAC,
+        EXP_MARK,
+        EXP_SIGN,
+        EXP,
+    };
+
+    size_t FeedString(char const* data, size_t size, std::string& out);
+    void   FeedEscape(char ch);
+    /* return false at the first character after the number, which is not consumed */
+    bool   FeedNumber(char ch);
+    void   FeedLiteral(char ch);
+    void   FeedStructural(char ch, std::string& out);
+    void   BeginValue(char ch, std::string& out);
+    void   Close(char ch, std::string& out);
+    void   EndValue();
+    void   NewLine(size_t depth, std::string& out) const;
+
+    STYLE       style_;
+    size_t      indent_;
+    EXPECT      expect_ = EXPECT::VALUE;
+    TOKEN       token_  = TOKEN::NONE;
+    std::string stack_;   // '[' and '{' of the open containers
+
+    bool             key_     = false;   // the string is a key
+    int              escape_  = 0;       // 0, 1 after a backslash, or 2 to 5 in \u hex digits
+    char16_t         unicode_ = 0;
+    bool             low_     = false;   // a low surrogate must follow
+    NUMBER           number_  = NUMBER::MINUS;
+    std::string_view literal_;
+    size_t           literal_pos_ = 0;
+    size_t           offset_      = 0;   // bytes of the chunks fed before
+};
+
+/* NOTE: CLASS PATCH */
+// JSON Patch (RFC 6902) and JSON Merge Patch (RFC 7396). Diff walks both documents once and
+// descends only into members and items that differ, so a patch holds the change and not the
+// document. Apply changes the document in place, through the parents of the paths.
+class Patch final
+{
+public:
+    /* an array of add, remove and replace operations that turns from into to. Arrays are
+       compared item by item after their common head and tail, without moves */
+    static Value Diff(Value const& from, Value const& to);
+    /* apply the operations of patch to root in order. Throw PatchException with the offset
+       set to the index of the failing operation, the operations before it stay applied.
+       Throw AccessException if an operation writes into a frozen value */
+    static void Apply(Value& root, Value const& patch);
+
+    /* a merge patch that turns from into to. A member of to whose value is null cannot be
+       expressed, it is removed by the patch */
+    static Value MergeDiff(Value const& from, Value const& to);
+    static void  ApplyMerge(Value& root, Value const& patch);
+
+private:
+    static void DiffInto(Value const& from, Value const& to, std::string& path, Array& ops);
+    static void AddOperation(Array& ops, char const* op, std::string const& path,
+                             Value const* val);
+    static void AppendToken(std::string& path, std::string_view token);
+    static void ApplyOperation(Value& root, Value const& op);
+    static void Add(Value& root, Pointer const& path, Value val);
+};
+
+/* NOTE: KEY TABLE IMPLEMENTATION */
+inline KeyTable::Key KeyTable::Intern(std::string_view key) /*{{{*/
+{
+    if (auto found = Find(key))
+        return found;
+    std::unique_lock<std::shared_mutex> lock;
+    if (thread_safe_) {
+        lock = std::unique_lock(mutex_);
+        /* another parser may have interned it since the shared lock was released */
+        if (auto it = index_.find(key); it != index_.end())
+            return it->second;
+    }
+    /* deque never moves its elements, so the views in index_ stay valid */
+    auto const& interned = keys_.emplace_back(key);
+    index_.emplace(interned, &interned);
+    return &interned;
+} /*}}}*/
+
+inline KeyTable::Key KeyTable::Find(std::string_view key) const /*{{{*/
+{
+    std::shared_lock<std::shared_mutex> lock;
+    if (thread_safe_)
+        lock = std::shared_lock(mutex_);
+    auto it = index_.find(key);
+    return it == index_.end() ? nullptr : it->second;
+} /*}}}*/
+
+inline size_t KeyTable::size() const /*{{{*/
+{
+    std::shared_lock<std::shared_mutex> lock;
+    if (thread_safe_)
+        lock = std::shared_lock(mutex_);
+    return keys_.size();
+} /*}}}*/
+
+inline size_t KeyTable::MemoryUsage() const /*{{{*/
+{
+    std::shared_lock<std::shared_mutex> lock;
+    if (thread_safe_)
+        lock = std::shared_lock(mutex_);
+    size_t bytes = keys_.size() * sizeof(std::string);
+    for (auto const& key : keys_)
+        if (key.capacity() > std::string().capacity())
+            bytes += key.capacity() + 1;
+    /* one node per key: next pointer, cached hash, then the entry, and the bucket array */
+    bytes += index_.size() *
+             (sizeof(void*) + sizeof(size_t) + sizeof(decltype(index_)::value_type));
+    bytes += index_.bucket_count() * sizeof(void*);
+    return bytes;
+} /*}}}*/
+
+/* NOTE: SHAPE IMPLEMENTATION */
+inline size_t Shape::Add(std::string_view key) /*{{{*/
+{
+    if (auto it = index_.find(key); it != index_.end())
+        return it->second;
+    /* deque never moves its elements, so the views in index_ stay valid */
+    auto const& added = keys_.emplace_back(key);
+    index_.emplace(added, keys_.size() - 1);
+    return keys_.size() - 1;
+} /*}}}*/
+
+inline size_t Shape::Find(std::string_view key) const /*{{{*/
+{
+    auto it = index_.find(key);
+    return it == index_.end() ? npos : it->second;
+} /*}}}*/
+
+inline size_t Shape::MemoryUsage() const /*{{{*/
+{
+    size_t bytes = sizeof(Shape) + keys_.size() * sizeof(std::string);
+    for (auto const& key : keys_)
+        if (key.capacity() > std::string().capacity())
+            bytes += key.capacity() + 1;
+    /* one node per key: next pointer, cached hash, then the entry, and the bucket array */
+    bytes += index_.size() *
+             (sizeof(void*) + sizeof(size_t) + sizeof(decltype(index_)::value_type));
+    bytes += index_.bucket_count() * sizeof(void*);
+    return bytes;
+} /*}}}*/
+
+/* NOTE: VALUE IMPLEMENTATION */
+inline Value::Value(Value const& rhs) /*{{{*/
+{
+    this->type_        = rhs.type_;
+    this->raw_checked_ = rhs.raw_checked_;
+    if (rhs.IsRaw())
+        this->data_ = std::get<RawJson>(rhs.data_);
+    else if (rhs.IsPackedArray())
+        this->data_ = std::get<NumberArray>(rhs.data_);
+    else if (rhs.type_ == TYPE::ARRAY)
+        this->data_ = std::make_unique<Array>(*std::get<ArrayUPtr>(rhs.data_));
+    else if (rhs.IsCompactObject())
+        this->data_ = std::make_unique<CompactObject>(*std::get<CompactObjectUPtr>(rhs.data_));
+    else if (rhs.IsShapedObject())
+        this->data_ = std::make_unique<ShapedObject>(*std::get<ShapedObjectUPtr>(rhs.data_));
+    else if (rhs.type_ == TYPE::OBJECT)
+        this->data_ = std::make_unique<Object>(*std::get<ObjectUPtr>(rhs.data_));
+    else if (rhs.IsLazyNumber())
+        this->data_ = std::get<std::string>(rhs.data_);
+    else if (rhs.type_ == TYPE::NUMBER)
+        this->data_ = std::get<double>(rhs.data_);
+    else if (rhs.type_ == TYPE::STRING)
+        this->data_ = std::get<std::string>(rhs.data_);
+    else if (rhs.type_ == TYPE::INVALID)
+        this->data_ = std::get<PARSE_ERROR>(rhs.data_);
+    else
+        this->data_ = PARSE_ERROR::NO_ERROR;
+} /*}}}*/
+
+inline Value& Value::operator=(Value const& rhs) /*{{{*/
+{
+    if (frozen_member_)
+        throw AccessException("VALUE_FROZEN");
+    this->~Value();
+    return *(new (this) Value(rhs));
+} /*}}}*/
+
+inline Value::Value(Value&& rhs) noexcept /*{{{*/
+    : data_(std::move(rhs.data_)),
+      type_(rhs.type_),
+      raw_checked_(rhs.raw_checked_),
+      frozen_(rhs.frozen_),
+      hash_(rhs.hash_)
+{
+    /* other threads may be reading a value under a frozen one, taking it is a bug */
+    if (rhs.frozen_member_)
+        std::terminate();
+    rhs.data_   = PARSE_ERROR::NO_ERROR;
+    rhs.type_   = TYPE::NUL;
+    rhs.frozen_ = false;
+    rhs.hash_   = 0;
+} /*}}}*/
+
+inline Value& Value::operator=(Value&& rhs) noexcept /*{{{*/
+{
+    if (frozen_member_ || rhs.frozen_member_)
+        std::terminate();
+    data_        = std::move(rhs.data_);
+    type_        = rhs.type_;
+    raw_checked_ = rhs.raw_checked_;
+    frozen_      = rhs.frozen_;
+    hash_        = rhs.hash_;
+    rhs.data_    = PARSE_ERROR::NO_ERROR;
+    rhs.type_    = TYPE::NUL;
+    rhs.frozen_  = false;
+    rhs.hash_    = 0;
+    return *this;
+} /*}}}*/
+
+template<class T,
+         std::enable_if_t<!std::is_same_v<std::decay_t<T>, Value> &&
+                              std::is_convertible_v<T&&, Value>,
+                          int>>
+inline Value& Value::operator=(T&& v) /*{{{*/
+{
+    if (frozen_member_)
+        throw AccessException("VALUE_FROZEN");
+    return *this = Value(std::forward<T>(v));
+} /*}}}*/
+
+inline Value::TYPE Value::GetType() const /*{{{*/
+{
+    return type_;
+} /*}}}*/
+
+inline std::string_view Value::GetRawJson() const /*{{{*/
+{
+    if (IsRaw())
+        return std::get<RawJson>(data_).json;
+    throw AccessException("VALUE_NOT_RAW");
+} /*}}}*/
+
+inline Value::TYPE Value::RawType(std::string_view json) /*{{{*/
+{
+    /* a valid fragment starts with its value, the first character tells the type */
+    auto first = json.find_first_not_of(" \t\n\r");
+    char ch    = first == json.npos ? '\0' : json[first];
+    switch (ch) {
+    case 'n': return TYPE::NUL;
+    case 't': return TYPE::TRUE;
+    case 'f': return TYPE::FALSE;
+    case '\"': return TYPE::STRING;
+    case '[': return TYPE::ARRAY;
+    case '{': return TYPE::OBJECT;
+    case '-': return TYPE::NUMBER;
+    default: return '0' <= ch && ch <= '9' ? TYPE::NUMBER : TYPE::INVALID;
+    }
+} /*}}}*/
+
+inline void Value::CheckRaw() const /*{{{*/
+{
+    if (raw_checked_)
+        return;
+    Parser::Validate(std::get<RawJson>(data_).json);
+    raw_checked_ = true;
+} /*}}}*/
+
+inline void Value::MaterializeRaw() const /*{{{*/
+{
+    CheckRaw();
+    Value val    = Parser::Parse(std::get<RawJson>(data_).json);
+    data_        = std::move(val.data_);
+    type_        = val.type_;
+    raw_checked_ = false;
+} /*}}}*/
+
+inline PARSE_ERROR Value::GetParseErrorCode() const /*{{{*/
+{
+    if (IsRaw())
+        CheckRaw();
+    return type_ == TYPE::INVALID ? std::get<PARSE_ERROR>(data_) : PARSE_ERROR::NO_ERROR;
+} /*}}}*/
+
+inline bool Value::GetBool() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::TRUE || type_ == TYPE::FALSE)
+        return type_ == TYPE::TRUE ? true : false;
+    throw AccessException("VALUE_NOT_BOOL");
+} /*}}}*/
+
+inline double Value::GetNumber() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (IsLazyNumber()) {
+        TIJSON_STATS_ADD(numbers_converted, 1);
+        double n = std::strtod(std::get<std::string>(data_).c_str(), nullptr);
+        if (frozen_)
+            return n;
+        data_ = n;
+    }
+    if (type_ == TYPE::NUMBER)
+        return std::get<double>(data_);
+    throw AccessException("VALUE_NOT_NUMBER");
+} /*}}}*/
+
+inline bool Value::IsLazyNumber() const /*{{{*/
+{
+    return type_ == TYPE::NUMBER && std::holds_alternative<std::string>(data_);
+} /*}}}*/
+
+inline std::string Value::GetString() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::STRING)
+        return std::get<std::string>(data_);
+    throw AccessException("VALUE_NOT_STRING");
+} /*}}}*/
+
+inline std::string_view Value::GetStringView() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::STRING)
+        return std::get<std::string>(data_);
+    throw AccessException("VALUE_NOT_STRING");
+} /*}}}*/
+
+inline Array& Value::GetArray() const /*{{{*/
+{
+    CheckNotFrozen();
+    return Items();
+} /*}}}*/
+
+inline Array const& Value::GetArrayView() const /*{{{*/
+{
+    return Items();
+} /*}}}*/
+
+inline Array& Value::Items() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::ARRAY) {
+        if (IsPackedArray())
+            MaterializeArray();
+        return *std::get<ArrayUPtr>(data_);
+    }
+    throw AccessException("VALUE_NOT_ARRAY");
+} /*}}}*/
+
+inline bool Value::IsPackedArray() const /*{{{*/
+{
+    return type_ == TYPE::ARRAY && std::holds_alternative<NumberArray>(data_);
+} /*}}}*/
+
+inline void Value::MaterializeArray() const /*{{{*/
+{
+    auto const& numbers = std::get<NumberArray>(data_);
+    Array       arr(numbers.begin(), numbers.end());
+    data_ = std::make_unique<Array>(std::move(arr));
+} /*}}}*/
+
+inline size_t Value::ItemCount() const /*{{{*/
+{
+    if (IsPackedArray())
+        return std::get<NumberArray>(data_).size();
+    return Items().size();
+} /*}}}*/
+
+template<class Func> /*{{{*/
+inline void Value::ForEachItem(Func&& func) const
+{
+    if (IsPackedArray()) {
+        for (double number : std::get<NumberArray>(data_)) {
+            Value const item(number);
+            func(item);
+        }
+        return;
+    }
+    for (auto const& item : Items())
+        func(static_cast<Value const&>(item));
+} /*}}}*/
+
+inline NumberSpan Value::GetNumberSpan() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ != TYPE::ARRAY)
+        throw AccessException("VALUE_NOT_ARRAY");
+    /* an Array is not repacked here, that would destroy the items other references point to */
+    if (!IsPackedArray())
+        throw AccessException("VALUE_NOT_PACKED");
+    auto const& numbers = std::get<NumberArray>(data_);
+    return {numbers.data(), numbers.size()};
+} /*}}}*/
+
+inline bool Value::PackNumbers() /*{{{*/
+{
+    CheckNotFrozen();
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ != TYPE::ARRAY)
+        return false;
+    if (IsPackedArray())
+        return true;
+    auto const& arr = *std::get<ArrayUPtr>(data_);
+    NumberArray numbers;
+    numbers.reserve(arr.size());
+    for (auto const& item : arr) {
+        if (item.GetType() != TYPE::NUMBER)
+            return false;
+        numbers.push_back(item.GetNumber());
+    }
+    data_ = std::move(numbers);
+    return true;
+} /*}}}*/
+
+inline Object& Value::GetObject() const /*{{{*/
+{
+    CheckNotFrozen();
+    return Members();
+} /*}}}*/
+
+inline Object const& Value::GetObjectView() const /*{{{*/
+{
+    return Members();
+} /*}}}*/
+
+inline Object& Value::Members() const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::OBJECT) {
+        if (!std::holds_alternative<ObjectUPtr>(data_))
+            MaterializeObject();
+        return *std::get<ObjectUPtr>(data_);
+    }
+    throw AccessException("VALUE_NOT_OBJECT");
+} /*}}}*/
+
+inline bool Value::IsCompactObject() const /*{{{*/
+{
+    return type_ == TYPE::OBJECT && std::holds_alternative<CompactObjectUPtr>(data_);
+} /*}}}*/
+
+inline bool Value::IsShapedObject() const /*{{{*/
+{
+    return type_ == TYPE::OBJECT && std::holds_alternative<ShapedObjectUPtr>(data_);
+} /*}}}*/
+
+inline void Value::MaterializeObject() const /*{{{*/
+{
+    Object obj;
+    if (IsShapedObject()) {
+        auto& shaped = *std::get<ShapedObjectUPtr>(data_);
+        obj.reserve(shaped.values.size());
+        for (size_t i = 0; i < shaped.values.size(); i++)
+            obj.emplace(shaped.shape->Key(i), std::move(shaped.values[i]));
+    }
+    else {
+        auto& compact = *std::get<CompactObjectUPtr>(data_);
+        obj.reserve(compact.members.size());
+        /* later duplicates win, as in a parse without a KeyTable */
+        for (auto& [key, member] : compact.members)
+            obj[*key] = std::move(member);
+    }
+    data_ = std::make_unique<Object>(std::move(obj));
+} /*}}}*/
+
+inline size_t Value::MemberCount() const /*{{{*/
+{
+    if (IsCompactObject())
+        return std::get<CompactObjectUPtr>(data_)->members.size();
+    if (IsShapedObject())
+        return std::get<ShapedObjectUPtr>(data_)->values.size();
+    return Members().size();
+} /*}}}*/
+
+template<class Func> /*{{{*/
+inline void Value::ForEachMember(Func&& func) const
+{
+    if (IsCompactObject()) {
+        for (auto const& [key, member] : std::get<CompactObjectUPtr>(data_)->members)
+            func(std::string_view(*key), static_cast<Value const&>(member));
+        return;
+    }
+    if (IsShapedObject()) {
+        auto const& shaped = *std::get<ShapedObjectUPtr>(data_);
+        for (size_t i = 0; i < shaped.values.size(); i++) {
+            Value const& member = shaped.values[i];
+            func(std::string_view(shaped.shape->Key(i)), member);
+        }
+        return;
+    }
+    for (auto const& [key, member] : Members())
+        func(std::string_view(key), static_cast<Value const&>(member));
+} /*}}}*/
+
+inline Value* Value::Find(std::string_view key) const /*{{{*/
+{
+    if (IsCompactObject()) {
+        for (auto& [member_key, member] : std::get<CompactObjectUPtr>(data_)->members)
+            if (*member_key == key)
+                return &member;
+        return nullptr;
+    }
+    if (IsShapedObject()) {
+        auto&  shaped = *std::get<ShapedObjectUPtr>(data_);
+        size_t slot   = shaped.shape->Find(key);
+        return slot == Shape::npos ? nullptr : &shaped.values[slot];
+    }
+    return Find(std::string(key));
+} /*}}}*/
+
+inline Value* Value::Find(std::string const& key) const /*{{{*/
+{
+    if (IsCompactObject() || IsShapedObject())
+        return Find(std::string_view(key));
+    auto& obj = Members();
+    auto  it  = obj.find(key);
+    return it == obj.end() ? nullptr : &it->second;
+} /*}}}*/
+
+inline Value* Value::Find(char const* key) const /*{{{*/
+{
+    return Find(std::string_view(key));
+} /*}}}*/
+
+inline Value* Value::Find(KeyTable::Key key) const /*{{{*/
+{
+    if (IsCompactObject()) {
+        auto& compact = *std::get<CompactObjectUPtr>(data_);
+        /* keys of another table are not interned in this one, compare them by content */
+        if (compact.table->Find(*key) != key)
+            return Find(*key);
+        for (auto& [member_key, member] : compact.members)
+            if (member_key == key)
+                return &member;
+        return nullptr;
+    }
+    if (IsShapedObject())
+        return Find(*key);
+    auto& obj = Members();
+    auto  it  = obj.find(*key);
+    return it == obj.end() ? nullptr : &it->second;
+} /*}}}*/
+
+inline Value* Value::Find(ShapeKey const& key) const /*{{{*/
+{
+    if (IsShapedObject()) {
+        auto& shaped = *std::get<ShapedObjectUPtr>(data_);
+        if (key.shape_ != shaped.shape.get()) {
+            key.shape_ = shaped.shape.get();
+            key.slot_  = shaped.shape->Find(key.key_);
+        }
+        return key.slot_ == Shape::npos ? nullptr : &shaped.values[key.slot_];
+    }
+    return Find(key.key_);
+} /*}}}*/
+
+inline void Value::SetInvalid(PARSE_ERROR parse_error) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = parse_error;
+    type_ = TYPE::INVALID;
+} /*}}}*/
+
+inline void Value::SetNull() /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = PARSE_ERROR::NO_ERROR;
+    type_ = TYPE::NUL;
+} /*}}}*/
+
+inline void Value::SetBool(bool tf) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = PARSE_ERROR::NO_ERROR;
+    type_ = tf ? TYPE::TRUE : TYPE::FALSE;
+} /*}}}*/
+
+inline void Value::SetNumber(double n) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = n;
+    type_ = TYPE::NUMBER;
+} /*}}}*/
+
+inline void Value::SetString(std::string&& s) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::move(s);
+    type_ = TYPE::STRING;
+} /*}}}*/
+
+inline void Value::SetArray(Array&& arr) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::make_unique<Array>(std::move(arr));
+    type_ = TYPE::ARRAY;
+} /*}}}*/
+
+inline void Value::SetArray(NumberArray&& arr) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::move(arr);
+    type_ = TYPE::ARRAY;
+} /*}}}*/
+
+inline void Value::SetObject(Object&& obj) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::make_unique<Object>(std::move(obj));
+    type_ = TYPE::OBJECT;
+} /*}}}*/
+
+inline void Value::SetObject(CompactObject&& obj) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::make_unique<CompactObject>(std::move(obj));
+    type_ = TYPE::OBJECT;
+} /*}}}*/
+
+inline void Value::SetObject(ShapedObject&& obj) /*{{{*/
+{
+    CheckNotFrozen();
+    data_ = std::make_unique<ShapedObject>(std::move(obj));
+    type_ = TYPE::OBJECT;
+} /*}}}*/
+
+inline void Value::SetRaw(std::string&& json, bool lazy) /*{{{*/
+{
+    CheckNotFrozen();
+    type_        = RawType(json);
+    data_        = RawJson{std::move(json)};
+    raw_checked_ = false;
+    if (!lazy)
+        CheckRaw();
+} /*}}}*/
+
+inline std::string Value::Stringify() const /*{{{*/
+{
+    TIJSON_STATS_SCOPE(STRINGIFY);
+    std::string result;
+    if (IsRaw()) {
+        CheckRaw();
+        result = std::get<RawJson>(data_).json;
+        TIJSON_STATS_BYTES(result.size());
+        return result;
+    }
+    switch (type_) {
+    case TYPE::NUL: TIJSON_STATS_ADD(nulls, 1), result = "null"; break;
+    case TYPE::TRUE: TIJSON_STATS_ADD(bools, 1), result = "true"; break;
+    case TYPE::FALSE: TIJSON_STATS_ADD(bools, 1), result = "false"; break;
+    case TYPE::NUMBER: TIJSON_STATS_ADD(numbers, 1), result = StringifyNumber(); break;
+    case TYPE::STRING: TIJSON_STATS_ADD(strings, 1), result = StringifyString(); break;
+    case TYPE::ARRAY:
+        TIJSON_STATS_ADD(arrays, 1), TIJSON_STATS_ENTER();
+        result = StringifyArray();
+        TIJSON_STATS_LEAVE();
+        break;
+    case TYPE::OBJECT:
+        TIJSON_STATS_ADD(objects, 1), TIJSON_STATS_ADD(keys, MemberCount());
+        TIJSON_STATS_ENTER();
+        result = StringifyObject();
+        TIJSON_STATS_LEAVE();
+        break;
+    case TYPE::INVALID: break;
+    }
+    TIJSON_STATS_BYTES(result.size());
+    return result;
+} /*}}}*/
+
+inline std::string Value::StringifyNumber() const /*{{{*/
+{
+    if (IsLazyNumber())
+        return std::get<std::string>(data_);
+    TIJSON_STATS_TIMER(number_ns);
+    TIJSON_STATS_ADD(numbers_converted, 1);
+    auto              fmt        = "%.17g";
+    double            number_raw = std::get<double>(data_);
+    auto              sz         = std::snprintf(nullptr, 0, fmt, number_raw);
+    std::vector<char> buf(sz + 1);
+    std::sprintf(&buf[0], fmt, number_raw);
+    std::string result(buf.begin(), buf.end() - 1);
+    return result;
+} /*}}}*/
+
+inline std::string Value::StringifyString() const /*{{{*/
+{
+    std::string result = "\"";
+    for (auto const& ch : std::get<std::string>(data_)) {
+        TIJSON_STATS_ADD(escapes, StatsIsEscape(ch));
+        switch (ch) {
+        case '\"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '/': result += "\\/"; break;
+        case '\b': result += "\\b"; break;
+        case '\f': result += "\\f"; break;
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            auto temp = static_cast<unsigned char>(ch);
+            if (temp < 0x20) {
+                auto        fmt = "\\u%04X";
+                auto        sz  = std::snprintf(nullptr, 0, fmt, temp);
+                std::string buf(sz + 1, '\0');
+                std::sprintf(&buf[0], fmt, temp);
+                buf.pop_back();
+                result += buf;
+            }
+            else
+                result += ch;
+        }
+    }
+    result += '\"';
+    return result;
+} /*}}}*/
+
+inline std::string Value::StringifyString(std::string_view str) const /*{{{*/
+{
+    std::string result = "\"";
+    for (auto const& ch : str) {
+        TIJSON_STATS_ADD(escapes, StatsIsEscape(ch));
+        switch (ch) {
+        case '\"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '/': result += "\\/"; break;
+        case '\b': result += "\\b"; break;
+        case '\f': result += "\\f"; break;
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            auto temp = static_cast<unsigned char>(ch);
+            if (temp < 0x20) {
+                auto        fmt = "\\u04X";
+                auto        sz  = std::snprintf(nullptr, 0, fmt, temp);
+                std::string buf(sz + 1, '\0');
+                std::sprintf(&buf[0], fmt, temp);
+                buf.pop_back();
+                result += buf;
+            }
+            else
+                result += ch;
+        }
+    }
+    result += '\"';
+    return result;
+} /*}}}*/
+
+inline std::string Value::StringifyArray() const /*{{{*/
+{
+    std::string result = "[ ";
+    int         i      = 0;
+    ForEachItem([&](Value const& item) {
+        if (i > 0)
+            result += ", ";
+        result += item.Stringify();
+        i++;
+    });
+    result += " ]";
+    return result;
+} /*}}}*/
+
+inline std::string Value::StringifyObject() const /*{{{*/
+{
+    std::string result = "{ ";
+    int         i      = 0;
+    ForEachMember([&](std::string_view key, Value const& val) {
+        if (i > 0)
+            result += ", ";
+        result += StringifyString(key) + ':' + val.Stringify();
+        i++;
+    });
+    result += " }";
+    return result;
+} /*}}}*/
+
+inline bool Value::operator==(bool rhs) const /*{{{*/
+{
+    // `if (Value == true) ` will use this, rather than Implicit transformation
+    return static_cast<bool>(*this) == rhs;
+} /*}}}*/
+
+inline bool Value::operator==(Value const& rhs) const /*{{{*/
+{
+    if (hash_ != 0 && rhs.hash_ != 0 && hash_ != rhs.hash_)
+        return false;
+    /* fragments of the same text are equal, others are compared as values */
+    if (IsRaw() && rhs.IsRaw() && GetRawJson() == rhs.GetRawJson())
+        return true;
+    if (IsRaw())
+        MaterializeRaw();
+    if (rhs.IsRaw())
+        rhs.MaterializeRaw();
+    if (type_ != rhs.type_)
+        return false;
+    if (type_ == TYPE::INVALID)
+        return std::get<PARSE_ERROR>(data_) == std::get<PARSE_ERROR>(rhs.data_);
+    if (type_ == TYPE::TRUE || type_ == TYPE::FALSE || type_ == TYPE::NUL)
+        return true;
+    if (type_ == TYPE::NUMBER) {
+        /* lazy numbers of the same text are equal without converting them */
+        if (IsLazyNumber() && rhs.IsLazyNumber() &&
+            std::get<std::string>(data_) == std::get<std::string>(rhs.data_))
+            return true;
+        return GetNumber() == rhs.GetNumber();
+    }
+    if (type_ == TYPE::STRING)
+        return std::get<std::string>(data_) == std::get<std::string>(rhs.data_);
+    if (type_ == TYPE::ARRAY) {
+        if (IsPackedArray() != rhs.IsPackedArray()) {
+            /* packed numbers against items */
+            auto const& numbers = std::get<NumberArray>(IsPackedArray() ? data_ : rhs.data_);
+            auto const& items   = *std::get<ArrayUPtr>(IsPackedArray() ? rhs.data_ : data_);
+            return std::equal(numbers.begin(), numbers.end(), items.begin(), items.end(),
+                              [](double number, Value const& item) {
+                                  return item.type_ == TYPE::NUMBER && item.GetNumber() == number;
+                              });
+        }
+        if (IsPackedArray())
+            return std::get<NumberArray>(data_) == std::get<NumberArray>(rhs.data_);
+        return *std::get<ArrayUPtr>(data_) == *std::get<ArrayUPtr>(rhs.data_);
+    }
+    if (std::holds_alternative<ObjectUPtr>(data_) && std::holds_alternative<ObjectUPtr>(rhs.data_))
+        return *std::get<ObjectUPtr>(data_) == *std::get<ObjectUPtr>(rhs.data_);
+    /* objects of one shape have their members in the same slots */
+    if (IsShapedObject() && rhs.IsShapedObject() &&
+        std::get<ShapedObjectUPtr>(data_)->shape == std::get<ShapedObjectUPtr>(rhs.data_)->shape)
+        return std::get<ShapedObjectUPtr>(data_)->values ==
+               std::get<ShapedObjectUPtr>(rhs.data_)->values;
+    if (MemberCount() != rhs.MemberCount())
+        return false;
+    bool equal = true;
+    ForEachMember([&](std::string_view key, Value const& member) {
+        auto other = equal ? rhs.Find(key) : nullptr;
+        equal      = other != nullptr && *other == member;
+    });
+    return equal;
+} /*}}}*/
+
+inline bool Value::operator!=(Value const& rhs) const /*{{{*/
+{
+    return !(this->operator==(rhs));
+} /*}}}*/
+
+inline MemoryReport Value::MemoryUsage() const /*{{{*/
+{
+    MemoryReport report;
+    MemoryUsage(report);
+    return report;
+} /*}}}*/
+
+inline void Value::StringMemoryUsage(std::string const& str, MemoryReport& report) /*{{{*/
+{
+    /* short strings live in the small string storage of std::string */
+    if (str.capacity() <= std::string().capacity())
+        return;
+    report.strings += str.size() + 1;
+    report.slack += str.capacity() - str.size();
+    report.allocations++;
+} /*}}}*/
+
+inline void Value::MemoryUsage(MemoryReport& report) const /*{{{*/
+{
+    if (IsRaw())
+        StringMemoryUsage(std::get<RawJson>(data_).json, report);
+    else if (type_ == TYPE::STRING || IsLazyNumber())
+        StringMemoryUsage(std::get<std::string>(data_), report);
+    else if (IsPackedArray()) {
+        /* the vector itself lives inside the Value */
+        auto const& numbers = std::get<NumberArray>(data_);
+        report.containers += numbers.size() * sizeof(double);
+        report.slack += (numbers.capacity() - numbers.size()) * sizeof(double);
+        report.allocations += numbers.capacity() > 0;
+    }
+    else if (type_ == TYPE::ARRAY) {
+        auto const& arr = *std::get<ArrayUPtr>(data_);
+        report.containers += sizeof(Array) + arr.size() * sizeof(Value);
+        report.slack += (arr.capacity() - arr.size()) * sizeof(Value);
+        report.allocations += 1 + (arr.capacity() > 0);
+        for (auto const& item : arr)
+            item.MemoryUsage(report);
+    }
+    else if (IsCompactObject()) {
+        /* keys are owned by the KeyTable, see KeyTable::MemoryUsage */
+        auto const& members = std::get<CompactObjectUPtr>(data_)->members;
+        report.containers += sizeof(CompactObject) + members.size() * sizeof(members[0]);
+        report.slack += (members.capacity() - members.size()) * sizeof(members[0]);
+        report.allocations += 1 + (members.capacity() > 0);
+        for (auto const& member : members)
+            member.second.MemoryUsage(report);
+    }
+    else if (IsShapedObject()) {
+        /* each object is charged its share of the Shape, so a tree holding every object of a
+           shape is charged the shape once */
+        auto const& shaped = *std::get<ShapedObjectUPtr>(data_);
+        auto const& values = shaped.values;
+        report.containers += sizeof(ShapedObject) + values.size() * sizeof(Value) +
+                             shaped.shape->MemoryUsage() / shaped.shape.use_count();
+        report.slack += (values.capacity() - values.size()) * sizeof(Value);
+        report.allocations += 1 + (values.capacity() > 0);
+        for (auto const& member : values)
+            member.MemoryUsage(report);
+    }
+    else if (type_ == TYPE::OBJECT) {
+        /* node layout of libstdc++ and libc++: next pointer, cached hash, then the member */
+        constexpr size_t node_bytes = sizeof(void*) + sizeof(size_t) + sizeof(Object::value_type);
+        auto const&      obj        = *std::get<ObjectUPtr>(data_);
+        report.containers += sizeof(Object);
+        report.map_nodes += obj.size() * node_bytes;
+        report.allocations += 1 + obj.size();
+        /* a single bucket is stored inside the map */
+        if (obj.bucket_count() > 1) {
+            report.map_buckets += obj.bucket_count() * sizeof(void*);
+            report.allocations++;
+        }
+        for (auto const& [key, member] : obj) {
+            StringMemoryUsage(key, report);
+            member.MemoryUsage(report);
+        }
+    }
+} /*}}}*/
+
+inline void Value::ShrinkToFit() /*{{{*/
+{
+    CheckNotFrozen();
+    if (IsRaw())
+        std::get<RawJson>(data_).json.shrink_to_fit();
+    else if (type_ == TYPE::STRING || IsLazyNumber())
+        std::get<std::string>(data_).shrink_to_fit();
+    else if (IsPackedArray())
+        std::get<NumberArray>(data_).shrink_to_fit();
+    else if (type_ == TYPE::ARRAY) {
+        auto& arr = *std::get<ArrayUPtr>(data_);
+        arr.shrink_to_fit();
+        for (auto& item : arr)
+            item.ShrinkToFit();
+    }
+    else if (IsCompactObject()) {
+        auto& members = std::get<CompactObjectUPtr>(data_)->members;
+        members.shrink_to_fit();
+        for (auto& member : members)
+            member.second.ShrinkToFit();
+    }
+    else if (IsShapedObject()) {
+        auto& values = std::get<ShapedObjectUPtr>(data_)->values;
+        values.shrink_to_fit();
+        for (auto& member : values)
+            member.ShrinkToFit();
+    }
+    else if (type_ == TYPE::OBJECT) {
+        auto& obj = *std::get<ObjectUPtr>(data_);
+        /* keys are const in place, extract the nodes with slack, shrink and reinsert them */
+        std::vector<Object::node_type> nodes;
+        for (auto it = obj.begin(); it != obj.end();) {
+            it->second.ShrinkToFit();
+            auto const& key = it->first;
+            if (key.capacity() > std::string().capacity() && key.capacity() > key.size())
+                nodes.push_back(obj.extract(it++));
+            else
+                ++it;
+        }
+        for (auto& node : nodes) {
+            node.key().shrink_to_fit();
+            obj.insert(std::move(node));
+        }
+        obj.rehash(0);
+    }
+} /*}}}*/
+
+inline Value::operator bool() const /*{{{*/
+{
+    return type_ == TYPE::INVALID ? false : true;
+} /*}}}*/
+
+inline Value& Value::operator[](size_t index) const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::ARRAY) {
+        auto& arr = Items();
+        if (index >= arr.size())
+            throw AccessException("ARRAY_INDEX_OUT_OF_RANGE");
+        return arr[index];
+    }
+    throw AccessException("VALUE_NOT_ARRAY");
+} /*}}}*/
+
+inline Value& Value::operator[](std::string const& key) const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::OBJECT) {
+        if (frozen_) {
+            if (auto member = Find(key))
+                return *member;
+            throw AccessException("OBJECT_KEY_NOT_FOUND");
+        }
+        /* the members of an Object stay where they are across inserts */
+        return GetObject()[key];
+    }
+    throw AccessException("VALUE_NOT_OBJECT");
+} /*}}}*/
+
+inline Value& Value::operator[](char const* key) const /*{{{*/
+{
+    if (IsRaw())
+        MaterializeRaw();
+    if (type_ == TYPE::OBJECT) {
+        if (frozen_) {
+            if (auto member = Find(key))
+                return *member;
+            throw AccessException("OBJECT_KEY_NOT_FOUND");
+        }
+        /* the members of an Object stay where they are across inserts */
+        return GetObject()[key];
+    }
+    throw AccessException("VALUE_NOT_OBJECT");
+} /*}}}*/
+
+inline void Value::Freeze() /*{{{*/
+{
+    (void)FreezeTree(false);
+} /*}}}*/
+
+inline uint64_t Value::FreezeTree(bool below) /*{{{*/
+{
+    if (below)
+        frozen_member_ = true;
+    /* a frozen value is not written again, readers may hold it already */
+    if (frozen_)
+        return HashValue();
+    if (IsRaw())
+        MaterializeRaw();
+    /* the hash is built on the way up, as HashValue would build it */
+    uint64_t h = 0;
+    if (type_ == TYPE::ARRAY) {
+        h = 'A';
+        for (auto& item : Items())
+            h = MixHash(h + item.FreezeTree(true));
+    }
+    else if (type_ == TYPE::OBJECT) {
+        for (auto& [key, member] : Members())
+            h += MixMember(key, member.FreezeTree(true));
+        h = MixHash(h ^ 'O');
+    }
+    else
+        h = HashValue();
+    frozen_ = true;
+    if (type_ == TYPE::ARRAY || type_ == TYPE::OBJECT)
+        hash_ = FoldHash(h);
+    return h;
+} /*}}}*/
+
+inline void Value::CheckNotFrozen() const /*{{{*/
+{
+    if (frozen_)
+        throw AccessException("VALUE_FROZEN");
+} /*}}}*/
+
+inline size_t Value::Hash() const /*{{{*/
+{
+    return static_cast<size_t>(HashValue());
+} /*}}}*/
+
+inline uint64_t Value::HashValue() const /*{{{*/
+{
+    /* writes nothing, a raw fragment is parsed aside and a lazy number converted aside */
+    if (IsRaw())
+        return Parser::Parse(std::get<RawJson>(data_).json).HashValue();
+    switch (type_) {
+    case TYPE::INVALID:
+        return MixHash(0x49 + static_cast<uint64_t>(std::get<PARSE_ERROR>(data_)));
+    case TYPE::NUL: return MixHash('n');
+    case TYPE::TRUE: return MixHash('T');
+    case TYPE::FALSE: return MixHash('F');
+    case TYPE::NUMBER:
+    {
+        double n = IsLazyNumber() ? std::strtod(std::get<std::string>(data_).c_str(), nullptr)
+                                  : std::get<double>(data_);
+        /* 0 and -0 are equal */
+        if (n == 0)
+            n = 0;
+        uint64_t bits = 0;
+        std::memcpy(&bits, &n, sizeof(bits));
+        return MixHash(bits ^ 'N');
+    }
+    case TYPE::STRING: return MixHash(std::hash<std::string>{}(std::get<std::string>(data_)));
+    case TYPE::ARRAY:
+    {
+        /* in order, packed numbers hash as the items they stand for */
+        uint64_t h = 'A';
+        ForEachItem([&h](Value const& item) { h = MixHash(h + item.HashValue()); });
+        return h;
+    }
+    case TYPE::OBJECT:
+    {
+        /* a sum of the members does not depend on their order */
+        uint64_t h = 0;
+        ForEachMember([&h](std::string_view key, Value const& member) {
+            h += MixMember(key, member.HashValue());
+        });
+        return MixHash(h ^ 'O');
+    }
+    }
+    return 0;
+} /*}}}*/
+
+inline uint64_t Value::MixHash(uint64_t h) /*{{{*/
+{
+    /* the splitmix64 finalizer */
+    h += 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+} /*}}}*/
+
+inline uint64_t Value::MixMember(std::string_view key, uint64_t member) /*{{{*/
+{
+    return MixHash(std::hash<std::string_view>{}(key) ^ (member << 1));
+} /*}}}*/
+
+inline uint32_t Value::FoldHash(uint64_t h) /*{{{*/
+{
+    /* 0 marks a hash not stored */
+    auto folded = static_cast<uint32_t>(h ^ (h >> 32));
+    return folded != 0 ? folded : 1;
+} /*}}}*/
+
+/* NOTE: SHARED DOCUMENT IMPLEMENTATION */
+inline std::shared_ptr<Value const> SharedDocument::Load() const /*{{{*/
+{
+    return std::atomic_load(&current_);
+} /*}}}*/
+
+inline std::shared_ptr<Value const> SharedDocument::Store(Value value) /*{{{*/
+{
+    value.Freeze();
+    std::shared_ptr<Value const> next = std::make_shared<Value>(std::move(value));
+    return std::atomic_exchange(&current_, std::move(next));
+} /*}}}*/
+
+/* NOTE: QUERY IMPLEMENTATION */
+inline Value::TYPE QueryMatch::GetType() const /*{{{*/
+{
+    switch (text_.empty() ? '\0' : text_[0]) {
+    case 'n': return Value::TYPE::NUL;
+    case 't': return Value::TYPE::TRUE;
+    case 'f': return Value::TYPE::FALSE;
+    case '\"': return Value::TYPE::STRING;
+    case '[': return Value::TYPE::ARRAY;
+    case '{': return Value::TYPE::OBJECT;
+    case '\0': return Value::TYPE::INVALID;
+    default: return Value::TYPE::NUMBER;
+    }
+} /*}}}*/
+
+inline bool QueryMatch::GetBool() const /*{{{*/
+{
+    if (GetType() == Value::TYPE::TRUE || GetType() == Value::TYPE::FALSE)
+        return GetType() == Value::TYPE::TRUE;
+    throw AccessException("VALUE_NOT_BOOL");
+} /*}}}*/
+
+inline double QueryMatch::GetNumber() const /*{{{*/
+{
+    if (GetType() != Value::TYPE::NUMBER)
+        throw AccessException("VALUE_NOT_NUMBER");
+    /* the parser may look one past the end of its content, so parse a terminated copy */
+    return Parser::Parse(std::string(text_)).GetNumber();
+} /*}}}*/
+
+inline std::string QueryMatch::GetString() const /*{{{*/
+{
+    if (GetType() != Value::TYPE::STRING)
+        throw AccessException("VALUE_NOT_STRING");
+    if (text_.find('\\') == std::string_view::npos)
+        return std::string(GetRawString());
+    return Parser::Parse(std::string(text_)).GetString();
+} /*}}}*/
+
+inline std::string_view QueryMatch::GetRawString() const /*{{{*/
+{
+    if (GetType() != Value::TYPE::STRING)
+        throw AccessException("VALUE_NOT_STRING");
+    return text_.substr(1, text_.size() - 2);
+} /*}}}*/
+
+inline Value QueryMatch::ToValue() const /*{{{*/
+{
+    return Parser::Parse(std::string(text_));
+} /*}}}*/
+
+inline Query Query::Compile(std::string_view expr) /*{{{*/
+{
+    Query query;
+    if (expr.empty() || expr[0] == '/') {
+        while (!expr.empty()) {
+            expr.remove_prefix(1);
+            auto        end = std::min(expr.find('/'), expr.size());
+            std::string segment;
+            /* unescape ~1 to '/' and ~0 to '~' */
+            for (size_t i = 0; i < end; i++) {
+                if (expr[i] == '~' && i + 1 < end && (expr[i + 1] == '0' || expr[i + 1] == '1'))
+                    segment += expr[++i] == '0' ? '~' : '/';
+                else
+                    segment += expr[i];
+            }
+            expr.remove_prefix(end);
+            query.AddPointerSegment(std::move(segment));
+        }
+        return query;
+    }
+    if (expr[0] != '$')
+        throw std::invalid_argument("query must be a JSON Pointer or start with '$'");
+
+    auto invalid = [] { return std::invalid_argument("invalid JSONPath"); };
+    size_t i     = 1;
+    while (i < expr.size()) {
+        Step step;
+        if (expr[i] == '.') {
+            size_t begin = ++i;
+            while (i < expr.size() && expr[i] != '.' && expr[i] != '[')
+                i++;
+            if (begin == i)
+                throw invalid();
+            if (expr.substr(begin, i - begin) == "*")
+                step.kind = Step::KIND::ANY;
+            else
+                step.kind = Step::KIND::KEY, step.key = expr.substr(begin, i - begin);
+        }
+        else if (expr[i] == '[') {
+            auto close = expr.find(']', i);
+            if (close == std::string_view::npos)
+                throw invalid();
+            auto inner = expr.substr(i + 1, close - i - 1);
+            if (inner == "*")
+                step.kind = Step::KIND::ANY;
+            else if (inner.size() >= 2 && (inner[0] == '\'' || inner[0] == '\"') &&
+                     inner.back() == inner[0])
+                step.kind = Step::KIND::KEY, step.key = inner.substr(1, inner.size() - 2);
+            else if (IsDecimal(inner)) {
+                step.kind  = Step::KIND::INDEX;
+                step.index = std::strtoull(std::string(inner).c_str(), nullptr, 10);
+            }
+            else
+                throw invalid();
+            i = close + 1;
+        }
+        else
+            throw invalid();
+        query.wildcard_ |= step.kind == Step::KIND::ANY;
+        query.steps_.push_back(std::move(step));
+    }
+    return query;
+} /*}}}*/
+
+inline bool Query::IsDecimal(std::string_view str) /*{{{*/
+{
+    return !str.empty() && str.size() < 20 &&
+           std::all_of(str.begin(), str.end(), [](char ch) { return '0' <= ch && ch <= '9'; });
+} /*}}}*/
+
+inline void Query::AddPointerSegment(std::string segment) /*{{{*/
+{
+    Step step;
+    step.kind = Step::KIND::KEY_OR_INDEX;
+    /* array indexes are decimal without leading zeros, other segments only match keys */
+    bool is_index = IsDecimal(segment) && (segment == "0" || segment[0] != '0');
+    if (is_index)
+        step.index = std::strtoull(segment.c_str(), nullptr, 10);
+    else
+        step.kind = Step::KIND::KEY;
+    step.key = std::move(segment);
+    steps_.push_back(std::move(step));
+} /*}}}*/
+
+inline std::vector<QueryMatch> Query::Evaluate(std::string_view content) const /*{{{*/
+{
+    std::vector<QueryMatch> result;
+    auto                    on_match = [&](std::string_view text) {
+        result.emplace_back(text);
+        return !wildcard_;
+    };
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    if (!parser.ParseQuery(steps_, 0, on_match)) {
+        parser.ParseWhitespace();
+        if (parser.cur_ != parser.end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+    }
+    return result;
+} /*}}}*/
+
+inline std::optional<QueryMatch> Query::First(std::string_view content) const /*{{{*/
+{
+    std::optional<QueryMatch> result;
+    auto                      on_match = [&](std::string_view text) {
+        result.emplace(text);
+        return true;
+    };
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    if (!parser.ParseQuery(steps_, 0, on_match)) {
+        parser.ParseWhitespace();
+        if (parser.cur_ != parser.end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+    }
+    return result;
+} /*}}}*/
+
+/* NOTE: PROJECTION IMPLEMENTATION */
+inline Projection::Projection(std::initializer_list<std::string_view> paths) /*{{{*/
+    : nodes_(1)
+{
+    for (auto path : paths)
+        AddPath(path);
+} /*}}}*/
+
+inline void Projection::AddPath(std::string_view path) /*{{{*/
+{
+    if (!path.empty() && path[0] != '/')
+        throw std::invalid_argument("projection path must start with '/'");
+    size_t node = kRoot;
+    while (!path.empty() && !nodes_[node].leaf) {
+        path.remove_prefix(1);
+        auto        end = std::min(path.find('/'), path.size());
+        std::string segment;
+        /* unescape ~1 to '/' and ~0 to '~' */
+        for (size_t i = 0; i < end; i++) {
+            if (path[i] == '~' && i + 1 < end && (path[i + 1] == '0' || path[i + 1] == '1'))
+                segment += path[++i] == '0' ? '~' : '/';
+            else
+                segment += path[i];
+        }
+        path.remove_prefix(end);
+
+        size_t next = 0;
+        if (segment == "*") {
+            if (nodes_[node].wildcard == 0)
+                nodes_[node].wildcard = nodes_.size(), nodes_.emplace_back();
+            next = nodes_[node].wildcard;
+        }
+        else {
+            for (auto const& [key, child] : nodes_[node].children)
+                if (key == segment)
+                    next = child;
+            if (next == 0) {
+                next = nodes_.size();
+                nodes_[node].children.emplace_back(std::move(segment), next);
+                nodes_.emplace_back();
+            }
+        }
+        node = next;
+    }
+    /* a path selects everything below it, longer paths under it are redundant */
+    nodes_[node].leaf = true;
+    nodes_[node].children.clear();
+    nodes_[node].wildcard = 0;
+} /*}}}*/
+
+inline size_t Projection::Find(size_t node, std::string_view key) const /*{{{*/
+{
+    for (auto const& [segment, child] : nodes_[node].children)
+        if (segment == key)
+            return child;
+    return nodes_[node].wildcard;
+} /*}}}*/
+
+inline size_t Projection::FindIndex(size_t node, size_t index) const /*{{{*/
+{
+    if (!nodes_[node].children.empty()) {
+        char buf[24];
+        auto sz = std::snprintf(buf, sizeof(buf), "%zu", index);
+        return Find(node, {buf, static_cast<size_t>(sz)});
+    }
+    return nodes_[node].wildcard;
+} /*}}}*/
+
+/* NOTE: PARSER IMPLEMENTATION */
+inline Value Parser::Parse(std::string_view content) /*{{{*/
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    return Parser(content.begin(), content.end()).Parse();
+} /*}}}*/
+
+inline Value Parser::Parse(std::string_view content, std::shared_ptr<KeyTable> const& keys) /*{{{*/
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    Parser parser(content.begin(), content.end());
+    parser.keys_ = keys;
+    return parser.Parse();
+} /*}}}*/
+
+inline Value Parser::Parse(std::string_view content, ParseOptions const& options) /*{{{*/
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    if (options.strict_utf8)
+        CheckUtf8(content);
+    Parser parser(content.begin(), content.end());
+    parser.options_ = options;
+    return parser.Parse();
+} /*}}}*/
+
+inline Value Parser::Parse(std::string_view content, Projection const& projection) /*{{{*/
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    Value result;
+    parser.ParseProjected(result, projection, Projection::kRoot);
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+    return result;
+} /*}}}*/
+
+inline void Parser::ParseWhitespace() /*{{{*/
+{
+    while (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\n' || *cur_ == '\r')
+        cur_++;
+} /*}}}*/
+
+template<char lower, char upper> /*{{{*/
+inline bool Parser::IsDigital(char ch)
+{
+    /* parse number helper */
+    return ch >= lower && ch <= upper;
+} /*}}}*/
+
+inline bool Parser::IsInvalidChar(char ch) /*{{{*/
+{
+    /* parse number helper */
+    // unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
+    // '\x22' is '\"' , '\x5C' is '\\' , they will be deal, so the invalid char is less than
+    // '\x20' unsigned char : range[0,255], signed char : range[-127,127]
+    // When calulate char with number should static_cast
+    // Because char could be unsigned or signed in different compiler
+    return static_cast<unsigned char>(ch) < '\x20';
+} /*}}}*/
+
+inline char16_t Parser::ParseStringHex4() /*{{{*/
+{
+    /* parse unicode helper */
+    char16_t surrogate = 0;
+    for (int i = 0; i < 4; i++) {
+        surrogate <<= 4;
+        if ('0' <= *cur_ && *cur_ <= '9')
+            surrogate |= *cur_ - '0';
+        else if ('a' <= *cur_ && *cur_ <= 'f')
+            surrogate |= *cur_ - ('a' - 10);
+        else if ('A' <= *cur_ && *cur_ <= 'F')
+            surrogate |= *cur_ - ('A' - 10);
+        else
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_HEX>();
+        ++cur_;
+    }
+    return surrogate;
+} /*}}}*/
+
+inline void Parser::ParseStringUtf8(std::string& s) /*{{{*/
+{
+    /* append the utf-8 bytes of the code point, a surrogate is only valid as a pair */
+    char32_t code = ParseStringHex4();
+    if (0xDC00 <= code && code <= 0xDFFF)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+    if (0xD800 <= code && code <= 0xDBFF) {
+        if (cur_[0] != '\\' || cur_[1] != 'u')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+        cur_ += 2;
+        char16_t surrogate_l = ParseStringHex4();
+        if (surrogate_l < 0xDC00 || 0xDFFF < surrogate_l)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+        code = 0x10000 + ((code - 0xD800) << 10) + (surrogate_l - 0xDC00);
+    }
+    if (code < 0x80)
+        s += static_cast<char>(code);
+    else if (code < 0x800) {
+        s += static_cast<char>(0xC0 | code >> 6);
+        s += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        s += static_cast<char>(0xE0 | code >> 12);
+        s += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+        s += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else {
+        s += static_cast<char>(0xF0 | code >> 18);
+        s += static_cast<char>(0x80 | (code >> 12 & 0x3F));
+        s += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+        s += static_cast<char>(0x80 | (code & 0x3F));
+    }
+} /*}}}*/
+
+inline Value Parser::Parse() /*{{{*/
+{
+    ParseWhitespace();
+    if (cur_ == end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    Value result;
+    if (options_.raw)
+        ParseKeepRaw(result, Projection::kRoot);
+    else if (options_.share_shapes)
+        ParseShaped(result, nullptr);
+    else
+        result = ParseValue();
+    ParseWhitespace();
+    if (cur_ != end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+    return result;
+} /*}}}*/
+
+inline Value Parser::ParseValue() /*{{{*/
+{
+    Value result;
+    switch (*cur_) {
+    case 'n': ++cur_, ParseNull(result); break;
+    case 't': ++cur_, ParseTrue(result); break;
+    case 'f': ++cur_, ParseFalse(result); break;
+    case '\"': ++cur_, ParseString(result); break;
+    case '[': ++cur_, ParseArray(result); break;
+    case '{': ++cur_, ParseObject(result); break;
+    default: ParseNumber(result);
+    }
+    return result;
+} /*}}}*/
+
+inline void Parser::ParseNull(Value& val) /*{{{*/
+{
+    if (cur_[0] == 'u' && cur_[1] == 'l' && cur_[2] == 'l') {
+        cur_ += 3;
+        val.SetNull();
+        TIJSON_STATS_ADD(nulls, 1);
+        return;
+    }
+    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+} /*}}}*/
+
+inline void Parser::ParseTrue(Value& val) /*{{{*/
+{
+    if (cur_[0] == 'r' && cur_[1] == 'u' && cur_[2] == 'e') {
+        cur_ += 3;
+        val.SetBool(true);
+        TIJSON_STATS_ADD(bools, 1);
+        return;
+    }
+    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+} /*}}}*/
+
+inline void Parser::ParseFalse(Value& val) /*{{{*/
+{
+    if (cur_[0] == 'a' && cur_[1] == 'l' && cur_[2] == 's' && cur_[3] == 'e') {
+        cur_ += 4;
+        val.SetBool(false);
+        TIJSON_STATS_ADD(bools, 1);
+        return;
+    }
+    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+} /*}}}*/
+
+inline void Parser::ParseNumber(Value& val) /*{{{*/
+{
+    TIJSON_STATS_ADD(numbers, 1);
+    if (!options_.lazy_numbers) {
+        val.SetNumber(ParseNumber());
+        return;
+    }
+    /* keep the text, only a number that may be out of range is converted now to check it */
+    auto number_begin = cur_;
+    if (SkipNumber()) {
+        cur_ = number_begin;
+        ParseNumber();
+    }
+    val.data_ = std::string(number_begin, cur_);
+    val.type_ = Value::TYPE::NUMBER;
+} /*}}}*/
+
+inline double Parser::ParseNumber() /*{{{*/
+{
+    TIJSON_STATS_TIMER(number_ns);
+    TIJSON_STATS_ADD(numbers_converted, 1);
+    auto number_begin = cur_;
+    SkipNumber();
+    if (number_begin == cur_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+    // Abort: stod() If the converted value would fall out of the range, will throw an out_of_range
+    // exception And std::stod() will throw out_of_range exception when converts subnormal value
+    // https://stackoverflow.com/questions/48086830/stdstod-throws-out-of-range-error-for-a-string-that-should-be-valid
+    //
+    // double n;
+    // try {
+    //     n = std::strtod(cur);
+    // }
+    // catch (std::out_of_range e) {
+    //     throw std::invalid_argument("NUMBER_TOO_BIG");
+    // }
+    /* strtod needs a terminated copy, numbers of usual length are copied to the stack */
+    char   buf[64];
+    auto   len = static_cast<size_t>(cur_ - number_begin);
+    double n   = 0;
+    if (len < sizeof(buf)) {
+        std::memcpy(buf, &*number_begin, len);
+        buf[len] = '\0';
+        n        = std::strtod(buf, nullptr);
+    }
+    else
+        n = std::strtod(std::string(number_begin, cur_).c_str(), nullptr);
+    if (n == HUGE_VAL || n == -HUGE_VAL)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::NUMBER_TOO_BIG>();
+    return n;
+} /*}}}*/
+
+inline bool Parser::SkipNumber() /*{{{*/
+{
+    auto number_begin = cur_;
+    if (*cur_ == '-')
+        ++cur_;
+    if (*cur_ == '0')
+        ++cur_;
+    else if (IsDigital<'1', '9'>(*cur_)) {
+        ++cur_;
+        while (IsDigital<'0', '9'>(*cur_))
+            ++cur_;
+    }
+    else
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+    /* only an exponent or a long integer part can leave the range of double */
+    bool may_overflow = cur_ - number_begin > std::numeric_limits<double>::max_exponent10;
+    if (*cur_ == '.') {
+        ++cur_;
+        if (!IsDigital<'0', '9'>(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        while (IsDigital<'0', '9'>(*cur_))
+            cur_++;
+    }
+    if (*cur_ == 'e' || *cur_ == 'E') {
+        may_overflow = true;
+        ++cur_;
+        if (*cur_ == '+' || *cur_ == '-')
+            ++cur_;
+        if (!IsDigital<'0', '9'>(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        while (IsDigital<'0', '9'>(*cur_))
+            ++cur_;
+    }
+    return may_overflow;
+} /*}}}*/
+
+inline std::string Parser::ParseString() /*{{{*/
+{
+    std::string s;
+    ParseString(s);
+    return s;
+} /*}}}*/
+
+inline void Parser::ParseString(std::string& s) /*{{{*/
+{
+    TIJSON_STATS_TIMER(string_ns);
+    while (true) {
+        if (cur_ != end_) {
+            /* runs without escapes are appended at once */
+            size_t plain = ScanPlain(&*cur_, static_cast<size_t>(end_ - cur_));
+            s.append(&*cur_, plain);
+            cur_ += static_cast<std::ptrdiff_t>(plain);
+        }
+        if (cur_ == end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
+        /* deal with invalid char */
+        if (IsInvalidChar(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
+        if (*cur_ == '\"') {
+            ++cur_;
+            break;
+        }
+        /* deal with escape */
+        if (*cur_ == '\\') {
+            if (++cur_ == end_)
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            TIJSON_STATS_ADD(escapes, 1);
+            switch (*cur_++) {
+            case '\"': s.push_back('\"'); break;
+            case '\\': s.push_back('\\'); break;
+            case '/': s.push_back('/'); break;
+            case 'b': s.push_back('\b'); break;
+            case 'f': s.push_back('\f'); break;
+            case 'n': s.push_back('\n'); break;
+            case 'r': s.push_back('\r'); break;
+            case 't': s.push_back('\t'); break;
+            case 'u': ParseStringUtf8(s); break;
+            default:
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            }
+            continue;
+        }
+        /* deal with unescape char */
+        s.push_back(*cur_++);
+    }
+} /*}}}*/
+
+inline void Parser::ParseString(Value& val) /*{{{*/
+{
+    TIJSON_STATS_TIMER(string_ns);
+    std::string s;
+    while (true) {
+        if (cur_ == end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
+        // deal with invalid char
+        if (IsInvalidChar(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
+        if (*cur_ == '\"') {
+            ++cur_;
+            break;
+        }
+        /* deal with escape */
+        if (*cur_ == '\\') {
+            if (++cur_ == end_)
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            TIJSON_STATS_ADD(escapes, 1);
+            switch (*cur_++) {
+            case '\"': s.push_back('\"'); break;
+            case '\\': s.push_back('\\'); break;
+            case '/': s.push_back('/'); break;
+            case 'b': s.push_back('\b'); break;
+            case 'f': s.push_back('\f'); break;
+            case 'n': s.push_back('\n'); break;
+            case 'r': s.push_back('\r'); break;
+            case 't': s.push_back('\t'); break;
+            case 'u': ParseStringUtf8(s); break;
+            default:
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            }
+            continue;
+        }
+        /* deal with unescape char */
+        s.push_back(*cur_++);
+    }
+    TIJSON_STATS_ADD(strings, 1);
+    TIJSON_STATS_STRING(s);
+    val.SetString(std::move(s));
+    return;
+} /*}}}*/
+
+inline void Parser::ParseArray(Value& val) /*{{{*/
+{
+    std::vector<Value> result;
+    NumberArray        numbers;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != ']') {
+        while (true) {
+            if (!ParsePackedItem(numbers, result))
+                result.emplace_back(ParseValue());
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == ']')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(arrays, 1);
+    if (!numbers.empty()) {
+        TIJSON_STATS_ALLOCATION(1, numbers.capacity() * sizeof(double));
+        val.SetArray(std::move(numbers));
+        return;
+    }
+    TIJSON_STATS_ALLOCATION(1 + (result.capacity() > 0),
+                            sizeof(Array) + result.capacity() * sizeof(Value));
+    val.SetArray(std::move(result));
+    return;
+} /*}}}*/
+
+inline bool Parser::ParsePackedItem(NumberArray& numbers, Array& items) /*{{{*/
+{
+    /* lazy numbers are written back as their text, packing would convert them */
+    if (!options_.pack_numbers || options_.lazy_numbers || !items.empty())
+        return false;
+    if (*cur_ == '-' || IsDigital<'0', '9'>(*cur_)) {
+        numbers.push_back(ParseNumber());
+        TIJSON_STATS_ADD(numbers, 1);
+        return true;
+    }
+    /* the first item that is not a number, the numbers before it become items */
+    items.reserve(numbers.size() + 1);
+    items.assign(numbers.begin(), numbers.end());
+    numbers.clear();
+    return false;
+} /*}}}*/
+
+inline void Parser::ParseObject(Value& val) /*{{{*/
+{
+    if (keys_) {
+        ParseCompactObject(val);
+        return;
+    }
+    std::unordered_map<std::string, Value> result;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            std::string key = ParseString();
+            TIJSON_STATS_ADD(keys, 1);
+            TIJSON_STATS_STRING(key);
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            Value val              = ParseValue();
+            result[std::move(key)] = std::move(val);
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(objects, 1);
+    /* the object itself, its bucket array and one node per member */
+    TIJSON_STATS_ALLOCATION(2 + result.size(),
+                            sizeof(Object) + result.bucket_count() * sizeof(void*) +
+                                result.size() * (sizeof(Object::value_type) + 2 * sizeof(void*)));
+    val.SetObject(std::move(result));
+    return;
+} /*}}}*/
+
+inline void Parser::ParseCompactObject(Value& val) /*{{{*/
+{
+    CompactObject result{keys_, {}};
+    auto&         members = result.members;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            auto key = keys_->Intern(ParseStringView());
+            TIJSON_STATS_ADD(keys, 1);
+            TIJSON_STATS_STRING(*key);
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            Value member = ParseValue();
+            /* interned keys are equal exactly when their addresses are, later duplicates win */
+            auto it = members.end();
+            if (members.size() <= kMaxCompactMembers)
+                it = std::find_if(members.begin(), members.end(),
+                                  [key](auto const& m) { return m.first == key; });
+            if (it != members.end())
+                it->second = std::move(member);
+            else
+                members.emplace_back(key, std::move(member));
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(objects, 1);
+    /* the object itself and its member array */
+    TIJSON_STATS_ALLOCATION(1 + (members.capacity() > 0),
+                            sizeof(CompactObject) + members.capacity() * sizeof(members[0]));
+    val.SetObject(std::move(result));
+    if (val.MemberCount() > kMaxCompactMembers)
+        (void)val.GetObject();
+    return;
+} /*}}}*/
+
+inline void Parser::ParseShaped(Value& val, Value const* prev) /*{{{*/
+{
+    switch (*cur_) {
+    case '[': ++cur_, ParseShapedArray(val, prev); break;
+    case '{': ++cur_, ParseShapedObject(val, prev); break;
+    default: val = ParseValue();
+    }
+} /*}}}*/
+
+inline void Parser::ParseShapedArray(Value& val, Value const* prev) /*{{{*/
+{
+    /* the first item follows the first item of the previous sibling array */
+    Value const* first = nullptr;
+    if (prev != nullptr && prev->GetType() == Value::TYPE::ARRAY && !prev->IsPackedArray() &&
+        !prev->GetArray().empty())
+        first = &prev->GetArray().front();
+    std::vector<Value> result;
+    NumberArray        numbers;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != ']') {
+        while (true) {
+            if (!ParsePackedItem(numbers, result)) {
+                auto& item = result.emplace_back();
+                ParseShaped(item, result.size() > 1 ? &result[result.size() - 2] : first);
+            }
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == ']')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(arrays, 1);
+    if (!numbers.empty()) {
+        TIJSON_STATS_ALLOCATION(1, numbers.capacity() * sizeof(double));
+        val.SetArray(std::move(numbers));
+        return;
+    }
+    TIJSON_STATS_ALLOCATION(1 + (result.capacity() > 0),
+                            sizeof(Array) + result.capacity() * sizeof(Value));
+    val.SetArray(std::move(result));
+    return;
+} /*}}}*/
+
+inline void Parser::ParseShapedObject(Value& val, Value const* prev) /*{{{*/
+{
+    ShapedObject const* hint = nullptr;
+    if (prev != nullptr && prev->IsShapedObject())
+        hint = std::get<Value::ShapedObjectUPtr>(prev->data_).get();
+    std::shared_ptr<Shape const> shape = hint ? hint->shape : nullptr;
+    std::shared_ptr<Shape>       built;   // set once the keys differ from shape
+    std::vector<Value>           values;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            auto   key  = ParseStringView();
+            size_t slot = values.size();
+            TIJSON_STATS_ADD(keys, 1);
+            if (built || !shape || slot >= shape->size() || shape->Key(slot) != key) {
+                if (!built) {
+                    /* a new shape, starting with the keys matched so far */
+                    built = std::make_shared<Shape>();
+                    for (size_t i = 0; i < values.size(); i++)
+                        built->Add(shape->Key(i));
+                }
+                slot = built->Add(key);
+            }
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            Value member;
+            if (!built && hint != nullptr)
+                ParseShaped(member, &hint->values[slot]);
+            else
+                ParseShaped(member, values.empty() ? nullptr : &values.back());
+            /* later duplicates win */
+            if (slot < values.size())
+                values[slot] = std::move(member);
+            else
+                values.emplace_back(std::move(member));
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(objects, 1);
+    if (!built && (!shape || values.size() != shape->size())) {
+        /* the first object of its kind, or a prefix of the previous keys */
+        built = std::make_shared<Shape>();
+        for (size_t i = 0; i < values.size(); i++)
+            built->Add(shape->Key(i));
+    }
+    if (built) {
+        TIJSON_STATS_ALLOCATION(1, built->MemoryUsage());
+        shape = std::move(built);
+    }
+    /* the object itself and its value array */
+    TIJSON_STATS_ALLOCATION(1 + (values.capacity() > 0),
+                            sizeof(ShapedObject) + values.capacity() * sizeof(Value));
+    val.SetObject(ShapedObject{std::move(shape), std::move(values)});
+    return;
+} /*}}}*/
+
+inline std::string_view Parser::ParseStringView() /*{{{*/
+{
+    /* strings without escape are returned as a view into content, nothing is allocated */
+    auto str_begin = cur_;
+    while (cur_ != end_ && *cur_ != '\"' && *cur_ != '\\' && !IsInvalidChar(*cur_))
+        ++cur_;
+    if (cur_ != end_ && *cur_ == '\"') {
+        ++cur_;
+        return {&*str_begin, static_cast<size_t>(cur_ - str_begin - 1)};
+    }
+    cur_ = str_begin;
+    str_buffer_.clear();
+    ParseString(str_buffer_);
+    return str_buffer_;
+} /*}}}*/
+
+inline void Parser::ParseProjected(Value& val, Projection const& projection, size_t node) /*{{{*/
+{
+    if (projection[node].leaf || (*cur_ != '[' && *cur_ != '{')) {
+        val = ParseValue();
+        return;
+    }
+    if (*cur_ == '[') {
+        ++cur_;
+        Array  result;
+        size_t index = 0;
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                size_t child = projection.FindIndex(node, index++);
+                if (child != 0)
+                    ParseProjected(result.emplace_back(), projection, child);
+                else
+                    SkipValue();
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        val.SetArray(std::move(result));
+        return;
+    }
+    ++cur_;
+    Object result;
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            auto   key   = ParseStringView();
+            size_t child = projection.Find(node, key);
+            /* the key is copied before the member is parsed, which may reuse str_buffer_ */
+            Value* member = child != 0 ? &result[std::string(key)] : nullptr;
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            if (member != nullptr)
+                ParseProjected(*member, projection, child);
+            else
+                SkipValue();
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    val.SetObject(std::move(result));
+} /*}}}*/
+
+inline void Parser::ParseKeepRaw(Value& val, size_t node) /*{{{*/
+{
+    auto const& raw = *options_.raw;
+    if (!raw[node].leaf && *cur_ != '[' && *cur_ != '{') {
+        val = ParseValue();
+        return;
+    }
+    if (raw[node].leaf) {
+        auto value_begin = cur_;
+        SkipValue();
+        val.data_        = Value::RawJson{std::string(value_begin, cur_)};
+        val.type_        = Value::RawType(std::get<Value::RawJson>(val.data_).json);
+        val.raw_checked_ = true;
+        return;
+    }
+    if (*cur_ == '[') {
+        ++cur_;
+        Array  result;
+        size_t index = 0;
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                size_t child = raw.FindIndex(node, index++);
+                if (child != 0)
+                    ParseKeepRaw(result.emplace_back(), child);
+                else
+                    result.push_back(ParseValue());
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        val.SetArray(std::move(result));
+        return;
+    }
+    ++cur_;
+    Object result;
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            auto   key   = ParseStringView();
+            size_t child = raw.Find(node, key);
+            /* the key is copied before the member is parsed, which may reuse str_buffer_ */
+            Value& member = result[std::string(key)];
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            if (child != 0)
+                ParseKeepRaw(member, child);
+            else
+                member = ParseValue();
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    val.SetObject(std::move(result));
+} /*}}}*/
+
+inline void Parser::ParseReuse(Value& val, ReusableParser& reuse) /*{{{*/
+{
+    /* the values under a frozen one are not reused, readers may still hold them */
+    if (val.frozen_)
+        val = Value();
+    switch (*cur_) {
+    case 'n': ++cur_, ParseNull(val); break;
+    case 't': ++cur_, ParseTrue(val); break;
+    case 'f': ++cur_, ParseFalse(val); break;
+    case '\"': ++cur_, ParseReuseString(val); break;
+    case '[': ++cur_, ParseReuseArray(val, reuse); break;
+    case '{': ++cur_, ParseReuseObject(val, reuse); break;
+    default: ParseNumber(val);
+    }
+} /*}}}*/
+
+inline void Parser::ParseReuseString(Value& val) /*{{{*/
+{
+    /* a string, lazy number or raw fragment before lends its buffer */
+    if (!std::holds_alternative<std::string>(val.data_))
+        val.data_ = std::string();
+    auto& s = std::get<std::string>(val.data_);
+    s.clear();
+    ParseString(s);
+    val.type_ = Value::TYPE::STRING;
+    TIJSON_STATS_ADD(strings, 1);
+} /*}}}*/
+
+inline void Parser::ParseReuseArray(Value& val, ReusableParser& reuse) /*{{{*/
+{
+    auto* held = std::get_if<Value::ArrayUPtr>(&val.data_);
+    if (held == nullptr || *held == nullptr) {
+        val.SetArray(Array());
+        held = std::get_if<Value::ArrayUPtr>(&val.data_);
+    }
+    val.type_    = Value::TYPE::ARRAY;
+    auto&  items = **held;
+    size_t count = 0;
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != ']') {
+        while (true) {
+            /* the item in the same place of the previous document, or else a spare */
+            if (count == items.size()) {
+                if (reuse.values_.empty())
+                    items.emplace_back();
+                else {
+                    items.push_back(std::move(reuse.values_.back()));
+                    reuse.values_.pop_back();
+                }
+            }
+            ParseReuse(items[count++], reuse);
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == ']')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(arrays, 1);
+    for (; items.size() > count; items.pop_back())
+        reuse.values_.push_back(std::move(items.back()));
+} /*}}}*/
+
+inline void Parser::ParseReuseObject(Value& val, ReusableParser& reuse) /*{{{*/
+{
+    auto* held = std::get_if<Value::ObjectUPtr>(&val.data_);
+    if (held == nullptr || *held == nullptr) {
+        val.SetObject(Object());
+        held = std::get_if<Value::ObjectUPtr>(&val.data_);
+    }
+    val.type_    = Value::TYPE::OBJECT;
+    auto& result = **held;
+    auto& spares = reuse.members_;
+    /* the members of the previous document are taken out, the buckets stay */
+    size_t base = spares.size();
+    while (!result.empty())
+        spares.push_back(result.extract(result.begin()));
+    TIJSON_STATS_ENTER();
+    ParseWhitespace();
+    if (*cur_ != '}') {
+        while (true) {
+            if (*cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur_;
+            std::string_view key = ParseStringView();
+            TIJSON_STATS_ADD(keys, 1);
+            /* the member with this key in the previous document, or else any spare */
+            auto it = spares.end();
+            if (base <= spares.size() && spares.size() - base <= kMaxCompactMembers)
+                it = std::find_if(spares.begin() + static_cast<std::ptrdiff_t>(base),
+                                  spares.end(), [key](auto const& m) { return m.key() == key; });
+            Object::node_type member;
+            if (it != spares.end()) {
+                member = std::move(*it);
+                *it    = std::move(spares.back());
+                spares.pop_back();
+            }
+            else if (!spares.empty()) {
+                member = std::move(spares.back());
+                spares.pop_back();
+                member.key().assign(key);
+            }
+            ParseWhitespace();
+            if (*cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur_;
+            ParseWhitespace();
+            if (member.empty())
+                /* no spare left, a later duplicate wins as in ParseObject */
+                ParseReuse(result[std::string(key)], reuse);
+            else {
+                ParseReuse(member.mapped(), reuse);
+                auto inserted = result.insert(std::move(member));
+                if (!inserted.inserted) {
+                    std::swap(inserted.position->second, inserted.node.mapped());
+                    spares.push_back(std::move(inserted.node));
+                }
+            }
+            ParseWhitespace();
+            if (*cur_ == ',') {
+                ++cur_;
+                ParseWhitespace();
+                continue;
+            }
+            if (*cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur_;
+    TIJSON_STATS_LEAVE();
+    TIJSON_STATS_ADD(objects, 1);
+} /*}}}*/
+
+template<class OnMatch> /*{{{*/
+inline bool
+Parser::ParseQuery(std::vector<Query::Step> const& steps, size_t step, OnMatch& on_match)
+{
+    using KIND = Query::Step::KIND;
+    if (step == steps.size()) {
+        auto value_begin = cur_;
+        SkipValue();
+        return on_match(std::string_view(&*value_begin, static_cast<size_t>(cur_ - value_begin)));
+    }
+    auto const& current = steps[step];
+    if (*cur_ == '[' && current.kind != KIND::KEY) {
+        ++cur_;
+        size_t index = 0;
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                if (current.kind == KIND::ANY || current.index == index) {
+                    if (ParseQuery(steps, step + 1, on_match))
+                        return true;
+                }
+                else
+                    SkipValue();
+                ++index;
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        return false;
+    }
+    if (*cur_ == '{' && current.kind != KIND::INDEX) {
+        ++cur_;
+        ParseWhitespace();
+        if (*cur_ != '}') {
+            while (true) {
+                if (*cur_ != '\"')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+                ++cur_;
+                auto key     = ParseStringView();
+                bool matched = current.kind == KIND::ANY || key == current.key;
+                ParseWhitespace();
+                if (*cur_ != ':')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+                ++cur_;
+                ParseWhitespace();
+                if (matched) {
+                    if (ParseQuery(steps, step + 1, on_match))
+                        return true;
+                }
+                else
+                    SkipValue();
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == '}')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+            }
+        }
+        ++cur_;
+        return false;
+    }
+    SkipValue();
+    return false;
+} /*}}}*/
+
+inline size_t Parser::ScanPlain(char const* data, size_t size) /*{{{*/
+{
+    size_t pos = 0;
+#if defined(__SSE2__)
+    for (; size - pos >= 16; pos += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos));
+        auto special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\"')),
+                                      _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))),
+                         _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(0x1F)),
+                                        _mm_set1_epi8(0x1F)));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+#endif
+    while (pos < size && data[pos] != '\"' && data[pos] != '\\' &&
+           static_cast<unsigned char>(data[pos]) >= 0x20)
+        pos++;
+    return pos;
+} /*}}}*/
+
+inline void Parser::SkipString() /*{{{*/
+{
+    while (true) {
+        cur_ += ScanPlain(&*cur_, static_cast<size_t>(end_ - cur_));
+        if (cur_ == end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
+        if (IsInvalidChar(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
+        if (*cur_ == '\"') {
+            ++cur_;
+            return;
+        }
+        if (*cur_ == '\\') {
+            if (++cur_ == end_)
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            switch (*cur_++) {
+            case '\"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't': break;
+            case 'u':
+            {
+                char16_t surrogate_h = ParseStringHex4();
+                if (0xDC00 <= surrogate_h && surrogate_h <= 0xDFFF)
+                    throw ParseException::ConstructWithErrorCode<
+                        PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+                if (0xD800 <= surrogate_h && surrogate_h <= 0xDBFF) {
+                    if (cur_[0] != '\\' || cur_[1] != 'u')
+                        throw ParseException::ConstructWithErrorCode<
+                            PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+                    cur_ += 2;
+                    char16_t surrogate_l = ParseStringHex4();
+                    if (surrogate_l < 0xDC00 || 0xDFFF < surrogate_l)
+                        throw ParseException::ConstructWithErrorCode<
+                            PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+                }
+                break;
+            }
+            default:
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+            }
+            continue;
+        }
+        ++cur_;
+    }
+} /*}}}*/
+
+inline void Parser::SkipValue() /*{{{*/
+{
+    Value literal;
+    auto  number_begin = cur_;
+    switch (*cur_) {
+    case 'n': ++cur_, ParseNull(literal); return;
+    case 't': ++cur_, ParseTrue(literal); return;
+    case 'f': ++cur_, ParseFalse(literal); return;
+    case '\"': ++cur_, SkipString(); return;
+    case '[':
+        ++cur_;
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                SkipValue();
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        return;
+    case '{':
+        ++cur_;
+        ParseWhitespace();
+        if (*cur_ != '}') {
+            while (true) {
+                if (*cur_ != '\"')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+                ++cur_;
+                SkipString();
+                ParseWhitespace();
+                if (*cur_ != ':')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+                ++cur_;
+                ParseWhitespace();
+                SkipValue();
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == '}')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+            }
+        }
+        ++cur_;
+        return;
+    default:
+        if (SkipNumber()) {
+            cur_ = number_begin;
+            ParseNumber();
+        }
+    }
+} /*}}}*/
+
+inline void Parser::Validate(std::string_view content) /*{{{*/
+{
+    CheckUtf8(content);
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    parser.SkipValue();
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+} /*}}}*/
+
+inline void Parser::CheckUtf8(std::string_view content) /*{{{*/
+{
+    size_t offset = FindInvalidUtf8(content);
+    if (offset != std::string_view::npos)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UTF8>().SetOffset(offset);
+} /*}}}*/
+
+inline size_t Parser::Utf8SequenceSize(unsigned char const* data, size_t size) /*{{{*/
+{
+    /* well-formed sequences of Unicode table 3-7, the second byte has the narrow ranges */
+    unsigned char lead = data[0];
+    unsigned char low  = 0x80;
+    unsigned char high = 0xBF;
+    size_t        len  = 0;
+    if (lead < 0x80)
+        return 1;
+    if (0xC2 <= lead && lead <= 0xDF)
+        len = 2;
+    else if (0xE0 <= lead && lead <= 0xEF) {
+        len  = 3;
+        low  = lead == 0xE0 ? 0xA0 : low;
+        high = lead == 0xED ? 0x9F : high;
+    }
+    else if (0xF0 <= lead && lead <= 0xF4) {
+        len  = 4;
+        low  = lead == 0xF0 ? 0x90 : low;
+        high = lead == 0xF4 ? 0x8F : high;
+    }
+    else
+        return 0;
+    if (size < len || data[1] < low || data[1] > high)
+        return 0;
+    for (size_t i = 2; i < len; i++)
+        if (data[i] < 0x80 || data[i] > 0xBF)
+            return 0;
+    return len;
+} /*}}}*/
+
+inline size_t Parser::FindInvalidUtf8(unsigned char const* data, size_t pos, size_t size) /*{{{*/
+{
+    while (pos < size) {
+        /* pass 8 ascii bytes at a time */
+        uint64_t word = 0x80;
+        if (size - pos >= 8)
+            std::memcpy(&word, data + pos, 8);
+        if ((word & 0x8080808080808080) == 0) {
+            pos += 8;
+            continue;
+        }
+        size_t len = Utf8SequenceSize(data + pos, size - pos);
+        if (len == 0)
+            return pos;
+        pos += len;
+    }
+    return std::string_view::npos;
+} /*}}}*/
+
+inline size_t Parser::FindInvalidUtf8(std::string_view content) /*{{{*/
+{
+    auto   data = reinterpret_cast<unsigned char const*>(content.data());
+    size_t size = content.size();
+    size_t pos  = 0;
+#if defined(__SSSE3__)
+    pos = ScanUtf8Ssse3(data, size);
+#elif defined(TIJSON_SSSE3_DISPATCH)
+    static bool const ssse3 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") != 0;
+    }();
+    if (ssse3)
+        pos = ScanUtf8Ssse3(data, size);
+#endif
+    /* the scalar loop takes over at the first sequence that may reach into the rest, a
+       sequence starting more than 3 bytes back ends in the checked part */
+    if (pos > 0) {
+        size_t checked = pos;
+        pos -= 3;
+        while (pos < checked && (data[pos] & 0xC0) == 0x80)
+            pos++;
+    }
+    return FindInvalidUtf8(data, pos, size);
+} /*}}}*/
+
+#if defined(__SSSE3__) || defined(TIJSON_SSSE3_DISPATCH)
+TIJSON_SSSE3_TARGET inline size_t Parser::ScanUtf8Ssse3(unsigned char const* data,
+                                                        size_t               size) /*{{{*/
+{
+    // The lookup algorithm of Keiser and Lemire, "Validating UTF-8 in less than one instruction
+    // per byte". Three 16-entry tables indexed by the nibbles of each byte and of the byte before
+    // it flag the errors of a 2-byte window, the 3rd and 4th bytes of long sequences are checked
+    // by comparing the bytes 2 and 3 back. A block that fails is scanned again by the scalar
+    // loop, which finds the offset.
+    constexpr char too_short = 1 << 0, too_long = 1 << 1, overlong_3 = 1 << 2, too_large = 1 << 3,
+                   surrogate = 1 << 4, overlong_2 = 1 << 5, too_large_1000 = 1 << 6,
+                   overlong_4 = 1 << 6, two_conts = static_cast<char>(1 << 7),
+                   carry      = too_short | too_long | two_conts;
+
+    __m128i const byte_1_high = _mm_setr_epi8(
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long, two_conts,
+        two_conts, two_conts, two_conts, too_short | overlong_2, too_short,
+        too_short | overlong_3 | surrogate, too_short | too_large | too_large_1000 | overlong_4);
+    __m128i const byte_1_low = _mm_setr_epi8(
+        carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+        carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000);
+    __m128i const byte_2_high = _mm_setr_epi8(
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large, too_short, too_short, too_short,
+        too_short);
+    /* bytes above these in the last three places start a sequence the next block must finish */
+    __m128i const incomplete_max = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                 -1, static_cast<char>(0xF0 - 1),
+                                                 static_cast<char>(0xE0 - 1),
+                                                 static_cast<char>(0xC0 - 1));
+    __m128i const nibble = _mm_set1_epi8(0x0F);
+    __m128i const zero   = _mm_setzero_si128();
+
+    __m128i prev = zero;
+    size_t  pos  = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos));
+        __m128i error = zero;
+        if (_mm_movemask_epi8(input) == 0)
+            error = _mm_subs_epu8(prev, incomplete_max);
+        else {
+            __m128i prev1   = _mm_alignr_epi8(input, prev, 15);
+            __m128i special = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                    _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+            __m128i third  = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 14),
+                                           _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 13),
+                                           _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            __m128i must_be_cont =
+                _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(two_conts));
+            error = _mm_xor_si128(must_be_cont, special);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF)
+            break;
+        prev = input;
+    }
+    return pos;
+} /*}}}*/
+#endif
+
+template<class T> /*{{{*/
+inline void Parser::ParseInto(std::string_view content, T& out)
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    parser.ParseValueInto(out);
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+} /*}}}*/
+
+template<class T> /*{{{*/
+inline void Parser::ParseValueInto(T& out)
+{
+    if constexpr (std::is_same_v<T, Value>) {
+        out = ParseValue();
+    }
+    else if constexpr (IsOptional<T>::value) {
+        if (*cur_ == 'n') {
+            Value literal;
+            ++cur_, ParseNull(literal);
+            out.reset();
+            return;
+        }
+        ParseValueInto(out.emplace());
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+        Value literal;
+        if (*cur_ == 't')
+            ++cur_, ParseTrue(literal);
+        else if (*cur_ == 'f')
+            ++cur_, ParseFalse(literal);
+        else
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+        out = literal.GetBool();
+    }
+    else if constexpr (std::is_arithmetic_v<T>) {
+        if (*cur_ != '-' && !IsDigital<'0', '9'>(*cur_))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+        TIJSON_STATS_ADD(numbers, 1);
+        char const* begin = cur_;
+        double      n     = ParseNumber();
+        if constexpr (std::is_integral_v<T>) {
+            // integers are read from the digits, so 64-bit values beyond 2^53 stay exact.
+            // Fractions, exponents and -0 go through the double, exact only up to 2^53, and the
+            // upper bound is exclusive: max() + 1 is a power of two, exact as a double
+            constexpr double lower = static_cast<double>(std::numeric_limits<T>::min());
+            constexpr double upper = static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+            T    value{};
+            auto [end, ec] = std::from_chars(begin, cur_, value);
+            if (ec == std::errc() && end == cur_)
+                out = value;
+            else if (n < lower || n >= upper || std::trunc(n) != n || std::fabs(n) > 0x1p53)
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+            else
+                out = static_cast<T>(n);
+        }
+        else {
+            out = static_cast<T>(n);
+        }
+    }
+    else if constexpr (std::is_same_v<T, std::string>) {
+        if (*cur_ != '\"')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+        ++cur_;
+        TIJSON_STATS_ADD(strings, 1);
+        out = ParseString();
+    }
+    else if constexpr (IsVector<T>::value) {
+        if (*cur_ != '[')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+        ++cur_;
+        TIJSON_STATS_ENTER();
+        out.clear();
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                typename T::value_type item{};
+                ParseValueInto(item);
+                out.push_back(std::move(item));
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        TIJSON_STATS_LEAVE();
+        TIJSON_STATS_ADD(arrays, 1);
+    }
+    else if constexpr (IsStringMap<T>::value || IsBound<T>::value) {
+        if (*cur_ != '{')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+        ++cur_;
+        TIJSON_STATS_ENTER();
+        if constexpr (IsStringMap<T>::value)
+            out.clear();
+        ParseWhitespace();
+        if (*cur_ != '}') {
+            while (true) {
+                if (*cur_ != '\"')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+                ++cur_;
+                std::string_view key = ParseStringView();
+                TIJSON_STATS_ADD(keys, 1);
+                ParseWhitespace();
+                if (*cur_ != ':')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+                ++cur_;
+                ParseWhitespace();
+                if constexpr (IsStringMap<T>::value)
+                    ParseValueInto(out[std::string(key)]);
+                else if (!ParseFieldInto(out, key))
+                    SkipValue();
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == '}')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+            }
+        }
+        ++cur_;
+        TIJSON_STATS_LEAVE();
+        TIJSON_STATS_ADD(objects, 1);
+    }
+    else {
+        static_assert(always_false<T>, "type is not parsable, bind it with TIJSON_DEFINE");
+    }
+} /*}}}*/
+
+template<class T> /*{{{*/
+inline bool Parser::ParseFieldInto(T& out, std::string_view key)
+{
+    static constexpr auto matcher = FieldMatcherOf<T>();
+    size_t                slot    = matcher.Find(key);
+    if (slot == matcher.npos)
+        return false;
+    return ParseFieldInto(out, slot, std::make_index_sequence<matcher.size()>{});
+} /*}}}*/
+
+template<class T, size_t... I> /*{{{*/
+inline bool Parser::ParseFieldInto(T& out, size_t slot, std::index_sequence<I...>)
+{
+    // one branch per bound field, generated at compile time
+    constexpr auto fields = FieldsOf<T>();
+    return ((slot == I && (ParseValueInto(out.*std::get<I>(fields).member), true)) || ...);
+} /*}}}*/
+
+template<size_t N> /*{{{*/
+inline void Parser::ParseObjectInto(std::string_view      content,
+                                    KeyMatcher<N> const&  keys,
+                                    std::array<Value, N>& slots,
+                                    UNKNOWN_KEY           policy)
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    for (auto& slot : slots)
+        slot.SetInvalid(PARSE_ERROR::MISS_KEY);
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    if (*parser.cur_ != '{')
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::BIND_TYPE_MISMATCH>();
+    ++parser.cur_;
+    parser.ParseWhitespace();
+    if (*parser.cur_ != '}') {
+        while (true) {
+            if (*parser.cur_ != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++parser.cur_;
+            size_t slot = keys.Find(parser.ParseStringView());
+            parser.ParseWhitespace();
+            if (*parser.cur_ != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++parser.cur_;
+            parser.ParseWhitespace();
+            if (slot != keys.npos)
+                slots[slot] = parser.ParseValue();
+            else if (policy == UNKNOWN_KEY::SKIP)
+                parser.SkipValue();
+            else
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::UNKNOWN_KEY>();
+            parser.ParseWhitespace();
+            if (*parser.cur_ == ',') {
+                ++parser.cur_;
+                parser.ParseWhitespace();
+                continue;
+            }
+            if (*parser.cur_ == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++parser.cur_;
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+} /*}}}*/
+
+template<class Handler> /*{{{*/
+inline void Parser::ParseEvents(std::string_view content, Handler& handler)
+{
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    Parser parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    parser.ParseEvent(handler);
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+} /*}}}*/
+
+template<class Handler> /*{{{*/
+inline void Parser::ParseEvent(Handler& handler)
+{
+    Value literal;
+    switch (*cur_) {
+    case 'n': ++cur_, ParseNull(literal), handler.Null(); return;
+    case 't': ++cur_, ParseTrue(literal), handler.Bool(true); return;
+    case 'f': ++cur_, ParseFalse(literal), handler.Bool(false); return;
+    case '\"': ++cur_, TIJSON_STATS_ADD(strings, 1), handler.String(ParseStringView()); return;
+    case '[':
+    {
+        ++cur_;
+        TIJSON_STATS_ADD(arrays, 1);
+        TIJSON_STATS_ENTER();
+        handler.StartArray();
+        size_t count = 0;
+        ParseWhitespace();
+        if (*cur_ != ']') {
+            while (true) {
+                ParseEvent(handler);
+                ++count;
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == ']')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+            }
+        }
+        ++cur_;
+        TIJSON_STATS_LEAVE();
+        handler.EndArray(count);
+        return;
+    }
+    case '{':
+    {
+        ++cur_;
+        TIJSON_STATS_ADD(objects, 1);
+        TIJSON_STATS_ENTER();
+        handler.StartObject();
+        size_t count = 0;
+        ParseWhitespace();
+        if (*cur_ != '}') {
+            while (true) {
+                if (*cur_ != '\"')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+                ++cur_;
+                TIJSON_STATS_ADD(keys, 1);
+                handler.Key(ParseStringView());
+                ParseWhitespace();
+                if (*cur_ != ':')
+                    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+                ++cur_;
+                ParseWhitespace();
+                ParseEvent(handler);
+                ++count;
+                ParseWhitespace();
+                if (*cur_ == ',') {
+                    ++cur_;
+                    ParseWhitespace();
+                    continue;
+                }
+                if (*cur_ == '}')
+                    break;
+                throw ParseException::ConstructWithErrorCode<
+                    PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+            }
+        }
+        ++cur_;
+        TIJSON_STATS_LEAVE();
+        handler.EndObject(count);
+        return;
+    }
+    default:
+    {
+        auto   number_begin = cur_;
+        double n            = ParseNumber();
+        TIJSON_STATS_ADD(numbers, 1);
+        handler.Number(n, {&*number_begin, static_cast<size_t>(cur_ - number_begin)});
+    }
+    }
+} /*}}}*/
+
+/* NOTE: REUSABLE PARSER IMPLEMENTATION */
+inline void ReusableParser::ParseInto(std::string_view content, Value& val) /*{{{*/
+{
+    if (val.frozen_member_)
+        throw AccessException("VALUE_FROZEN");
+    TIJSON_STATS_SCOPE(PARSE);
+    TIJSON_STATS_BYTES(content.size());
+    Parser parser(content.begin(), content.end());
+    parser.str_buffer_.swap(buffer_);
+    try {
+        parser.ParseWhitespace();
+        if (parser.cur_ == parser.end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+        parser.ParseReuse(val, *this);
+        parser.ParseWhitespace();
+        if (parser.cur_ != parser.end_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
+    }
+    catch (ParseException&) {
+        parser.str_buffer_.swap(buffer_);
+        throw;
+    }
+    parser.str_buffer_.swap(buffer_);
+} /*}}}*/
+
+inline void ReusableParser::ReleaseSpares() /*{{{*/
+{
+    values_  = std::vector<Value>();
+    members_ = std::vector<Object::node_type>();
+    buffer_  = std::string();
+} /*}}}*/
+
+/* NOTE: WRITER IMPLEMENTATION */
+template<class T> /*{{{*/
+inline void Writer::Write(T const& val, std::string& out)
+{
+    if constexpr (std::is_same_v<T, Value>) {
+        out += val.Stringify();
+    }
+    else if constexpr (IsOptional<T>::value) {
+        if (val)
+            Write(*val, out);
+        else
+            TIJSON_STATS_ADD(nulls, 1), out += "null";
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+        TIJSON_STATS_ADD(bools, 1);
+        out += val ? "true" : "false";
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        TIJSON_STATS_ADD(numbers, 1);
+        out += std::to_string(val);
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        TIJSON_STATS_ADD(numbers, 1);
+        WriteNumber(static_cast<double>(val), out);
+    }
+    else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+        TIJSON_STATS_ADD(strings, 1);
+        WriteString(val, out);
+    }
+    else if constexpr (IsVector<T>::value) {
+        using item_type = typename T::value_type;
+        TIJSON_STATS_ADD(arrays, 1), TIJSON_STATS_ENTER();
+        out += "[ ";
+        bool first = true;
+        for (auto const& item : val) {
+            if (!first)
+                out += ", ";
+            first = false;
+            Write(static_cast<item_type const&>(item), out);
+        }
+        out += " ]";
+        TIJSON_STATS_LEAVE();
+    }
+    else if constexpr (IsStringMap<T>::value) {
+        TIJSON_STATS_ADD(objects, 1), TIJSON_STATS_ADD(keys, val.size());
+        TIJSON_STATS_ENTER();
+        out += "{ ";
+        bool first = true;
+        for (auto const& [key, member] : val) {
+            if (!first)
+                out += ", ";
+            first = false;
+            WriteString(key, out);
+            out += ':';
+            Write(member, out);
+        }
+        out += " }";
+        TIJSON_STATS_LEAVE();
+    }
+    else if constexpr (IsBound<T>::value) {
+        TIJSON_STATS_ADD(objects, 1);
+        TIJSON_STATS_ADD(keys, std::tuple_size_v<decltype(FieldsOf<T>())>);
+        TIJSON_STATS_ENTER();
+        out += "{ ";
+        std::apply(
+            [&](auto const&... field) {
+                bool first = true;
+                ((out += first ? "" : ", ", first = false, WriteString(field.name, out),
+                  out += ':', Write(val.*field.member, out)),
+                 ...);
+            },
+            FieldsOf<T>());
+        out += " }";
+        TIJSON_STATS_LEAVE();
+    }
+    else {
+        static_assert(always_false<T>, "type is not serializable, bind it with TIJSON_DEFINE");
+    }
+} /*}}}*/
+
+inline void Writer::WriteNumber(double number, std::string& out) /*{{{*/
+{
+    TIJSON_STATS_TIMER(number_ns);
+    TIJSON_STATS_ADD(numbers_converted, 1);
+    char buf[32];
+    auto sz = std::snprintf(buf, sizeof(buf), "%.17g", number);
+    out.append(buf, sz);
+} /*}}}*/
+
+inline void Writer::WriteString(std::string_view str, std::string& out) /*{{{*/
+{
+    out += '\"';
+    for (auto const& ch : str) {
+        TIJSON_STATS_ADD(escapes, StatsIsEscape(ch));
+        switch (ch) {
+        case '\"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '/': out += "\\/"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            auto temp = static_cast<unsigned char>(ch);
+            if (temp < 0x20) {
+                char buf[8];
+                auto sz = std::snprintf(buf, sizeof(buf), "\\u%04X", temp);
+                out.append(buf, sz);
+            }
+            else
+                out += ch;
+        }
+    }
+    out += '\"';
+} /*}}}*/
+
+/* NOTE: SCHEMA IMPLEMENTATION */
+class Schema::StreamValidator final /*{{{*/
+{
+public:
+    explicit StreamValidator(Schema const& schema) : schema_(schema) {}
+
+    /* parser events */
+    void Null() { Scalar(NUL, [] { return Value(); }); }
+    void Bool(bool bl) { Scalar(BOOLEAN, [bl] { return Value(bl); }); }
+    void Number(double number, std::string_view)
+    {
+        size_t node = NextNode();
+        if (node != npos) {
+            schema_.CheckNumber(node, number);
+            if (!schema_.nodes_[node].enums.empty())
+                schema_.CheckEnum(node, Value(number));
+        }
+        if (!builder_.empty())
+            Attach(Value(number));
+    }
+    void String(std::string_view str)
+    {
+        size_t node = NextNode();
+        if (node != npos) {
+            schema_.CheckType(node, STRING);
+            schema_.CheckString(node, str);
+            if (!schema_.nodes_[node].enums.empty())
+                schema_.CheckEnum(node, Value(std::string(str)));
+        }
+        if (!builder_.empty())
+            Attach(Value(std::string(str)));
+    }
+    void StartArray() { Start(ARRAY, Array()); }
+    void StartObject() { Start(OBJECT, Object()); }
+    void Key(std::string_view key)
+    {
+        auto& frame = frames_.back();
+        frame.child = npos;
+        if (frame.node != npos) {
+            auto const& node = schema_.nodes_[frame.node];
+            frame.child      = schema_.FindProperty(frame.node, key);
+            if (frame.child == npos && !node.additional_properties)
+                throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::ADDITIONAL_PROPERTY>();
+            size_t required = schema_.FindRequired(frame.node, key);
+            if (required != npos)
+                frame.seen[required] = true;
+        }
+        if (frame.build)
+            frame.key = key;
+    }
+    void EndArray(size_t count)
+    {
+        if (frames_.back().node != npos)
+            schema_.CheckItems(frames_.back().node, count);
+        End();
+    }
+    void EndObject(size_t)
+    {
+        auto const& frame = frames_.back();
+        for (auto seen : frame.seen) {
+            if (!seen)
+                throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::REQUIRED_MISSING>();
+        }
+        End();
+    }
+
+private:
+    struct Frame
+    {
+        size_t            node   = npos;
+        bool              object = false;
+        size_t            child  = npos;
+        std::vector<char> seen;
+        bool              build = false;
+        std::string       key;
+    };
+
+    /* node of the value that starts now */
+    size_t NextNode()
+    {
+        if (frames_.empty())
+            return started_ || schema_.nodes_.empty() ? npos : (started_ = true, 0);
+        auto const& frame = frames_.back();
+        if (frame.node == npos)
+            return npos;
+        return frame.object ? frame.child : schema_.nodes_[frame.node].items;
+    }
+
+    template<class F>
+    void Scalar(uint8_t type, F make)
+    {
+        size_t node = NextNode();
+        if (node != npos) {
+            schema_.CheckType(node, type);
+            if (!schema_.nodes_[node].enums.empty())
+                schema_.CheckEnum(node, make());
+        }
+        if (!builder_.empty())
+            Attach(make());
+    }
+
+    void Start(uint8_t type, Value&& empty)
+    {
+        size_t node = NextNode();
+        if (node != npos)
+            schema_.CheckType(node, type);
+        Frame frame;
+        frame.node   = node;
+        frame.object = type == OBJECT;
+        if (node != npos && type == OBJECT)
+            frame.seen.assign(schema_.nodes_[node].required.size(), false);
+        frame.build = !builder_.empty() || (node != npos && !schema_.nodes_[node].enums.empty());
+        if (frame.build)
+            builder_.push_back(std::move(empty));
+        frames_.push_back(std::move(frame));
+    }
+
+    void End()
+    {
+        Frame frame = std::move(frames_.back());
+        frames_.pop_back();
+        if (!frame.build)
+            return;
+        Value val = std::move(builder_.back());
+        builder_.pop_back();
+        if (frame.node != npos && !schema_.nodes_[frame.node].enums.empty())
+            schema_.CheckEnum(frame.node, val);
+        if (!builder_.empty())
+            Attach(std::move(val));
+    }
+
+    /* add a finished value to the container being built */
+    void Attach(Value&& val)
+    {
+        auto& parent = builder_.back();
+        if (parent.GetType() == Value::TYPE::ARRAY)
+            parent.GetArray().push_back(std::move(val));
+        else
+            parent.GetObject()[frames_.back().key] = std::move(val);
+    }
+
+    Schema const&      schema_;
+    std::vector<Frame> frames_;
+    std::vector<Value> builder_;
+    bool               started_ = false;
+};
+/*}}}*/
+
+inline Schema Schema::Compile(Value const& schema) /*{{{*/
+{
+    Schema result;
+    result.CompileNode(schema);
+    return result;
+} /*}}}*/
+
+inline size_t Schema::CompileNode(Value const& schema) /*{{{*/
+{
+    if (schema.GetType() == Value::TYPE::TRUE)
+        return npos;
+    if (schema.GetType() == Value::TYPE::FALSE) {
+        /* a node that accepts no type */
+        nodes_.emplace_back().types = 0;
+        return nodes_.size() - 1;
+    }
+    if (schema.GetType() != Value::TYPE::OBJECT)
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::INVALID_SCHEMA>();
+
+    auto invalid = [] {
+        return SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::INVALID_SCHEMA>();
+    };
+    auto number = [&](Value const& val) {
+        if (val.GetType() != Value::TYPE::NUMBER)
+            throw invalid();
+        return val.GetNumber();
+    };
+    auto count = [&](Value const& val) {
+        double n = number(val);
+        if (n < 0 || std::trunc(n) != n)
+            throw invalid();
+        return static_cast<size_t>(n);
+    };
+    auto type_mask = [&](Value const& val) -> uint8_t {
+        if (val.GetType() != Value::TYPE::STRING)
+            throw invalid();
+        auto name = val.GetString();
+        if (name == "null")
+            return NUL;
+        if (name == "boolean")
+            return BOOLEAN;
+        if (name == "integer")
+            return INTEGER;
+        if (name == "number")
+            return NUMBER | INTEGER;
+        if (name == "string")
+            return STRING;
+        if (name == "array")
+            return ARRAY;
+        if (name == "object")
+            return OBJECT;
+        throw invalid();
+    };
+
+    size_t index = nodes_.size();
+    nodes_.emplace_back();
+    // nodes_ may reallocate while compiling children, so members are assigned through index
+    for (auto const& [keyword, val] : schema.GetObjectView()) {
+        if (keyword == "type") {
+            uint8_t types = 0;
+            if (val.GetType() == Value::TYPE::ARRAY) {
+                for (auto const& type : val.GetArrayView())
+                    types |= type_mask(type);
+            }
+            else
+                types = type_mask(val);
+            nodes_[index].types = types;
+        }
+        else if (keyword == "enum") {
+            if (val.GetType() != Value::TYPE::ARRAY)
+                throw invalid();
+            nodes_[index].enums = val.GetArrayView();
+        }
+        else if (keyword == "minimum")
+            nodes_[index].minimum = number(val);
+        else if (keyword == "maximum")
+            nodes_[index].maximum = number(val);
+        else if (keyword == "exclusiveMinimum" || keyword == "exclusiveMaximum") {
+            bool  minimum = keyword == "exclusiveMinimum";
+            auto& node    = nodes_[index];
+            // draft 4 uses a boolean modifier, later drafts a number. Both are kept apart from
+            // minimum and maximum, so the result does not depend on the order of the keywords
+            if (val.GetType() == Value::TYPE::TRUE || val.GetType() == Value::TYPE::FALSE)
+                (minimum ? node.minimum_is_exclusive : node.maximum_is_exclusive) = val.GetBool();
+            else
+                (minimum ? node.exclusive_minimum : node.exclusive_maximum) = number(val);
+        }
+        else if (keyword == "minLength")
+            nodes_[index].min_length = count(val);
+        else if (keyword == "maxLength")
+            nodes_[index].max_length = count(val);
+        else if (keyword == "pattern") {
+            if (val.GetType() != Value::TYPE::STRING)
+                throw invalid();
+            try {
+                nodes_[index].pattern.emplace(val.GetString(), std::regex::ECMAScript);
+            }
+            catch (std::regex_error&) {
+                throw invalid();
+            }
+        }
+        else if (keyword == "items") {
+            size_t items        = CompileNode(val);
+            nodes_[index].items = items;
+        }
+        else if (keyword == "minItems")
+            nodes_[index].min_items = count(val);
+        else if (keyword == "maxItems")
+            nodes_[index].max_items = count(val);
+        else if (keyword == "properties") {
+            if (val.GetType() != Value::TYPE::OBJECT)
+                throw invalid();
+            for (auto const& [key, property] : val.GetObjectView()) {
+                size_t child = CompileNode(property);
+                nodes_[index].properties.emplace_back(key, child);
+            }
+            std::sort(nodes_[index].properties.begin(), nodes_[index].properties.end());
+        }
+        else if (keyword == "required") {
+            if (val.GetType() != Value::TYPE::ARRAY)
+                throw invalid();
+            auto& required = nodes_[index].required;
+            for (auto const& key : val.GetArrayView()) {
+                if (key.GetType() != Value::TYPE::STRING)
+                    throw invalid();
+                required.push_back(key.GetString());
+            }
+            std::sort(required.begin(), required.end());
+            required.erase(std::unique(required.begin(), required.end()), required.end());
+        }
+        else if (keyword == "additionalProperties") {
+            if (val.GetType() != Value::TYPE::TRUE && val.GetType() != Value::TYPE::FALSE)
+                throw invalid();
+            nodes_[index].additional_properties = val.GetBool();
+        }
+        // other keywords are annotations or unsupported, they are ignored
+    }
+    return index;
+} /*}}}*/
+
+inline SCHEMA_ERROR Schema::Validate(Value const& val) const /*{{{*/
+{
+    try {
+        ValidateNode(nodes_.empty() ? npos : 0, val);
+    }
+    catch (SchemaException& e) {
+        return e.GetErrorCode();
+    }
+    return SCHEMA_ERROR::NO_ERROR;
+} /*}}}*/
+
+inline SCHEMA_ERROR Schema::ValidateStream(std::string_view content) const /*{{{*/
+{
+    StreamValidator validator(*this);
+    try {
+        Parser::ParseEvents(content, validator);
+    }
+    catch (ParseException&) {
+        return SCHEMA_ERROR::INVALID_JSON;
+    }
+    catch (SchemaException& e) {
+        return e.GetErrorCode();
+    }
+    return SCHEMA_ERROR::NO_ERROR;
+} /*}}}*/
+
+inline void Schema::ValidateNode(size_t node, Value const& val) const /*{{{*/
+{
+    if (node == npos)
+        return;
+    switch (val.GetType()) {
+    case Value::TYPE::NUL: CheckType(node, NUL); break;
+    case Value::TYPE::TRUE:
+    case Value::TYPE::FALSE: CheckType(node, BOOLEAN); break;
+    case Value::TYPE::NUMBER: CheckNumber(node, val.GetNumber()); break;
+    case Value::TYPE::STRING:
+        CheckType(node, STRING);
+        CheckString(node, val.GetStringView());
+        break;
+    case Value::TYPE::ARRAY:
+    {
+        CheckType(node, ARRAY);
+        CheckItems(node, val.ItemCount());
+        val.ForEachItem([&](Value const& item) { ValidateNode(nodes_[node].items, item); });
+        break;
+    }
+    case Value::TYPE::OBJECT:
+    {
+        CheckType(node, OBJECT);
+        val.ForEachMember([&](std::string_view key, Value const& member) {
+            size_t child = FindProperty(node, key);
+            if (child == npos && !nodes_[node].additional_properties)
+                throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::ADDITIONAL_PROPERTY>();
+            ValidateNode(child, member);
+        });
+        for (auto const& key : nodes_[node].required) {
+            if (val.Find(key) == nullptr)
+                throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::REQUIRED_MISSING>();
+        }
+        break;
+    }
+    case Value::TYPE::INVALID:
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::TYPE_MISMATCH>();
+    }
+    if (!nodes_[node].enums.empty())
+        CheckEnum(node, val);
+} /*}}}*/
+
+inline void Schema::CheckType(size_t node, uint8_t type) const /*{{{*/
+{
+    if (!(nodes_[node].types & type))
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::TYPE_MISMATCH>();
+} /*}}}*/
+
+inline void Schema::CheckNumber(size_t node, double number) const /*{{{*/
+{
+    auto const& n = nodes_[node];
+    if (!(n.types & NUMBER) && !(n.types & INTEGER && std::trunc(number) == number))
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::TYPE_MISMATCH>();
+    if ((n.minimum && (n.minimum_is_exclusive ? number <= *n.minimum : number < *n.minimum)) ||
+        (n.exclusive_minimum && number <= *n.exclusive_minimum))
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::BELOW_MINIMUM>();
+    if ((n.maximum && (n.maximum_is_exclusive ? number >= *n.maximum : number > *n.maximum)) ||
+        (n.exclusive_maximum && number >= *n.exclusive_maximum))
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::ABOVE_MAXIMUM>();
+} /*}}}*/
+
+inline void Schema::CheckString(size_t node, std::string_view str) const /*{{{*/
+{
+    auto const& n = nodes_[node];
+    if (n.min_length > 0 || n.max_length != npos) {
+        // lengths are counted in code points, skip utf-8 continuation bytes
+        size_t length = 0;
+        for (auto ch : str)
+            length += (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+        if (length < n.min_length)
+            throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::STRING_TOO_SHORT>();
+        if (length > n.max_length)
+            throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::STRING_TOO_LONG>();
+    }
+    if (n.pattern && !std::regex_search(str.begin(), str.end(), *n.pattern))
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::PATTERN_MISMATCH>();
+} /*}}}*/
+
+inline void Schema::CheckItems(size_t node, size_t count) const /*{{{*/
+{
+    if (count < nodes_[node].min_items)
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::TOO_FEW_ITEMS>();
+    if (count > nodes_[node].max_items)
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::TOO_MANY_ITEMS>();
+} /*}}}*/
+
+inline void Schema::CheckEnum(size_t node, Value const& val) const /*{{{*/
+{
+    auto const& enums = nodes_[node].enums;
+    if (std::find(enums.begin(), enums.end(), val) == enums.end())
+        throw SchemaException::ConstructWithErrorCode<SCHEMA_ERROR::ENUM_MISMATCH>();
+} /*}}}*/
+
+inline size_t Schema::FindProperty(size_t node, std::string_view key) const /*{{{*/
+{
+    auto const& properties = nodes_[node].properties;
+    auto        it         = std::lower_bound(
+        properties.begin(), properties.end(), key, [](auto const& property, std::string_view k) {
+            return std::string_view(property.first) < k;
+        });
+    return it != properties.end() && it->first == key ? it->second : npos;
+} /*}}}*/
+
+inline size_t Schema::FindRequired(size_t node, std::string_view key) const /*{{{*/
+{
+    auto const& required = nodes_[node].required;
+    auto        it       = std::lower_bound(required.begin(), required.end(), key);
+    return it != required.end() && *it == key ? static_cast<size_t>(it - required.begin()) : npos;
+} /*}}}*/
+
+/* NOTE: MSGPACK AND CBOR IMPLEMENTATION */
+/* binary codec utils */
+inline void WriteBigEndian(uint64_t n, size_t bytes, std::string& out) /*{{{*/
+{
+    for (size_t i = bytes; i > 0; i--)
+        out += static_cast<char>((n >> ((i - 1) * 8)) & 0xFF);
+} /*}}}*/
+
+inline bool IsIntegral(double n) /*{{{*/
+{
+    /* integral, in int64/uint64 range, and not -0.0 */
+    return std::trunc(n) == n && n >= -9223372036854775808.0 && n < 18446744073709551616.0 &&
+           !(n == 0 && std::signbit(n));
+} /*}}}*/
+
+inline std::string MsgPack::Encode(Value const& val) /*{{{*/
+{
+    std::string result;
+    Encode(val, result);
+    return result;
+} /*}}}*/
+
+inline void MsgPack::Encode(Value const& val, std::string& out) /*{{{*/
+{
+    switch (val.GetType()) {
+    case Value::TYPE::INVALID:
+    case Value::TYPE::NUL: out += '\xC0'; return;
+    case Value::TYPE::FALSE: out += '\xC2'; return;
+    case Value::TYPE::TRUE: out += '\xC3'; return;
+    case Value::TYPE::NUMBER:
+    {
+        double n = val.GetNumber();
+        if (IsIntegral(n) && n >= 0) {
+            auto u = static_cast<uint64_t>(n);
+            if (u < 0x80)
+                out += static_cast<char>(u);
+            else if (u <= 0xFF)
+                out += '\xCC', WriteBigEndian(u, 1, out);
+            else if (u <= 0xFFFF)
+                out += '\xCD', WriteBigEndian(u, 2, out);
+            else if (u <= 0xFFFFFFFF)
+                out += '\xCE', WriteBigEndian(u, 4, out);
+            else
+                out += '\xCF', WriteBigEndian(u, 8, out);
+        }
+        else if (IsIntegral(n)) {
+            auto i = static_cast<int64_t>(n);
+            if (i >= -32)
+                out += static_cast<char>(i);
+            else if (i >= -128)
+                out += '\xD0', WriteBigEndian(static_cast<uint64_t>(i), 1, out);
+            else if (i >= -32768)
+                out += '\xD1', WriteBigEndian(static_cast<uint64_t>(i), 2, out);
+            else if (i >= -2147483648LL)
+                out += '\xD2', WriteBigEndian(static_cast<uint64_t>(i), 4, out);
+            else
+                out += '\xD3', WriteBigEndian(static_cast<uint64_t>(i), 8, out);
+        }
+        else if (static_cast<double>(static_cast<float>(n)) == n || std::isnan(n)) {
+            uint32_t bits;
+            auto     f = static_cast<float>(n);
+            std::memcpy(&bits, &f, sizeof(bits));
+            out += '\xCA', WriteBigEndian(bits, 4, out);
+        }
+        else {
+            uint64_t bits;
+            std::memcpy(&bits, &n, sizeof(bits));
+            out += '\xCB', WriteBigEndian(bits, 8, out);
+        }
+        return;
+    }
+    case Value::TYPE::STRING: EncodeString(val.GetStringView(), out); return;
+    case Value::TYPE::ARRAY:
+    {
+        auto size = val.ItemCount();
+        if (size < 16)
+            out += static_cast<char>(0x90 | size);
+        else if (size <= 0xFFFF)
+            out += '\xDC', WriteBigEndian(size, 2, out);
+        else
+            out += '\xDD', WriteBigEndian(size, 4, out);
+        val.ForEachItem([&](Value const& item) { Encode(item, out); });
+        return;
+    }
+    case Value::TYPE::OBJECT:
+    {
+        auto size = val.MemberCount();
+        if (size < 16)
+            out += static_cast<char>(0x80 | size);
+        else if (size <= 0xFFFF)
+            out += '\xDE', WriteBigEndian(size, 2, out);
+        else
+            out += '\xDF', WriteBigEndian(size, 4, out);
+        val.ForEachMember([&](std::string_view key, Value const& member) {
+            EncodeString(key, out);
+            Encode(member, out);
+        });
+        return;
     }
-    catch (ParseException& e) {
-        result.SetInvalid(e.GetErrorCode());
     }
+} /*}}}*/
+
+inline void MsgPack::EncodeString(std::string_view str, std::string& out) /*{{{*/
+{
+    if (str.size() < 32)
+        out += static_cast<char>(0xA0 | str.size());
+    else if (str.size() <= 0xFF)
+        out += '\xD9', WriteBigEndian(str.size(), 1, out);
+    else if (str.size() <= 0xFFFF)
+        out += '\xDA', WriteBigEndian(str.size(), 2, out);
+    else
+        out += '\xDB', WriteBigEndian(str.size(), 4, out);
+    out += str;
+} /*}}}*/
+
+inline Value MsgPack::Decode(std::string_view data) /*{{{*/
+{
+    MsgPack decoder(data.data(), data.data() + data.size());
+    Value   result = decoder.DecodeValue();
+    if (decoder.cur_ != decoder.end_)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::TRAILING_DATA>();
     return result;
-}
+} /*}}}*/
 
-/* NOTE: VALUE IMPLEMENTATION */
-inline Value::Value(Value const& rhs) /*{{{*/
+inline uint64_t MsgPack::ReadUInt(size_t bytes) /*{{{*/
 {
-    this->type_ = rhs.type_;
-    if (rhs.type_ == TYPE::ARRAY)
-        this->data_ = std::make_unique<Array>(*std::get<ArrayUPtr>(rhs.data_));
-    else if (rhs.type_ == TYPE::OBJECT)
-        this->data_ = std::make_unique<Object>(*std::get<ObjectUPtr>(rhs.data_));
-    else if (rhs.type_ == TYPE::NUMBER)
-        this->data_ = std::get<double>(rhs.data_);
-    else if (rhs.type_ == TYPE::STRING)
-        this->data_ = std::get<std::string>(rhs.data_);
-    else if (rhs.type_ == TYPE::INVALID)
-        this->data_ = std::get<PARSE_ERROR>(rhs.data_);
+    if (static_cast<size_t>(end_ - cur_) < bytes)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    uint64_t n = 0;
+    for (size_t i = 0; i < bytes; i++)
+        n = (n << 8) | static_cast<unsigned char>(*cur_++);
+    return n;
+} /*}}}*/
+
+inline std::string MsgPack::DecodeString(size_t length) /*{{{*/
+{
+    if (static_cast<size_t>(end_ - cur_) < length)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    std::string result(cur_, length);
+    cur_ += length;
+    return result;
+} /*}}}*/
+
+inline Value MsgPack::DecodeArray(size_t length) /*{{{*/
+{
+    Array result;
+    // every element takes at least one byte, do not trust the length prefix beyond that
+    result.reserve(std::min(length, static_cast<size_t>(end_ - cur_)));
+    for (size_t i = 0; i < length; i++)
+        result.emplace_back(DecodeValue());
+    return result;
+} /*}}}*/
+
+inline Value MsgPack::DecodeObject(size_t length) /*{{{*/
+{
+    Object result;
+    result.reserve(std::min(length, static_cast<size_t>(end_ - cur_) / 2));
+    for (size_t i = 0; i < length; i++) {
+        auto tag = static_cast<unsigned char>(cur_ != end_ ? *cur_ : 0);
+        if (!((tag >= 0xA0 && tag <= 0xBF) || (tag >= 0xD9 && tag <= 0xDB) ||
+              (tag >= 0xC4 && tag <= 0xC6)))
+            throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::INVALID_KEY>();
+        ++cur_;
+        size_t key_length = tag >= 0xA0 && tag <= 0xBF ? tag & 0x1F
+                            : tag >= 0xD9              ? ReadUInt(size_t(1) << (tag - 0xD9))
+                                                       : ReadUInt(size_t(1) << (tag - 0xC4));
+        std::string key   = DecodeString(key_length);
+        result[std::move(key)] = DecodeValue();
+    }
+    return result;
+} /*}}}*/
+
+inline Value MsgPack::DecodeValue() /*{{{*/
+{
+    if (cur_ == end_)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    auto tag = static_cast<unsigned char>(*cur_++);
+    if (tag <= 0x7F)
+        return static_cast<double>(tag);
+    if (tag >= 0xE0)
+        return static_cast<double>(static_cast<int8_t>(tag));
+    if (tag <= 0x8F)
+        return DecodeObject(tag & 0x0F);
+    if (tag <= 0x9F)
+        return DecodeArray(tag & 0x0F);
+    if (tag <= 0xBF)
+        return DecodeString(tag & 0x1F);
+    switch (tag) {
+    case 0xC0: return {};
+    case 0xC2: return false;
+    case 0xC3: return true;
+    case 0xC4:
+    case 0xC5:
+    case 0xC6: return DecodeString(ReadUInt(size_t(1) << (tag - 0xC4)));
+    case 0xCA:
+    {
+        auto  bits = static_cast<uint32_t>(ReadUInt(4));
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return static_cast<double>(f);
+    }
+    case 0xCB:
+    {
+        uint64_t bits = ReadUInt(8);
+        double   n;
+        std::memcpy(&n, &bits, sizeof(n));
+        return n;
+    }
+    case 0xCC:
+    case 0xCD:
+    case 0xCE:
+    case 0xCF: return static_cast<double>(ReadUInt(size_t(1) << (tag - 0xCC)));
+    case 0xD0: return static_cast<double>(static_cast<int8_t>(ReadUInt(1)));
+    case 0xD1: return static_cast<double>(static_cast<int16_t>(ReadUInt(2)));
+    case 0xD2: return static_cast<double>(static_cast<int32_t>(ReadUInt(4)));
+    case 0xD3: return static_cast<double>(static_cast<int64_t>(ReadUInt(8)));
+    case 0xD9:
+    case 0xDA:
+    case 0xDB: return DecodeString(ReadUInt(size_t(1) << (tag - 0xD9)));
+    case 0xDC:
+    case 0xDD: return DecodeArray(ReadUInt(tag == 0xDC ? 2 : 4));
+    case 0xDE:
+    case 0xDF: return DecodeObject(ReadUInt(tag == 0xDE ? 2 : 4));
+    default: throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+    }
+} /*}}}*/
+
+inline std::string Cbor::Encode(Value const& val) /*{{{*/
+{
+    std::string result;
+    Encode(val, result);
+    return result;
+} /*}}}*/
+
+inline void Cbor::EncodeHead(uint8_t major, uint64_t argument, std::string& out) /*{{{*/
+{
+    /* shortest form of the initial byte and its argument */
+    major <<= 5;
+    if (argument < 24)
+        out += static_cast<char>(major | argument);
+    else if (argument <= 0xFF)
+        out += static_cast<char>(major | 24), WriteBigEndian(argument, 1, out);
+    else if (argument <= 0xFFFF)
+        out += static_cast<char>(major | 25), WriteBigEndian(argument, 2, out);
+    else if (argument <= 0xFFFFFFFF)
+        out += static_cast<char>(major | 26), WriteBigEndian(argument, 4, out);
     else
-        this->data_ = PARSE_ERROR::NO_ERROR;
+        out += static_cast<char>(major | 27), WriteBigEndian(argument, 8, out);
 } /*}}}*/
 
-inline Value& Value::operator=(Value const& rhs) /*{{{*/
+inline void Cbor::Encode(Value const& val, std::string& out) /*{{{*/
 {
-    this->~Value();
-    return *(new (this) Value(rhs));
+    switch (val.GetType()) {
+    case Value::TYPE::INVALID:
+    case Value::TYPE::NUL: out += '\xF6'; return;
+    case Value::TYPE::FALSE: out += '\xF4'; return;
+    case Value::TYPE::TRUE: out += '\xF5'; return;
+    case Value::TYPE::NUMBER:
+    {
+        double n = val.GetNumber();
+        if (IsIntegral(n) && n >= 0)
+            EncodeHead(0, static_cast<uint64_t>(n), out);
+        else if (IsIntegral(n))
+            EncodeHead(1, static_cast<uint64_t>(-(static_cast<int64_t>(n) + 1)), out);
+        else if (static_cast<double>(static_cast<float>(n)) == n || std::isnan(n)) {
+            uint32_t bits;
+            auto     f = static_cast<float>(n);
+            std::memcpy(&bits, &f, sizeof(bits));
+            out += '\xFA', WriteBigEndian(bits, 4, out);
+        }
+        else {
+            uint64_t bits;
+            std::memcpy(&bits, &n, sizeof(bits));
+            out += '\xFB', WriteBigEndian(bits, 8, out);
+        }
+        return;
+    }
+    case Value::TYPE::STRING:
+    {
+        auto str = val.GetStringView();
+        EncodeHead(3, str.size(), out);
+        out += str;
+        return;
+    }
+    case Value::TYPE::ARRAY:
+    {
+        EncodeHead(4, val.ItemCount(), out);
+        val.ForEachItem([&](Value const& item) { Encode(item, out); });
+        return;
+    }
+    case Value::TYPE::OBJECT:
+    {
+        EncodeHead(5, val.MemberCount(), out);
+        val.ForEachMember([&](std::string_view key, Value const& member) {
+            EncodeHead(3, key.size(), out);
+            out += key;
+            Encode(member, out);
+        });
+        return;
+    }
+    }
 } /*}}}*/
 
-inline Value::Value(Value&& rhs) noexcept : data_(std::move(rhs.data_)), type_(rhs.type_) /*{{{*/
+inline Value Cbor::Decode(std::string_view data) /*{{{*/
 {
-    rhs.data_ = PARSE_ERROR::NO_ERROR;
-    rhs.type_ = TYPE::NUL;
+    Cbor  decoder(data.data(), data.data() + data.size());
+    Value result = decoder.DecodeValue();
+    if (decoder.cur_ != decoder.end_)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::TRAILING_DATA>();
+    return result;
 } /*}}}*/
 
-inline Value& Value::operator=(Value&& rhs) noexcept /*{{{*/
+inline uint64_t Cbor::ReadUInt(size_t bytes) /*{{{*/
 {
-    data_     = std::move(rhs.data_);
-    type_     = rhs.type_;
-    rhs.data_ = PARSE_ERROR::NO_ERROR;
-    rhs.type_ = TYPE::NUL;
-    return *this;
+    if (static_cast<size_t>(end_ - cur_) < bytes)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    uint64_t n = 0;
+    for (size_t i = 0; i < bytes; i++)
+        n = (n << 8) | static_cast<unsigned char>(*cur_++);
+    return n;
 } /*}}}*/
 
-inline Value::TYPE Value::GetType() const /*{{{*/
+inline uint64_t Cbor::ReadArgument(uint8_t info) /*{{{*/
 {
-    return type_;
+    if (info < 24)
+        return info;
+    if (info <= 27)
+        return ReadUInt(size_t(1) << (info - 24));
+    throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
 } /*}}}*/
 
-inline PARSE_ERROR Value::GetParseErrorCode() const /*{{{*/
+inline bool Cbor::IsBreak() /*{{{*/
 {
-    return type_ == TYPE::INVALID ? std::get<PARSE_ERROR>(data_) : PARSE_ERROR::NO_ERROR;
+    if (cur_ == end_)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    if (*cur_ != '\xFF')
+        return false;
+    ++cur_;
+    return true;
 } /*}}}*/
 
-inline bool Value::GetBool() const /*{{{*/
+inline std::string Cbor::DecodeString(uint8_t major, uint8_t info) /*{{{*/
 {
-    if (type_ == TYPE::TRUE || type_ == TYPE::FALSE)
-        return type_ == TYPE::TRUE ? true : false;
+    std::string result;
+    if (info == 31) {
+        /* indefinite length, a sequence of definite chunks of the same major type */
+        while (!IsBreak()) {
+            auto head = static_cast<unsigned char>(*cur_++);
+            if (head >> 5 != major || (head & 0x1F) == 31)
+                throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+            result += DecodeString(major, head & 0x1F);
+        }
+        return result;
+    }
+    uint64_t length = ReadArgument(info);
+    if (static_cast<uint64_t>(end_ - cur_) < length)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    result.assign(cur_, length);
+    cur_ += length;
+    return result;
+} /*}}}*/
+
+inline Value Cbor::DecodeValue() /*{{{*/
+{
+    if (cur_ == end_)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    auto    head  = static_cast<unsigned char>(*cur_++);
+    uint8_t major = head >> 5;
+    uint8_t info  = head & 0x1F;
+    switch (major) {
+    case 0: return static_cast<double>(ReadArgument(info));
+    case 1: return -1.0 - static_cast<double>(ReadArgument(info));
+    case 2:
+    case 3: return DecodeString(major, info);
+    case 4:
+    {
+        Array result;
+        if (info == 31) {
+            while (!IsBreak())
+                result.emplace_back(DecodeValue());
+            return result;
+        }
+        uint64_t length = ReadArgument(info);
+        result.reserve(std::min(length, static_cast<uint64_t>(end_ - cur_)));
+        for (uint64_t i = 0; i < length; i++)
+            result.emplace_back(DecodeValue());
+        return result;
+    }
+    case 5:
+    {
+        Object   result;
+        bool     indefinite = info == 31;
+        uint64_t length     = indefinite ? 0 : ReadArgument(info);
+        if (!indefinite)
+            result.reserve(std::min(length, static_cast<uint64_t>(end_ - cur_) / 2));
+        for (uint64_t i = 0; indefinite ? !IsBreak() : i < length; i++) {
+            if (cur_ == end_)
+                throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+            auto key_head = static_cast<unsigned char>(*cur_++);
+            if (key_head >> 5 != 2 && key_head >> 5 != 3)
+                throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::INVALID_KEY>();
+            std::string key        = DecodeString(key_head >> 5, key_head & 0x1F);
+            result[std::move(key)] = DecodeValue();
+        }
+        return result;
+    }
+    case 6: ReadArgument(info); return DecodeValue(); /* tags are dropped */
+    default: break;
+    }
+    switch (info) {
+    case 20: return false;
+    case 21: return true;
+    case 22:
+    case 23: return {};
+    case 25:
+    {
+        /* half precision */
+        auto   half     = static_cast<uint16_t>(ReadUInt(2));
+        int    exponent = (half >> 10) & 0x1F;
+        int    mantissa = half & 0x3FF;
+        double n        = exponent == 0    ? std::ldexp(mantissa, -24)
+                          : exponent != 31 ? std::ldexp(mantissa + 1024, exponent - 25)
+                          : mantissa == 0  ? HUGE_VAL
+                                           : std::nan("");
+        return half & 0x8000 ? -n : n;
+    }
+    case 26:
+    {
+        auto  bits = static_cast<uint32_t>(ReadUInt(4));
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return static_cast<double>(f);
+    }
+    case 27:
+    {
+        uint64_t bits = ReadUInt(8);
+        double   n;
+        std::memcpy(&n, &bits, sizeof(n));
+        return n;
+    }
+    default: throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+    }
+} /*}}}*/
+
+/* NOTE: IMAGE IMPLEMENTATION */
+inline bool ImageView::GetBool() const /*{{{*/
+{
+    if (GetType() == Value::TYPE::TRUE || GetType() == Value::TYPE::FALSE)
+        return GetType() == Value::TYPE::TRUE;
     throw AccessException("VALUE_NOT_BOOL");
 } /*}}}*/
 
-inline double Value::GetNumber() const /*{{{*/
+inline double ImageView::GetNumber() const /*{{{*/
 {
-    if (type_ == TYPE::NUMBER)
-        return std::get<double>(data_);
-    throw AccessException("VALUE_NOT_NUMBER");
+    if (GetType() != Value::TYPE::NUMBER)
+        throw AccessException("VALUE_NOT_NUMBER");
+    double n;
+    std::memcpy(&n, &slot_->payload, sizeof(n));
+    return n;
+} /*}}}*/
+
+inline std::string_view ImageView::GetString() const /*{{{*/
+{
+    if (GetType() != Value::TYPE::STRING)
+        throw AccessException("VALUE_NOT_STRING");
+    return String(*slot_);
+} /*}}}*/
+
+inline size_t ImageView::size() const /*{{{*/
+{
+    if (GetType() != Value::TYPE::ARRAY && GetType() != Value::TYPE::OBJECT)
+        throw AccessException("VALUE_NOT_ARRAY_OR_OBJECT");
+    return slot_->length;
+} /*}}}*/
+
+inline ImageView ImageView::operator[](size_t index) const /*{{{*/
+{
+    if (GetType() == Value::TYPE::ARRAY) {
+        if (index >= slot_->length)
+            throw AccessException("ARRAY_INDEX_OUT_OF_RANGE");
+        return {base_, Children() + index};
+    }
+    if (GetType() == Value::TYPE::OBJECT) {
+        if (index >= slot_->length)
+            throw AccessException("OBJECT_INDEX_OUT_OF_RANGE");
+        /* members are stored as key slot, value slot pairs */
+        return {base_, Children() + 2 * index + 1};
+    }
+    throw AccessException("VALUE_NOT_ARRAY");
+} /*}}}*/
+
+inline std::string_view ImageView::Key(size_t index) const /*{{{*/
+{
+    if (GetType() != Value::TYPE::OBJECT)
+        throw AccessException("VALUE_NOT_OBJECT");
+    if (index >= slot_->length)
+        throw AccessException("OBJECT_INDEX_OUT_OF_RANGE");
+    return String(Children()[2 * index]);
+} /*}}}*/
+
+inline ImageView ImageView::Find(std::string_view key) const /*{{{*/
+{
+    if (GetType() != Value::TYPE::OBJECT)
+        throw AccessException("VALUE_NOT_OBJECT");
+    size_t lower = 0, upper = slot_->length;
+    auto   members = Children();
+    while (lower < upper) {
+        size_t mid = lower + (upper - lower) / 2;
+        auto   cmp = String(members[2 * mid]).compare(key);
+        if (cmp == 0)
+            return {base_, members + 2 * mid + 1};
+        if (cmp < 0)
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
+    return {};
+} /*}}}*/
+
+inline ImageView ImageView::operator[](std::string_view key) const /*{{{*/
+{
+    auto result = Find(key);
+    if (!result)
+        throw AccessException("OBJECT_KEY_NOT_FOUND");
+    return result;
+} /*}}}*/
+
+inline Value ImageView::ToValue() const /*{{{*/
+{
+    Value result;
+    switch (GetType()) {
+    case Value::TYPE::INVALID:
+    case Value::TYPE::NUL: break;
+    case Value::TYPE::TRUE:
+    case Value::TYPE::FALSE: result.SetBool(GetBool()); break;
+    case Value::TYPE::NUMBER: result.SetNumber(GetNumber()); break;
+    case Value::TYPE::STRING: result.SetString(std::string(GetString())); break;
+    case Value::TYPE::ARRAY:
+    {
+        Array arr;
+        arr.reserve(slot_->length);
+        for (size_t i = 0; i < slot_->length; i++)
+            arr.push_back((*this)[i].ToValue());
+        result.SetArray(std::move(arr));
+        break;
+    }
+    case Value::TYPE::OBJECT:
+    {
+        Object obj;
+        obj.reserve(slot_->length);
+        for (size_t i = 0; i < slot_->length; i++)
+            obj.emplace(Key(i), (*this)[i].ToValue());
+        result.SetObject(std::move(obj));
+        break;
+    }
+    }
+    return result;
+} /*}}}*/
+
+inline std::string Image::Write(Value const& val) /*{{{*/
+{
+    std::string result;
+    Write(val, result);
+    return result;
+} /*}}}*/
+
+inline void Image::Write(Value const& val, std::string& out) /*{{{*/
+{
+    Image  writer(out);
+    size_t header = writer.Allocate(sizeof(Header));
+    writer.WriteValue(val, header + offsetof(Header, root));
+    auto head = reinterpret_cast<Header*>(&out[header]);
+    std::memcpy(head->magic, "TJIM", 4);
+    head->version = kVersion;
+    head->size    = out.size() - writer.begin_;
+} /*}}}*/
+
+inline ImageView Image::Open(void const* data, size_t size) /*{{{*/
+{
+    auto base = static_cast<char const*>(data);
+    if (size < sizeof(Header))
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    if (reinterpret_cast<uintptr_t>(base) % alignof(ImageSlot) != 0)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::INVALID_IMAGE>();
+    auto head = reinterpret_cast<Header const*>(base);
+    if (std::memcmp(head->magic, "TJIM", 4) != 0 || head->version != kVersion)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::INVALID_IMAGE>();
+    if (head->size > size)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNEXPECTED_END>();
+    Verify(base, head->size);
+    return {base, &head->root};
+} /*}}}*/
+
+inline void Image::Verify(char const* base, uint64_t size) /*{{{*/
+{
+    /* Write stores every slot once, so visiting more slots than fit means a cycle */
+    uint64_t                      budget = size / sizeof(ImageSlot);
+    std::vector<ImageSlot const*> pending{&reinterpret_cast<Header const*>(base)->root};
+    auto invalid = [] {
+        return DecodeException::ConstructWithErrorCode<DECODE_ERROR::INVALID_IMAGE>();
+    };
+    auto inside = [size](uint64_t offset, uint64_t bytes) {
+        return offset >= sizeof(Header) && offset <= size && bytes <= size - offset;
+    };
+    while (!pending.empty()) {
+        ImageSlot const& slot = *pending.back();
+        pending.pop_back();
+        switch (slot.type) {
+        case Value::TYPE::NUL:
+        case Value::TYPE::TRUE:
+        case Value::TYPE::FALSE:
+        case Value::TYPE::NUMBER: break;
+        case Value::TYPE::STRING:
+            if (!inside(slot.payload, uint64_t(slot.length) + 1))
+                throw invalid();
+            break;
+        case Value::TYPE::ARRAY:
+        case Value::TYPE::OBJECT:
+        {
+            uint64_t count = uint64_t(slot.length) * (slot.type == Value::TYPE::ARRAY ? 1 : 2);
+            if (slot.payload % alignof(ImageSlot) != 0 ||
+                !inside(slot.payload, count * sizeof(ImageSlot)) || count > budget)
+                throw invalid();
+            budget -= count;
+            auto children = reinterpret_cast<ImageSlot const*>(base + slot.payload);
+            for (uint64_t i = 0; i < count; i++) {
+                /* a key is a string */
+                if (slot.type == Value::TYPE::OBJECT && i % 2 == 0 &&
+                    children[i].type != Value::TYPE::STRING)
+                    throw invalid();
+                pending.push_back(children + i);
+            }
+            break;
+        }
+        default: throw invalid();
+        }
+    }
+} /*}}}*/
+
+inline uint32_t Image::Length(size_t length) /*{{{*/
+{
+    if (length > UINT32_MAX)
+        throw std::length_error("Image: more than UINT32_MAX bytes or entries");
+    return static_cast<uint32_t>(length);
+} /*}}}*/
+
+inline size_t Image::Allocate(size_t bytes) /*{{{*/
+{
+    /* keep every allocation 8-byte aligned relative to the image start */
+    size_t offset = out_.size();
+    out_.resize(offset + ((bytes + 7) & ~size_t(7)), '\0');
+    return offset;
+} /*}}}*/
+
+inline void Image::SetSlot(size_t slot_offset, ImageSlot const& slot) /*{{{*/
+{
+    std::memcpy(&out_[slot_offset], &slot, sizeof(slot));
+} /*}}}*/
+
+inline void Image::WriteString(std::string_view str, size_t slot_offset) /*{{{*/
+{
+    /* equal strings, most often repeated keys, are stored once */
+    ImageSlot slot{Value::TYPE::STRING, {}, Length(str.size()), 0};
+    auto      it = strings_.find(str);
+    if (it != strings_.end())
+        slot.payload = it->second;
+    else {
+        size_t offset = Allocate(str.size() + 1);
+        std::memcpy(&out_[offset], str.data(), str.size());
+        slot.payload = offset - begin_;
+        strings_.emplace(str, slot.payload);
+    }
+    SetSlot(slot_offset, slot);
+} /*}}}*/
+
+inline void Image::WriteValue(Value const& val, size_t slot_offset) /*{{{*/
+{
+    ImageSlot slot{val.GetType(), {}, 0, 0};
+    switch (val.GetType()) {
+    case Value::TYPE::INVALID: slot.type = Value::TYPE::NUL; break;
+    case Value::TYPE::NUL:
+    case Value::TYPE::TRUE:
+    case Value::TYPE::FALSE: break;
+    case Value::TYPE::NUMBER:
+    {
+        double n = val.GetNumber();
+        std::memcpy(&slot.payload, &n, sizeof(n));
+        break;
+    }
+    case Value::TYPE::STRING: WriteString(val.GetStringView(), slot_offset); return;
+    case Value::TYPE::ARRAY:
+    {
+        size_t size  = val.ItemCount();
+        slot.length  = Length(size);
+        size_t items = Allocate(size * sizeof(ImageSlot));
+        slot.payload = items - begin_;
+        size_t i     = 0;
+        val.ForEachItem([&](Value const& item) {
+            WriteValue(item, items + i++ * sizeof(ImageSlot));
+        });
+        break;
+    }
+    case Value::TYPE::OBJECT:
+    {
+        /* members are sorted by key so readers can binary search */
+        std::vector<std::pair<std::string_view, Value const*>> members;
+        members.reserve(val.MemberCount());
+        val.ForEachMember([&](std::string_view key, Value const& member) {
+            members.emplace_back(key, &member);
+        });
+        std::sort(members.begin(), members.end(),
+                  [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+        slot.length  = Length(members.size());
+        size_t items = Allocate(members.size() * 2 * sizeof(ImageSlot));
+        slot.payload = items - begin_;
+        for (size_t i = 0; i < members.size(); i++) {
+            WriteString(members[i].first, items + 2 * i * sizeof(ImageSlot));
+            WriteValue(*members[i].second, items + (2 * i + 1) * sizeof(ImageSlot));
+        }
+        break;
+    }
+    }
+    SetSlot(slot_offset, slot);
+} /*}}}*/
+
+/* NOTE: POINTER IMPLEMENTATION */
+inline Pointer::Pointer(std::string_view pointer) /*{{{*/
+{
+    if (!pointer.empty() && pointer[0] != '/')
+        throw std::invalid_argument("JSON Pointer must start with '/'");
+    while (!pointer.empty()) {
+        pointer.remove_prefix(1);
+        auto        end = std::min(pointer.find('/'), pointer.size());
+        std::string key;
+        /* unescape ~1 to '/' and ~0 to '~', any other '~' is invalid */
+        for (size_t i = 0; i < end; i++) {
+            if (pointer[i] != '~')
+                key += pointer[i];
+            else if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1'))
+                key += pointer[++i] == '0' ? '~' : '/';
+            else
+                throw std::invalid_argument("invalid escape in JSON Pointer");
+        }
+        pointer.remove_prefix(end);
+        segments_.push_back(MakeSegment(std::move(key)));
+    }
+} /*}}}*/
+
+inline Pointer::Segment Pointer::MakeSegment(std::string key) /*{{{*/
+{
+    Segment segment;
+    segment.is_index = !key.empty() && key.size() < 20 && (key == "0" || key[0] != '0') &&
+                       std::all_of(key.begin(), key.end(),
+                                   [](char ch) { return '0' <= ch && ch <= '9'; });
+    if (segment.is_index)
+        segment.index = std::strtoull(key.c_str(), nullptr, 10);
+    segment.key = std::move(key);
+    return segment;
+} /*}}}*/
+
+inline Value* Pointer::Step(Value const& val, Segment const& segment) /*{{{*/
+{
+    if (val.GetType() == Value::TYPE::OBJECT)
+        return val.Find(segment.key);
+    if (val.GetType() == Value::TYPE::ARRAY && segment.is_index) {
+        if (segment.index >= val.ItemCount())
+            return nullptr;
+        return &val[segment.index];
+    }
+    return nullptr;
 } /*}}}*/
 
-inline std::string Value::GetString() const /*{{{*/
+inline Value* Pointer::Get(Value& root) const /*{{{*/
 {
-    if (type_ == TYPE::STRING)
-        return std::get<std::string>(data_);
-    throw AccessException("VALUE_NOT_STRING");
+    return const_cast<Value*>(Get(static_cast<Value const&>(root)));
 } /*}}}*/
 
-inline Array& Value::GetArray() const /*{{{*/
+inline Value const* Pointer::Get(Value const& root) const /*{{{*/
 {
+    Value const* cur = &root;
+    for (auto const& segment : segments_)
+        if ((cur = Step(*cur, segment)) == nullptr)
+            return nullptr;
+    return cur;
+} /*}}}*/
 
-    if (type_ == TYPE::ARRAY)
-        return *std::get<ArrayUPtr>(data_);
-    throw AccessException("VALUE_NOT_ARRAY");
+inline Value* Pointer::GetParent(Value const& root) const /*{{{*/
+{
+    Value* cur = const_cast<Value*>(&root);
+    for (size_t i = 0; i + 1 < segments_.size(); i++)
+        if ((cur = Step(*cur, segments_[i])) == nullptr)
+            return nullptr;
+    return cur;
 } /*}}}*/
 
-inline Object& Value::GetObject() const /*{{{*/
+inline bool Pointer::Set(Value& root, Value val) const /*{{{*/
 {
-    if (type_ == TYPE::OBJECT)
-        return *std::get<ObjectUPtr>(data_);
-    throw AccessException("VALUE_NOT_OBJECT");
+    if (segments_.empty()) {
+        root = std::move(val);
+        return true;
+    }
+    Value* parent = GetParent(root);
+    if (parent == nullptr)
+        return false;
+    if (parent->IsFrozen())
+        throw AccessException("VALUE_FROZEN");
+    auto const& last = segments_.back();
+    if (parent->GetType() == Value::TYPE::OBJECT) {
+        parent->GetObject()[last.key] = std::move(val);
+        return true;
+    }
+    if (parent->GetType() == Value::TYPE::ARRAY) {
+        auto& arr = parent->GetArray();
+        if (last.key == "-" || (last.is_index && last.index == arr.size())) {
+            arr.push_back(std::move(val));
+            return true;
+        }
+        if (last.is_index && last.index < arr.size()) {
+            arr[last.index] = std::move(val);
+            return true;
+        }
+    }
+    return false;
 } /*}}}*/
 
-inline void Value::SetInvalid(PARSE_ERROR parse_error) /*{{{*/
+inline bool Pointer::Erase(Value& root) const /*{{{*/
 {
-    data_ = parse_error;
-    type_ = TYPE::INVALID;
+    if (segments_.empty())
+        return false;
+    Value* parent = GetParent(root);
+    if (parent == nullptr)
+        return false;
+    if (parent->IsFrozen())
+        throw AccessException("VALUE_FROZEN");
+    auto const& last = segments_.back();
+    if (parent->GetType() == Value::TYPE::OBJECT)
+        return parent->GetObject().erase(last.key) > 0;
+    if (parent->GetType() == Value::TYPE::ARRAY && last.is_index) {
+        auto& arr = parent->GetArray();
+        if (last.index >= arr.size())
+            return false;
+        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(last.index));
+        return true;
+    }
+    return false;
 } /*}}}*/
 
-inline void Value::SetNull() /*{{{*/
+inline std::vector<Value const*> Pointer::Resolve(Value const&                root,
+                                                  std::vector<Pointer> const& pointers) /*{{{*/
 {
-    data_ = PARSE_ERROR::NO_ERROR;
-    type_ = TYPE::NUL;
+    /* visit pointers in segment order, so each one only walks past its common prefix with the
+       previous one */
+    std::vector<size_t> order(pointers.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    auto less = [](Segment const& lhs, Segment const& rhs) { return lhs.key < rhs.key; };
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        auto const& l = pointers[lhs].segments_;
+        auto const& r = pointers[rhs].segments_;
+        return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(), less);
+    });
+
+    std::vector<Value const*> result(pointers.size(), nullptr);
+    std::vector<Value const*> path{&root};   // path[d] is the value after d segments
+    Pointer const*            prev = nullptr;
+    for (auto i : order) {
+        auto const& segments = pointers[i].segments_;
+        size_t      common   = 0;
+        if (prev != nullptr)
+            while (common < segments.size() && common < prev->segments_.size() &&
+                   common + 1 < path.size() && segments[common].key == prev->segments_[common].key)
+                common++;
+        path.resize(common + 1);
+        while (path.size() <= segments.size() && path.back() != nullptr)
+            path.push_back(Step(*path.back(), segments[path.size() - 1]));
+        if (path.size() == segments.size() + 1)
+            result[i] = path.back();
+        prev = &pointers[i];
+    }
+    return result;
 } /*}}}*/
 
-inline void Value::SetBool(bool tf) /*{{{*/
+inline std::string Pointer::ToString() const /*{{{*/
 {
-    data_ = PARSE_ERROR::NO_ERROR;
-    type_ = tf ? TYPE::TRUE : TYPE::FALSE;
+    std::string result;
+    for (auto const& segment : segments_) {
+        result += '/';
+        for (auto ch : segment.key) {
+            if (ch == '~')
+                result += "~0";
+            else if (ch == '/')
+                result += "~1";
+            else
+                result += ch;
+        }
+    }
+    return result;
 } /*}}}*/
 
-inline void Value::SetNumber(double n) /*{{{*/
+inline Pointer Pointer::Append(std::string_view key) const /*{{{*/
 {
-    data_ = n;
-    type_ = TYPE::NUMBER;
+    Pointer result = *this;
+    result.segments_.push_back(MakeSegment(std::string(key)));
+    return result;
 } /*}}}*/
 
-inline void Value::SetString(std::string&& s) /*{{{*/
+inline Pointer Pointer::Append(size_t index) const /*{{{*/
 {
-    data_ = std::move(s);
-    type_ = TYPE::STRING;
+    Pointer result = *this;
+    result.segments_.push_back(MakeSegment(std::to_string(index)));
+    return result;
 } /*}}}*/
 
-inline void Value::SetArray(Array&& arr) /*{{{*/
+/* NOTE: COLUMNS IMPLEMENTATION */
+inline std::string_view Column::GetString(size_t row) const /*{{{*/
 {
-    data_ = std::make_unique<Array>(std::move(arr));
-    type_ = TYPE::ARRAY;
+    if (type_ != TYPE::STRING && type_ != TYPE::JSON)
+        throw AccessException("COLUMN_NOT_STRING");
+    return std::string_view(bytes_).substr(offsets_[row], offsets_[row + 1] - offsets_[row]);
 } /*}}}*/
 
-inline void Value::SetObject(Object&& obj) /*{{{*/
+inline bool Column::ToInt64(std::string_view text, int64_t& out) /*{{{*/
 {
-    data_ = std::make_unique<Object>(std::move(obj));
-    type_ = TYPE::OBJECT;
+    if (text.find_first_of(".eE") != std::string_view::npos)
+        return false;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
 } /*}}}*/
 
-inline std::string Value::Stringify() const /*{{{*/
+inline void Column::Append(TYPE type, std::string_view text, std::string_view str) /*{{{*/
 {
+    if (size_ % 64 == 0)
+        validity_.push_back(0);
+    if (type != TYPE::NUL) {
+        validity_.back() |= uint64_t(1) << (size_ % 64);
+        if (type_ == TYPE::NUL)
+            ConvertTo(type);
+        /* a JSON column takes the text of any type, its entries are json already */
+        else if (type_ != type && type_ != TYPE::JSON) {
+            bool numbers = (type_ == TYPE::INT64 || type_ == TYPE::DOUBLE) &&
+                           (type == TYPE::INT64 || type == TYPE::DOUBLE);
+            /* a DOUBLE column takes integers as they are */
+            if (!numbers || type_ == TYPE::INT64)
+                ConvertTo(numbers ? TYPE::DOUBLE : TYPE::JSON);
+        }
+    }
     switch (type_) {
-    case TYPE::NUL: return "null";
-    case TYPE::TRUE: return "true";
-    case TYPE::FALSE: return "false";
-    case TYPE::NUMBER: return StringifyNumber();
-    case TYPE::STRING: return StringifyString();
-    case TYPE::ARRAY: return StringifyArray();
-    case TYPE::OBJECT: return StringifyObject();
-    case TYPE::INVALID: break;
+    case TYPE::NUL: break;
+    case TYPE::BOOL: bools_.push_back(type != TYPE::NUL && text[0] == 't'); break;
+    case TYPE::INT64:
+    {
+        int64_t number = 0;
+        if (type != TYPE::NUL)
+            ToInt64(text, number);
+        int64s_.push_back(number);
+        break;
     }
-    return "";
+    case TYPE::DOUBLE:
+        doubles_.push_back(type == TYPE::NUL ? 0
+                                             : std::strtod(std::string(text).c_str(), nullptr));
+        break;
+    case TYPE::STRING:
+        bytes_ += str;
+        offsets_.push_back(bytes_.size());
+        break;
+    case TYPE::JSON:
+        if (type != TYPE::NUL)
+            bytes_ += text;
+        offsets_.push_back(bytes_.size());
+        break;
+    }
+    ++size_;
 } /*}}}*/
 
-inline std::string Value::StringifyNumber() const /*{{{*/
+inline void Column::PopBack() /*{{{*/
 {
-    auto              fmt        = "%.17g";
-    double            number_raw = std::get<double>(data_);
-    auto              sz         = std::snprintf(nullptr, 0, fmt, number_raw);
-    std::vector<char> buf(sz + 1);
-    std::sprintf(&buf[0], fmt, number_raw);
-    std::string result(buf.begin(), buf.end() - 1);
-    return result;
+    --size_;
+    validity_.back() &= ~(uint64_t(1) << (size_ % 64));
+    if (size_ % 64 == 0)
+        validity_.pop_back();
+    switch (type_) {
+    case TYPE::NUL: break;
+    case TYPE::BOOL: bools_.pop_back(); break;
+    case TYPE::INT64: int64s_.pop_back(); break;
+    case TYPE::DOUBLE: doubles_.pop_back(); break;
+    case TYPE::STRING:
+    case TYPE::JSON:
+        offsets_.pop_back();
+        bytes_.resize(offsets_.back());
+        break;
+    }
 } /*}}}*/
 
-inline std::string Value::StringifyString() const /*{{{*/
+inline void Column::ConvertTo(TYPE type) /*{{{*/
 {
-    std::string result = "\"";
-    for (auto const& ch : std::get<std::string>(data_)) {
-        switch (ch) {
-        case '\"': result += "\\\""; break;
-        case '\\': result += "\\\\"; break;
-        case '/': result += "\\/"; break;
-        case '\b': result += "\\b"; break;
-        case '\f': result += "\\f"; break;
-        case '\n': result += "\\n"; break;
-        case '\r': result += "\\r"; break;
-        case '\t': result += "\\t"; break;
-        default:
-            auto temp = static_cast<unsigned char>(ch);
-            if (temp < 0x20) {
-                auto        fmt = "\\u%04X";
-                auto        sz  = std::snprintf(nullptr, 0, fmt, temp);
-                std::string buf(sz + 1, '\0');
-                std::sprintf(&buf[0], fmt, temp);
-                buf.pop_back();
-                result += buf;
+    if (type_ == TYPE::NUL) {
+        /* the entries so far are null */
+        switch (type) {
+        case TYPE::NUL: break;
+        case TYPE::BOOL: bools_.assign(size_, 0); break;
+        case TYPE::INT64: int64s_.assign(size_, 0); break;
+        case TYPE::DOUBLE: doubles_.assign(size_, 0); break;
+        case TYPE::STRING:
+        case TYPE::JSON: offsets_.assign(size_ + 1, 0); break;
+        }
+    }
+    else if (type == TYPE::DOUBLE) {
+        /* from INT64 */
+        doubles_.assign(int64s_.begin(), int64s_.end());
+        int64s_ = {};
+    }
+    else {
+        /* to JSON, each valid entry becomes its json text */
+        std::string         bytes;
+        std::vector<size_t> offsets{0};
+        offsets.reserve(size_ + 1);
+        for (size_t row = 0; row < size_; row++) {
+            if (IsValid(row)) {
+                switch (type_) {
+                case TYPE::BOOL: Writer::Write(bools_[row] != 0, bytes); break;
+                case TYPE::INT64: Writer::Write(int64s_[row], bytes); break;
+                case TYPE::DOUBLE: Writer::Write(doubles_[row], bytes); break;
+                default: Writer::Write(GetString(row), bytes);
+                }
             }
-            else
-                result += ch;
+            offsets.push_back(bytes.size());
         }
+        bools_   = {};
+        int64s_  = {};
+        doubles_ = {};
+        bytes_   = std::move(bytes);
+        offsets_ = std::move(offsets);
     }
-    result += '\"';
-    return result;
+    type_ = type;
 } /*}}}*/
 
-inline std::string Value::StringifyString(std::string_view str) const /*{{{*/
+inline Columns Columns::FromJson(std::string_view content) /*{{{*/
 {
-    std::string result = "\"";
-    for (auto const& ch : str) {
-        switch (ch) {
-        case '\"': result += "\\\""; break;
-        case '\\': result += "\\\\"; break;
-        case '/': result += "\\/"; break;
-        case '\b': result += "\\b"; break;
-        case '\f': result += "\\f"; break;
-        case '\n': result += "\\n"; break;
-        case '\r': result += "\\r"; break;
-        case '\t': result += "\\t"; break;
-        default:
-            auto temp = static_cast<unsigned char>(ch);
-            if (temp < 0x20) {
-                auto        fmt = "\\u04X";
-                auto        sz  = std::snprintf(nullptr, 0, fmt, temp);
-                std::string buf(sz + 1, '\0');
-                std::sprintf(&buf[0], fmt, temp);
-                buf.pop_back();
-                result += buf;
+    Columns result;
+    Parser  parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    if (parser.cur_ == parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+    if (*parser.cur_ != '[')
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+    ++parser.cur_;
+    parser.ParseWhitespace();
+    if (*parser.cur_ != ']') {
+        while (true) {
+            result.ParseRecord(parser);
+            parser.ParseWhitespace();
+            if (*parser.cur_ == ',') {
+                ++parser.cur_;
+                parser.ParseWhitespace();
+                continue;
             }
-            else
-                result += ch;
+            if (*parser.cur_ == ']')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
         }
     }
-    result += '\"';
+    ++parser.cur_;
+    parser.ParseWhitespace();
+    if (parser.cur_ != parser.end_)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
     return result;
 } /*}}}*/
 
-inline std::string Value::StringifyArray() const /*{{{*/
+inline Columns Columns::FromNdjson(std::string_view content) /*{{{*/
 {
-    std::string result = "[ ";
-    for (int i = 0; i < std::get<ArrayUPtr>(data_)->size(); i++) {
-        if (i > 0)
-            result += ", ";
-        result += std::get<ArrayUPtr>(data_)->at(i).Stringify();
+    Columns result;
+    Parser  parser(content.begin(), content.end());
+    parser.ParseWhitespace();
+    while (parser.cur_ != parser.end_) {
+        result.ParseRecord(parser);
+        /* the next record must start on a new line */
+        bool newline = false;
+        while (parser.cur_ != parser.end_ && (*parser.cur_ == ' ' || *parser.cur_ == '\t' ||
+                                              *parser.cur_ == '\r' || *parser.cur_ == '\n'))
+            newline |= *parser.cur_++ == '\n';
+        if (parser.cur_ != parser.end_ && !newline)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
     }
-    result += " ]";
     return result;
 } /*}}}*/
 
-inline std::string Value::StringifyObject() const /*{{{*/
+inline Columns Columns::FromValue(Value const& val) /*{{{*/
 {
-    std::string result = "{ ";
-    int         i      = 0;
-    for (auto const& [key, val] : *(std::get<ObjectUPtr>(data_))) {
-        if (i > 0)
-            result += ", ";
-        result += StringifyString(key) + ':' + val.Stringify();
-        i++;
-    }
-    result += " }";
-    return result;
+    if (val.GetType() != Value::TYPE::ARRAY)
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+    return FromJson(val.Stringify());
 } /*}}}*/
 
-inline bool Value::operator==(bool rhs) const /*{{{*/
+inline Column const* Columns::Find(std::string_view name) const /*{{{*/
 {
-    // `if (Value == true) ` will use this, rather than Implicit transformation
-    return static_cast<bool>(*this) == rhs;
+    auto it = index_.find(std::string(name));
+    return it == index_.end() ? nullptr : &columns_[it->second];
 } /*}}}*/
 
-inline bool Value::operator==(Value const& rhs) const /*{{{*/
+inline size_t Columns::FindColumn(std::string_view key, size_t hint) /*{{{*/
 {
-    if (type_ != rhs.type_)
-        return false;
-    if (type_ == TYPE::INVALID)
-        return std::get<PARSE_ERROR>(data_) == std::get<PARSE_ERROR>(rhs.data_);
-    if (type_ == TYPE::TRUE || type_ == TYPE::FALSE || type_ == TYPE::NUL)
-        return true;
-    if (type_ == TYPE::STRING || type_ == TYPE::NUMBER)
-        return data_ == rhs.data_;
-    if (type_ == TYPE::ARRAY)
-        return *std::get<ArrayUPtr>(data_) == *std::get<ArrayUPtr>(rhs.data_);
-    return *std::get<ObjectUPtr>(data_) == *std::get<ObjectUPtr>(rhs.data_);
+    /* records usually repeat the key order of the previous one */
+    if (hint < columns_.size() && columns_[hint].name_ == key)
+        return hint;
+    auto [it, added] = index_.try_emplace(std::string(key), columns_.size());
+    if (added) {
+        auto& column = columns_.emplace_back(std::string(key));
+        for (size_t row = 0; row < rows_; row++)
+            column.Append(Column::TYPE::NUL, {});
+    }
+    return it->second;
 } /*}}}*/
 
-inline bool Value::operator!=(Value const& rhs) const /*{{{*/
+inline void Columns::ParseRecord(Parser& parser) /*{{{*/
 {
-    return !(this->operator==(rhs));
+    auto& cur = parser.cur_;
+    if (*cur != '{')
+        throw DecodeException::ConstructWithErrorCode<DECODE_ERROR::UNSUPPORTED_TYPE>();
+    ++cur;
+    parser.ParseWhitespace();
+    size_t hint = 0;
+    if (*cur != '}') {
+        while (true) {
+            if (*cur != '\"')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+            ++cur;
+            auto& column = columns_[FindColumn(parser.ParseStringView(), hint)];
+            hint         = &column - columns_.data() + 1;
+            /* later duplicates win */
+            if (column.size() > rows_)
+                column.PopBack();
+            parser.ParseWhitespace();
+            if (*cur != ':')
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+            ++cur;
+            parser.ParseWhitespace();
+            auto             value_begin = cur;
+            std::string_view str;
+            Column::TYPE     type;
+            int64_t          integer;
+            switch (*cur) {
+            case 'n': type = Column::TYPE::NUL; break;
+            case 't':
+            case 'f': type = Column::TYPE::BOOL; break;
+            case '\"': type = Column::TYPE::STRING; break;
+            case '[':
+            case '{': type = Column::TYPE::JSON; break;
+            default: type = Column::TYPE::DOUBLE;
+            }
+            if (type == Column::TYPE::STRING) {
+                ++cur;
+                str = parser.ParseStringView();
+            }
+            else
+                parser.SkipValue();
+            std::string_view text(&*value_begin, static_cast<size_t>(cur - value_begin));
+            if (type == Column::TYPE::DOUBLE && Column::ToInt64(text, integer))
+                type = Column::TYPE::INT64;
+            column.Append(type, text, str);
+            parser.ParseWhitespace();
+            if (*cur == ',') {
+                ++cur;
+                parser.ParseWhitespace();
+                continue;
+            }
+            if (*cur == '}')
+                break;
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        }
+    }
+    ++cur;
+    ++rows_;
+    /* keys absent from the record */
+    for (auto& column : columns_)
+        if (column.size() < rows_)
+            column.Append(Column::TYPE::NUL, {});
 } /*}}}*/
 
-inline Value::operator bool() const /*{{{*/
+/* NOTE: FORMATTER IMPLEMENTATION */
+inline std::string Formatter::Minify(std::string_view content) /*{{{*/
 {
-    return type_ == TYPE::INVALID ? false : true;
+    Formatter   formatter(STYLE::COMPACT);
+    std::string result;
+    result.reserve(content.size());
+    formatter.Feed(content, result);
+    formatter.Finish();
+    return result;
 } /*}}}*/
 
-inline Value& Value::operator[](size_t index) const /*{{{*/
+inline std::string Formatter::Prettify(std::string_view content, size_t indent) /*{{{*/
 {
-    if (type_ == TYPE::ARRAY) {
-        auto const& uptr = std::get<ArrayUPtr>(data_);
-        if (index >= uptr->size())
-            throw AccessException("ARRAY_INDEX_OUT_OF_RANGE");
-        return (*uptr)[index];
-    }
-    throw AccessException("VALUE_NOT_ARRAY");
+    Formatter   formatter(STYLE::PRETTY, indent);
+    std::string result;
+    result.reserve(content.size() + content.size() / 2);
+    formatter.Feed(content, result);
+    formatter.Finish();
+    return result;
 } /*}}}*/
 
-inline Value& Value::operator[](std::string const& key) const /*{{{*/
+inline void Formatter::Feed(std::string_view chunk, std::string& out) /*{{{*/
 {
-    if (type_ == TYPE::OBJECT) {
-        auto const& uptr = std::get<ObjectUPtr>(data_);
-        return (*uptr)[key];
+    size_t pos = 0;
+    try {
+        while (pos < chunk.size()) {
+            char ch = chunk[pos];
+            if (token_ == TOKEN::STRING) {
+                pos += FeedString(chunk.data() + pos, chunk.size() - pos, out);
+                continue;
+            }
+            if (token_ == TOKEN::NUMBER) {
+                if (FeedNumber(ch)) {
+                    out += ch;
+                    pos++;
+                    continue;
+                }
+            }
+            else if (token_ == TOKEN::LITERAL) {
+                FeedLiteral(ch);
+                out += ch;
+                pos++;
+                continue;
+            }
+            if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r')
+                FeedStructural(ch, out);
+            pos++;
+        }
     }
-    throw AccessException("VALUE_NOT_OBJECT");
-} /*}}}*/
-
-inline Value& Value::operator[](char const* key) const /*{{{*/
-{
-    if (type_ == TYPE::OBJECT) {
-        auto const& uptr = std::get<ObjectUPtr>(data_);
-        return (*uptr)[key];
+    catch (ParseException& e) {
+        e.SetOffset(offset_ + pos);
+        *this = Formatter(style_, indent_);
+        throw;
     }
-    throw AccessException("VALUE_NOT_OBJECT");
+    offset_ += chunk.size();
 } /*}}}*/
 
-/* NOTE: PARSER IMPLEMENTATION */
-inline Value Parser::Parse(std::string_view content) /*{{{*/
-{
-    return Parser(content.begin(), content.end()).Parse();
-} /*}}}*/
-
-inline void Parser::ParseWhitespace() /*{{{*/
+inline void Formatter::Finish() /*{{{*/
 {
-    while (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\n' || *cur_ == '\r')
-        cur_++;
+    Formatter state = std::move(*this);
+    *this           = Formatter(state.style_, state.indent_);
+    try {
+        if (state.token_ == TOKEN::NUMBER) {
+            /* a number ends with the content, unless it stops after '-', '.', 'e' or a sign */
+            if (state.number_ == NUMBER::MINUS || state.number_ == NUMBER::DOT ||
+                state.number_ == NUMBER::EXP_MARK || state.number_ == NUMBER::EXP_SIGN)
+                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+            state.token_ = TOKEN::NONE;
+            state.EndValue();
+        }
+        if (state.token_ == TOKEN::STRING)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
+        if (state.token_ == TOKEN::LITERAL)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        if (state.expect_ == EXPECT::END)
+            return;
+        if (state.stack_.empty())
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
+        /* the content ends inside a container, report what the parser would at its end */
+        std::string rest;
+        state.FeedStructural('\0', rest);
+    }
+    catch (ParseException& e) {
+        e.SetOffset(state.offset_);
+        throw;
+    }
 } /*}}}*/
 
-template<char lower, char upper> /*{{{*/
-inline bool Parser::IsDigital(char ch)
+inline size_t Formatter::FeedString(char const* data, size_t size, std::string& out) /*{{{*/
 {
-    /* parse number helper */
-    return ch >= lower && ch <= upper;
+    size_t pos = 0;
+    if (escape_ == 0 && !low_) {
+        /* the body up to the next quote, backslash or control character in one append */
+        pos = Parser::ScanPlain(data, size);
+        out.append(data, pos);
+        if (pos == size)
+            return pos;
+    }
+    char ch = data[pos];
+    if (escape_ != 0 || low_)
+        FeedEscape(ch);
+    else if (ch == '\\')
+        escape_ = 1;
+    else if (ch == '\"') {
+        token_ = TOKEN::NONE;
+        if (key_)
+            expect_ = EXPECT::COLON;
+        else
+            EndValue();
+    }
+    else
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
+    out += ch;
+    return pos + 1;
 } /*}}}*/
 
-inline bool Parser::IsInvalidChar(char ch) /*{{{*/
+inline void Formatter::FeedEscape(char ch) /*{{{*/
 {
-    /* parse number helper */
-    // unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
-    // '\x22' is '\"' , '\x5C' is '\\' , they will be deal, so the invalid char is less than
-    // '\x20' unsigned char : range[0,255], signed char : range[-127,127]
-    // When calulate char with number should static_cast
-    // Because char could be unsigned or signed in different compiler
-    return static_cast<unsigned char>(ch) < '\x20';
+    if (escape_ == 0) {
+        /* after a high surrogate */
+        if (ch != '\\')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+        escape_ = 1;
+        return;
+    }
+    if (escape_ == 1) {
+        if (ch == 'u') {
+            escape_  = 2;
+            unicode_ = 0;
+            return;
+        }
+        if (low_)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+        if (std::strchr("\"\\/bfnrt", ch) == nullptr || ch == '\0')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
+        escape_ = 0;
+        return;
+    }
+    int digit = '0' <= ch && ch <= '9'   ? ch - '0'
+                : 'a' <= ch && ch <= 'f' ? ch - 'a' + 10
+                : 'A' <= ch && ch <= 'F' ? ch - 'A' + 10
+                                         : -1;
+    if (digit < 0)
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_HEX>();
+    unicode_ = static_cast<char16_t>(unicode_ << 4 | digit);
+    if (++escape_ <= 5)
+        return;
+    escape_ = 0;
+    /* a low surrogate is only valid right after a high one */
+    if (low_ != (0xDC00 <= unicode_ && unicode_ <= 0xDFFF))
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
+    low_ = !low_ && 0xD800 <= unicode_ && unicode_ <= 0xDBFF;
 } /*}}}*/
-
-inline char16_t Parser::ParseStringHex4() /*{{{*/
-{
-    /* parse unicode helper */
-    char16_t surrogate = 0;
-    for (int i = 0; i < 4; i++) {
-        surrogate <<= 4;
-        if ('0' <= *cur_ && *cur_ <= '9')
-            surrogate |= *cur_ - '0';
-        else if ('a' <= *cur_ && *cur_ <= 'f')
-            surrogate |= *cur_ - ('a' - 10);
-        else if ('A' <= *cur_ && *cur_ <= 'F')
-            surrogate |= *cur_ - ('A' - 10);
-        else
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_HEX>();
-        ++cur_;
+
+inline bool Formatter::FeedNumber(char ch) /*{{{*/
+{
+    bool digit = '0' <= ch && ch <= '9';
+    switch (number_) {
+    case NUMBER::MINUS:
+        if (!digit)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        number_ = ch == '0' ? NUMBER::ZERO : NUMBER::INT;
+        return true;
+    case NUMBER::ZERO:
+    case NUMBER::INT:
+    case NUMBER::FRAC:
+        if (digit && number_ != NUMBER::ZERO)
+            return true;
+        if (ch == '.' && number_ != NUMBER::FRAC)
+            return number_ = NUMBER::DOT, true;
+        if (ch == 'e' || ch == 'E')
+            return number_ = NUMBER::EXP_MARK, true;
+        break;
+    case NUMBER::DOT:
+        if (!digit)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        return number_ = NUMBER::FRAC, true;
+    case NUMBER::EXP_MARK:
+        if (ch == '+' || ch == '-')
+            return number_ = NUMBER::EXP_SIGN, true;
+        [[fallthrough]];
+    case NUMBER::EXP_SIGN:
+        if (!digit)
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        return number_ = NUMBER::EXP, true;
+    case NUMBER::EXP:
+        if (digit)
+            return true;
+        break;
     }
-    return surrogate;
+    token_ = TOKEN::NONE;
+    EndValue();
+    return false;
 } /*}}}*/
 
-inline std::string Parser::ParseStringUtf8() /*{{{*/
+inline void Formatter::FeedLiteral(char ch) /*{{{*/
 {
-    std::u16string u16;
-    char16_t       surrogate_h = ParseStringHex4();
-    u16 += surrogate_h;
-    if (0xD800 <= surrogate_h && surrogate_h <= 0xDBFF) {
-        if (cur_[0] != '\\' || cur_[1] != 'u')
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
-        cur_ += 2;
-        char16_t surrogate_l = ParseStringHex4();
-        if (surrogate_l < 0xDC00 || 0xDFFF < surrogate_l)
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_UNICODE_SURROGATE>();
-        u16 += surrogate_l;
+    if (ch != literal_[literal_pos_++])
+        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+    if (literal_pos_ == literal_.size()) {
+        token_ = TOKEN::NONE;
+        EndValue();
     }
-    std::string u8_conv =
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}.to_bytes(u16);
-    return u8_conv;
 } /*}}}*/
 
-inline Value Parser::Parse() /*{{{*/
+inline void Formatter::FeedStructural(char ch, std::string& out) /*{{{*/
 {
-    ParseWhitespace();
-    if (cur_ == end_)
-        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::EXPECT_VALUE>();
-    Value result = ParseValue();
-    ParseWhitespace();
-    if (cur_ != end_)
+    switch (expect_) {
+    case EXPECT::VALUE_OR_CLOSE:
+        if (ch == ']')
+            return Close(ch, out);
+        [[fallthrough]];
+    case EXPECT::VALUE: return BeginValue(ch, out);
+    case EXPECT::KEY_OR_CLOSE:
+        if (ch == '}')
+            return Close(ch, out);
+        [[fallthrough]];
+    case EXPECT::KEY:
+        if (ch != '\"')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
+        NewLine(stack_.size(), out);
+        out += ch;
+        token_ = TOKEN::STRING;
+        key_   = true;
+        return;
+    case EXPECT::COLON:
+        if (ch != ':')
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
+        out += style_ == STYLE::PRETTY ? ": " : ":";
+        expect_ = EXPECT::VALUE;
+        return;
+    case EXPECT::COMMA_OR_CLOSE:
+        if (stack_.back() == '[' && ch != ',' && ch != ']')
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+        if (stack_.back() == '{' && ch != ',' && ch != '}')
+            throw ParseException::ConstructWithErrorCode<
+                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+        if (ch != ',')
+            return Close(ch, out);
+        out += ch;
+        expect_ = stack_.back() == '[' ? EXPECT::VALUE : EXPECT::KEY;
+        return;
+    case EXPECT::END:
         throw ParseException::ConstructWithErrorCode<PARSE_ERROR::ROOT_NOT_SINGULAR>();
-    return result;
+    }
 } /*}}}*/
 
-inline Value Parser::ParseValue() /*{{{*/
+inline void Formatter::BeginValue(char ch, std::string& out) /*{{{*/
 {
-    Value result;
-    switch (*cur_) {
-    case 'n': ++cur_, ParseNull(result); break;
-    case 't': ++cur_, ParseTrue(result); break;
-    case 'f': ++cur_, ParseFalse(result); break;
-    case '\"': ++cur_, ParseString(result); break;
-    case '[': ++cur_, ParseArray(result); break;
-    case '{': ++cur_, ParseObject(result); break;
-    default: ParseNumber(result);
+    /* a member value stays on the line of its key */
+    if (!stack_.empty() && stack_.back() == '[')
+        NewLine(stack_.size(), out);
+    switch (ch) {
+    case '\"':
+        token_ = TOKEN::STRING;
+        key_   = false;
+        break;
+    case '[':
+    case '{':
+        stack_ += ch;
+        expect_ = ch == '[' ? EXPECT::VALUE_OR_CLOSE : EXPECT::KEY_OR_CLOSE;
+        break;
+    case 't': literal_ = "true", literal_pos_ = 1, token_ = TOKEN::LITERAL; break;
+    case 'f': literal_ = "false", literal_pos_ = 1, token_ = TOKEN::LITERAL; break;
+    case 'n': literal_ = "null", literal_pos_ = 1, token_ = TOKEN::LITERAL; break;
+    default:
+        if (ch != '-' && (ch < '0' || '9' < ch))
+            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+        number_ = NUMBER::MINUS;
+        token_  = TOKEN::NUMBER;
+        if (ch != '-')
+            FeedNumber(ch);
     }
-    return result;
+    out += ch;
 } /*}}}*/
 
-inline void Parser::ParseNull(Value& val) /*{{{*/
+inline void Formatter::Close(char ch, std::string& out) /*{{{*/
 {
-    if (cur_[0] == 'u' && cur_[1] == 'l' && cur_[2] == 'l') {
-        cur_ += 3;
-        val.SetNull();
-        return;
-    }
-    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+    /* an empty container stays on its line */
+    if (expect_ == EXPECT::COMMA_OR_CLOSE)
+        NewLine(stack_.size() - 1, out);
+    out += ch;
+    stack_.pop_back();
+    EndValue();
 } /*}}}*/
 
-inline void Parser::ParseTrue(Value& val) /*{{{*/
+inline void Formatter::EndValue() /*{{{*/
 {
-    if (cur_[0] == 'r' && cur_[1] == 'u' && cur_[2] == 'e') {
-        cur_ += 3;
-        val.SetBool(true);
-        return;
-    }
-    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
+    expect_ = stack_.empty() ? EXPECT::END : EXPECT::COMMA_OR_CLOSE;
 } /*}}}*/
 
-inline void Parser::ParseFalse(Value& val) /*{{{*/
+inline void Formatter::NewLine(size_t depth, std::string& out) const /*{{{*/
 {
-    if (cur_[0] == 'a' && cur_[1] == 'l' && cur_[2] == 's' && cur_[3] == 'e') {
-        cur_ += 4;
-        val.SetBool(false);
-        return;
+    if (style_ == STYLE::PRETTY) {
+        out += '\n';
+        out.append(depth * indent_, ' ');
     }
-    throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
 } /*}}}*/
 
-inline void Parser::ParseNumber(Value& val) /*{{{*/
+/* NOTE: PATCH IMPLEMENTATION */
+inline Value Patch::Diff(Value const& from, Value const& to) /*{{{*/
 {
-    auto number_begin = cur_;
-    if (*cur_ == '-')
-        ++cur_;
-    if (*cur_ == '0')
-        ++cur_;
-    else if (IsDigital<'1', '9'>(*cur_)) {
-        ++cur_;
-        while (IsDigital<'0', '9'>(*cur_))
-            ++cur_;
+    Array       ops;
+    std::string path;
+    DiffInto(from, to, path, ops);
+    return ops;
+} /*}}}*/
+
+inline void Patch::DiffInto(Value const& from, Value const& to, std::string& path,
+                            Array& ops) /*{{{*/
+{
+    auto type = from.GetType();
+    if (type != to.GetType() || (type != Value::TYPE::ARRAY && type != Value::TYPE::OBJECT)) {
+        if (from != to)
+            AddOperation(ops, "replace", path, &to);
+        return;
     }
-    else
-        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
-    if (*cur_ == '.') {
-        ++cur_;
-        if (!IsDigital<'0', '9'>(*cur_))
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
-        while (IsDigital<'0', '9'>(*cur_))
-            cur_++;
+    size_t length = path.size();
+    if (type == Value::TYPE::OBJECT) {
+        from.ForEachMember([&](std::string_view key, Value const& member) {
+            AppendToken(path, key);
+            if (auto other = to.Find(key))
+                DiffInto(member, *other, path, ops);
+            else
+                AddOperation(ops, "remove", path, nullptr);
+            path.resize(length);
+        });
+        to.ForEachMember([&](std::string_view key, Value const& member) {
+            if (from.Find(key) == nullptr) {
+                AppendToken(path, key);
+                AddOperation(ops, "add", path, &member);
+                path.resize(length);
+            }
+        });
+        return;
     }
-    if (*cur_ == 'e' || *cur_ == 'E') {
-        ++cur_;
-        if (*cur_ == '+' || *cur_ == '-')
-            ++cur_;
-        if (!IsDigital<'0', '9'>(*cur_))
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
-        while (IsDigital<'0', '9'>(*cur_))
-            ++cur_;
+    auto const& lhs = from.GetArrayView();
+    auto const& rhs = to.GetArrayView();
+    /* the equal head and tail are skipped, the rest is diffed in place and the difference in
+       length removed from or added to its end */
+    size_t head = 0;
+    while (head < lhs.size() && head < rhs.size() && lhs[head] == rhs[head])
+        head++;
+    size_t tail = 0;
+    while (tail < lhs.size() - head && tail < rhs.size() - head &&
+           lhs[lhs.size() - 1 - tail] == rhs[rhs.size() - 1 - tail])
+        tail++;
+    size_t lhs_end = lhs.size() - tail;
+    size_t rhs_end = rhs.size() - tail;
+    size_t common  = head + std::min(lhs_end - head, rhs_end - head);
+    for (size_t i = head; i < common; i++) {
+        AppendToken(path, std::to_string(i));
+        DiffInto(lhs[i], rhs[i], path, ops);
+        path.resize(length);
+    }
+    /* removed from the last, so the indices before it stay valid */
+    for (size_t i = lhs_end; i > common; i--) {
+        AppendToken(path, std::to_string(common));
+        AddOperation(ops, "remove", path, nullptr);
+        path.resize(length);
+    }
+    for (size_t i = common; i < rhs_end; i++) {
+        AppendToken(path, std::to_string(i));
+        AddOperation(ops, "add", path, &rhs[i]);
+        path.resize(length);
     }
-    if (number_begin == cur_)
-        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_VALUE>();
-    // Abort: stod() If the converted value would fall out of the range, will throw an out_of_range
-    // exception And std::stod() will throw out_of_range exception when converts subnormal value
-    // https://stackoverflow.com/questions/48086830/stdstod-throws-out-of-range-error-for-a-string-that-should-be-valid
-    //
-    // double n;
-    // try {
-    //     n = std::strtod(cur);
-    // }
-    // catch (std::out_of_range e) {
-    //     throw std::invalid_argument("NUMBER_TOO_BIG");
-    // }
-    double n = std::strtod(std::string(number_begin, cur_).c_str(), nullptr);
-    if (n == HUGE_VAL || n == -HUGE_VAL)
-        throw ParseException::ConstructWithErrorCode<PARSE_ERROR::NUMBER_TOO_BIG>();
-    val.SetNumber(n);
 } /*}}}*/
 
-inline std::string Parser::ParseString() /*{{{*/
+inline void Patch::AddOperation(Array& ops, char const* op, std::string const& path,
+                                Value const* val) /*{{{*/
 {
-    std::string s;
-    while (true) {
-        if (cur_ == end_)
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
-        /* deal with invalid char */
-        if (IsInvalidChar(*cur_))
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
-        if (*cur_ == '\"') {
-            ++cur_;
-            break;
+    Object operation;
+    operation["op"]   = op;
+    operation["path"] = path;
+    if (val != nullptr)
+        operation["value"] = *val;
+    ops.emplace_back(std::move(operation));
+} /*}}}*/
+
+inline void Patch::AppendToken(std::string& path, std::string_view token) /*{{{*/
+{
+    path += '/';
+    for (char ch : token) {
+        if (ch == '~')
+            path += "~0";
+        else if (ch == '/')
+            path += "~1";
+        else
+            path += ch;
+    }
+} /*}}}*/
+
+inline void Patch::Apply(Value& root, Value const& patch) /*{{{*/
+{
+    if (root.IsFrozen())
+        throw AccessException("VALUE_FROZEN");
+    if (patch.GetType() != Value::TYPE::ARRAY)
+        throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
+    size_t index = 0;
+    patch.ForEachItem([&](Value const& op) {
+        try {
+            ApplyOperation(root, op);
         }
-        /* deal with escape */
-        if (*cur_ == '\\') {
-            if (++cur_ == end_)
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
-            switch (*cur_++) {
-            case '\"': s.push_back('\"'); break;
-            case '\\': s.push_back('\\'); break;
-            case '/': s.push_back('/'); break;
-            case 'b': s.push_back('\b'); break;
-            case 'f': s.push_back('\f'); break;
-            case 'n': s.push_back('\n'); break;
-            case 'r': s.push_back('\r'); break;
-            case 't': s.push_back('\t'); break;
-            case 'u':
-            {
-                std::string u8stirng = ParseStringUtf8();
-                s += u8stirng;
-                break;
-            }
-            default:
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
-            }
-            continue;
+        catch (PatchException& e) {
+            e.SetOffset(index);
+            throw;
         }
-        /* deal with unescape char */
-        s.push_back(*cur_++);
-    }
-    return s;
+        index++;
+    });
 } /*}}}*/
 
-inline void Parser::ParseString(Value& val) /*{{{*/
+inline void Patch::ApplyOperation(Value& root, Value const& op) /*{{{*/
 {
-    std::string s;
-    while (true) {
-        if (cur_ == end_)
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_QUOTATION_MARK>();
-        // deal with invalid char
-        if (IsInvalidChar(*cur_))
-            throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_CHAR>();
-        if (*cur_ == '\"') {
-            ++cur_;
-            break;
+    auto member = [&op](char const* key) -> Value const& {
+        Value const* found = op.GetType() == Value::TYPE::OBJECT ? op.Find(key) : nullptr;
+        if (found == nullptr)
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
+        return *found;
+    };
+    auto pointer = [&member](char const* key) {
+        Value const& text = member(key);
+        if (text.GetType() != Value::TYPE::STRING)
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
+        try {
+            return Pointer(text.GetStringView());
         }
-        /* deal with escape */
-        if (*cur_ == '\\') {
-            if (++cur_ == end_)
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
-            switch (*cur_++) {
-            case '\"': s.push_back('\"'); break;
-            case '\\': s.push_back('\\'); break;
-            case '/': s.push_back('/'); break;
-            case 'b': s.push_back('\b'); break;
-            case 'f': s.push_back('\f'); break;
-            case 'n': s.push_back('\n'); break;
-            case 'r': s.push_back('\r'); break;
-            case 't': s.push_back('\t'); break;
-            case 'u':
-            {
-                std::string u8stirng = ParseStringUtf8();
-                s += u8stirng;
-                break;
-            }
-            default:
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::INVALID_STRING_ESCAPE>();
-            }
-            continue;
+        catch (std::invalid_argument const&) {
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
         }
-        /* deal with unescape char */
-        s.push_back(*cur_++);
+    };
+    auto const& name = member("op");
+    if (name.GetType() != Value::TYPE::STRING)
+        throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
+    auto   kind   = name.GetStringView();
+    auto   path   = pointer("path");
+    Value* target = nullptr;
+    if (kind == "add")
+        Add(root, path, member("value"));
+    else if (kind == "remove") {
+        if (!path.Erase(root))
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::PATH_NOT_FOUND>();
     }
-    val.SetString(std::move(s));
-    return;
+    else if (kind == "replace") {
+        if ((target = path.Get(root)) == nullptr)
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::PATH_NOT_FOUND>();
+        *target = member("value");
+    }
+    else if (kind == "test") {
+        if ((target = path.Get(root)) == nullptr)
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::PATH_NOT_FOUND>();
+        if (*target != member("value"))
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::TEST_FAILED>();
+    }
+    else if (kind == "move" || kind == "copy") {
+        auto from = pointer("from");
+        if ((target = from.Get(root)) == nullptr)
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::PATH_NOT_FOUND>();
+        if (kind == "copy") {
+            Add(root, path, *target);
+            return;
+        }
+        /* a value cannot move into itself */
+        auto const& src = from.segments_;
+        auto const& dst = path.segments_;
+        if (src.size() < dst.size() &&
+            std::equal(src.begin(), src.end(), dst.begin(),
+                       [](auto const& l, auto const& r) { return l.key == r.key; }))
+            throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
+        /* a frozen value is not moved from, Erase throws for one under a frozen parent */
+        Value val = target->IsFrozen() ? Value(*target) : std::move(*target);
+        from.Erase(root);
+        Add(root, path, std::move(val));
+    }
+    else
+        throw PatchException::ConstructWithErrorCode<PATCH_ERROR::INVALID_PATCH>();
 } /*}}}*/
 
-inline void Parser::ParseArray(Value& val) /*{{{*/
+inline void Patch::Add(Value& root, Pointer const& path, Value val) /*{{{*/
 {
-    std::vector<Value> result;
-    ParseWhitespace();
-    if (*cur_ != ']') {
-        while (true) {
-            result.emplace_back(ParseValue());
-            ParseWhitespace();
-            if (*cur_ == ',') {
-                ++cur_;
-                ParseWhitespace();
-                continue;
-            }
-            if (*cur_ == ']')
-                break;
-            throw ParseException::ConstructWithErrorCode<
-                PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET>();
+    if (path.segments_.empty()) {
+        root = std::move(val);
+        return;
+    }
+    /* unlike Pointer::Set, an index inserts before the item there */
+    Value* parent = path.GetParent(root);
+    if (parent != nullptr && parent->IsFrozen())
+        throw AccessException("VALUE_FROZEN");
+    auto const& last = path.segments_.back();
+    if (parent != nullptr && parent->GetType() == Value::TYPE::OBJECT) {
+        parent->GetObject()[last.key] = std::move(val);
+        return;
+    }
+    if (parent != nullptr && parent->GetType() == Value::TYPE::ARRAY) {
+        auto& arr = parent->GetArray();
+        if (last.key == "-") {
+            arr.push_back(std::move(val));
+            return;
+        }
+        if (last.is_index && last.index <= arr.size()) {
+            arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(last.index), std::move(val));
+            return;
         }
     }
-    ++cur_;
-    val.SetArray(std::move(result));
-    return;
+    throw PatchException::ConstructWithErrorCode<PATCH_ERROR::PATH_NOT_FOUND>();
 } /*}}}*/
 
-inline void Parser::ParseObject(Value& val) /*{{{*/
+inline Value Patch::MergeDiff(Value const& from, Value const& to) /*{{{*/
 {
-    std::unordered_map<std::string, Value> result;
-    ParseWhitespace();
-    if (*cur_ != '}') {
-        while (true) {
-            if (*cur_ != '\"')
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_KEY>();
-            ++cur_;
-            std::string key = ParseString();
-            ParseWhitespace();
-            if (*cur_ != ':')
-                throw ParseException::ConstructWithErrorCode<PARSE_ERROR::MISS_COLON>();
-            ++cur_;
-            ParseWhitespace();
-            Value val              = ParseValue();
-            result[std::move(key)] = std::move(val);
-            ParseWhitespace();
-            if (*cur_ == ',') {
-                ++cur_;
-                ParseWhitespace();
-                continue;
-            }
-            if (*cur_ == '}')
-                break;
-            throw ParseException::ConstructWithErrorCode<
-                PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET>();
+    if (from.GetType() != Value::TYPE::OBJECT || to.GetType() != Value::TYPE::OBJECT)
+        return to;
+    Object result;
+    from.ForEachMember([&](std::string_view key, Value const&) {
+        if (to.Find(key) == nullptr)
+            result[std::string(key)] = Value();
+    });
+    to.ForEachMember([&](std::string_view key, Value const& member) {
+        Value const* other = from.Find(key);
+        if (other == nullptr)
+            result[std::string(key)] = member;
+        else if (other->GetType() == Value::TYPE::OBJECT &&
+                 member.GetType() == Value::TYPE::OBJECT) {
+            Value nested = MergeDiff(*other, member);
+            if (nested.MemberCount() != 0)
+                result[std::string(key)] = std::move(nested);
         }
+        else if (*other != member)
+            result[std::string(key)] = member;
+    });
+    return result;
+} /*}}}*/
+
+inline void Patch::ApplyMerge(Value& root, Value const& patch) /*{{{*/
+{
+    if (root.IsFrozen())
+        throw AccessException("VALUE_FROZEN");
+    if (patch.GetType() != Value::TYPE::OBJECT) {
+        root = patch;
+        return;
     }
-    ++cur_;
-    val.SetObject(std::move(result));
-    return;
+    if (root.GetType() != Value::TYPE::OBJECT)
+        root = Object();
+    auto& obj = root.GetObject();
+    patch.ForEachMember([&obj](std::string_view key, Value const& member) {
+        if (member.GetType() == Value::TYPE::NUL)
+            obj.erase(std::string(key));
+        else
+            ApplyMerge(obj[std::string(key)], member);
+    });
 } /*}}}*/
 
 } /* namespace tijson */
@@ -0,0 +1,105 @@
+#include "test_utils.h"
+
+static std::string Bytes(std::initializer_list<int> bytes)
+{
+    std::string result;
+    for (auto byte : bytes)
+        result += static_cast<char>(byte);
+    return result;
+}
+
+static tijson::DECODE_ERROR MsgPackError(std::string const& data)
+{
+    try {
+        tijson::MsgPack::Decode(data);
+    }
+    catch (tijson::DecodeException& e) {
+        return e.GetErrorCode();
+    }
+    return tijson::DECODE_ERROR::NO_ERROR;
+}
+
+static tijson::DECODE_ERROR CborError(std::string const& data)
+{
+    try {
+        tijson::Cbor::Decode(data);
+    }
+    catch (tijson::DecodeException& e) {
+        return e.GetErrorCode();
+    }
+    return tijson::DECODE_ERROR::NO_ERROR;
+}
+
+static constexpr char const* kDocument = R"({
+    "n" : null, "t" : true, "f" : false,
+    "i" : [ 0, 1, 127, 128, 255, 256, 65535, 65536, 4294967296, -1, -32, -33, -129, -32769,
+            -2147483649, 9007199254740992, -9007199254740992 ],
+    "d" : [ 0.5, -0.0, 3.1416, 1e300, -1.5e-300, 4.9406564584124654E-324 ],
+    "s" : [ "", "Hello\u0000World", "€", "0123456789012345678901234567890123456789" ],
+    "a" : [ [ ], [ [ ] ], { } ],
+    "o" : { "1" : 1, "2" : { "3" : [ "4" ] } }
+})";
+
+TEST(BINARY, MSGPACK_ROUND_TRIP)
+{
+    auto v = tijson::Parse(kDocument);
+    EXPECT_EQ(tijson::MsgPack::Decode(tijson::MsgPack::Encode(v)), v);
+
+    tijson::Value large(tijson::Array{});
+    for (int i = 0; i < 70000; i++)
+        large.GetArray().emplace_back(i % 3 ? tijson::Value(std::to_string(i)) : tijson::Value(i));
+    large.GetArray().emplace_back(std::string(70000, 'x'));
+    EXPECT_EQ(tijson::MsgPack::Decode(tijson::MsgPack::Encode(large)), large);
+}
+
+TEST(BINARY, MSGPACK_ENCODING)
+{
+    EXPECT_EQ(tijson::MsgPack::Encode(tijson::Parse("[1,-1,300,-200,1.5,0.1,\"ab\",null,true]")),
+              Bytes({0x99, 0x01, 0xFF, 0xCD, 0x01, 0x2C, 0xD1, 0xFF, 0x38, 0xCA, 0x3F, 0xC0, 0x00,
+                     0x00, 0xCB, 0x3F, 0xB9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A, 0xA2, 'a', 'b',
+                     0xC0, 0xC3}));
+    EXPECT_EQ(tijson::MsgPack::Decode(Bytes({0x81, 0xA1, 'k', 0xD3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                             0xFF, 0xFF, 0xFE})),
+              tijson::Parse(R"({ "k" : -2 })"));
+    EXPECT_EQ(tijson::MsgPack::Decode(Bytes({0xC4, 0x01, 'x'})), tijson::Value("x"));
+}
+
+TEST(BINARY, MSGPACK_ERROR)
+{
+    EXPECT_EQ(MsgPackError(""), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(MsgPackError(Bytes({0x92, 0x01})), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(MsgPackError(Bytes({0xA3, 'a'})), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(MsgPackError(Bytes({0xDD, 0xFF, 0xFF, 0xFF, 0xFF})),
+              tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(MsgPackError(Bytes({0xC1})), tijson::DECODE_ERROR::UNSUPPORTED_TYPE);
+    EXPECT_EQ(MsgPackError(Bytes({0x81, 0x01, 0x01})), tijson::DECODE_ERROR::INVALID_KEY);
+    EXPECT_EQ(MsgPackError(Bytes({0xC0, 0xC0})), tijson::DECODE_ERROR::TRAILING_DATA);
+}
+
+TEST(BINARY, CBOR_ROUND_TRIP)
+{
+    auto v = tijson::Parse(kDocument);
+    EXPECT_EQ(tijson::Cbor::Decode(tijson::Cbor::Encode(v)), v);
+}
+
+TEST(BINARY, CBOR_ENCODING)
+{
+    EXPECT_EQ(tijson::Cbor::Encode(tijson::Parse("[1,-1,300,-500,1.5,\"ab\",null,false]")),
+              Bytes({0x88, 0x01, 0x20, 0x19, 0x01, 0x2C, 0x39, 0x01, 0xF3, 0xFA, 0x3F, 0xC0, 0x00,
+                     0x00, 0x62, 'a', 'b', 0xF6, 0xF4}));
+    // indefinite length containers and strings, half floats and tags
+    EXPECT_EQ(tijson::Cbor::Decode(Bytes({0xBF, 0x61, 'a', 0x9F, 0xF9, 0x3C, 0x00, 0xF9, 0xC4,
+                                          0x00, 0xFF, 0x7F, 0x61, 'b', 0x61, 'c', 0xFF, 0xC1,
+                                          0x1A, 0x00, 0x00, 0x00, 0x10, 0xFF})),
+              tijson::Parse(R"({ "a" : [ 1, -4 ], "bc" : 16 })"));
+}
+
+TEST(BINARY, CBOR_ERROR)
+{
+    EXPECT_EQ(CborError(""), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(CborError(Bytes({0x82, 0x01})), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(CborError(Bytes({0x9F, 0x01})), tijson::DECODE_ERROR::UNEXPECTED_END);
+    EXPECT_EQ(CborError(Bytes({0x1C})), tijson::DECODE_ERROR::UNSUPPORTED_TYPE);
+    EXPECT_EQ(CborError(Bytes({0xA1, 0x01, 0x01})), tijson::DECODE_ERROR::INVALID_KEY);
+    EXPECT_EQ(CborError(Bytes({0xF6, 0xF6})), tijson::DECODE_ERROR::TRAILING_DATA);
+}
@@ -0,0 +1,138 @@
+#include "test_utils.h"
+
+namespace shop {
+struct Item
+{
+    std::string sku;
+    int         count = 0;
+};
+TIJSON_DEFINE(Item, sku, count)
+
+struct Order
+{
+    int64_t                       id    = 0;
+    double                        price = 0;
+    bool                          paid  = false;
+    std::vector<Item>             items;
+    std::optional<std::string>    note;
+    std::map<std::string, double> tags;
+    tijson::Value                 extra;
+};
+TIJSON_DEFINE(Order, id, price, paid, items, note, tags, extra)
+}   // namespace shop
+
+TEST(BIND, PARSE_INTO)
+{
+    shop::Order order;
+    auto        err = tijson::ParseInto(R"({
+        "id" : 42, "price" : 9.5, "paid" : true,
+        "items" : [ { "sku" : "a-1", "count" : 2 }, { "count" : 1, "sku" : "b¢" } ],
+        "note" : null,
+        "tags" : { "x" : 1, "y" : 2.5 },
+        "extra" : [ null, { "k" : "v" } ]
+    })",
+                                    order);
+    EXPECT_EQ(err, tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(order.id, 42);
+    EXPECT_EQ(order.price, 9.5);
+    EXPECT_EQ(order.paid, true);
+    EXPECT_EQ(order.items.size(), 2);
+    EXPECT_EQ(order.items[0].sku, "a-1");
+    EXPECT_EQ(order.items[0].count, 2);
+    EXPECT_EQ(order.items[1].sku, "b\xC2\xA2");
+    EXPECT_EQ(order.items[1].count, 1);
+    EXPECT_EQ(order.note.has_value(), false);
+    EXPECT_EQ(order.tags["x"], 1);
+    EXPECT_EQ(order.tags["y"], 2.5);
+    EXPECT_EQ(order.extra, tijson::Parse(R"([ null, { "k" : "v" } ])"));
+
+    tijson::ParseInto(R"({ "note" : "fragile" })", order);
+    EXPECT_EQ(order.note.value(), "fragile");
+}
+
+TEST(BIND, SKIP_UNKNOWN_KEY)
+{
+    shop::Item item;
+    auto       err = tijson::ParseInto(
+        R"({ "x" : { "y" : [ 1, "\"}", true, false, null ] }, "sku" : "s", "xz" : 1e3 })",
+        item);
+    EXPECT_EQ(err, tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(item.sku, "s");
+    EXPECT_EQ(tijson::ParseInto(R"({ "x" : [ 1, 2 }, "sku" : "s" })", item),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET);
+    EXPECT_EQ(tijson::ParseInto(R"({ "x" : "\q" })", item),
+              tijson::PARSE_ERROR::INVALID_STRING_ESCAPE);
+}
+
+TEST(BIND, ERROR_CODE)
+{
+    shop::Item item;
+    EXPECT_EQ(tijson::ParseInto("", item), tijson::PARSE_ERROR::EXPECT_VALUE);
+    EXPECT_EQ(tijson::ParseInto("{} x", item), tijson::PARSE_ERROR::ROOT_NOT_SINGULAR);
+    EXPECT_EQ(tijson::ParseInto("[]", item), tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto(R"({ "sku" : 1 })", item), tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto(R"({ "count" : 1.5 })", item),
+              tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto(R"({ "count" : 1e10 })", item),
+              tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto(R"({ "count" : "1" })", item),
+              tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto(R"({ "sku" "s" })", item), tijson::PARSE_ERROR::MISS_COLON);
+
+    tijson::ParseException e("");
+    try {
+        tijson::Parser::ParseInto(R"({ "sku" : [] })", item);
+    }
+    catch (tijson::ParseException& err) {
+        e = err;
+    }
+    EXPECT_STREQ(e.what(), "BIND_TYPE_MISMATCH");
+}
+
+TEST(BIND, LARGE_INTEGER)
+{
+    /* 64-bit integers beyond 2^53 are bound exactly, not through a double */
+    int64_t i = 0;
+    EXPECT_EQ(tijson::ParseInto("1234567890123456789", i), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(i, 1234567890123456789);
+    EXPECT_EQ(tijson::ParseInto("-9223372036854775808", i), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(i, std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(tijson::ParseInto("9223372036854775808", i), tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto("1.2345678901234567e18", i),
+              tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto("1.5e3", i), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(i, 1500);
+
+    uint64_t u = 0;
+    EXPECT_EQ(tijson::ParseInto("18446744073709551615", u), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(u, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(tijson::ParseInto("-0", u), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(u, 0);
+    EXPECT_EQ(tijson::ParseInto("-1", u), tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+
+    int8_t small = 0;
+    EXPECT_EQ(tijson::ParseInto("128", small), tijson::PARSE_ERROR::BIND_TYPE_MISMATCH);
+    EXPECT_EQ(tijson::ParseInto("-128", small), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(small, -128);
+}
+
+TEST(BIND, STRINGIFY)
+{
+    shop::Order order;
+    order.id    = 7;
+    order.price = 1.25;
+    order.items = {{"a\"1", 3}};
+    order.tags  = {{"k", 2}};
+    order.extra = tijson::Object({{"v", {1, "x"}}});
+    auto str    = tijson::Stringify(order);
+    EXPECT_EQ(tijson::Parse(str),
+              tijson::Parse(R"({ "id" : 7, "price" : 1.25, "paid" : false,
+                                 "items" : [ { "sku" : "a\"1", "count" : 3 } ],
+                                 "note" : null, "tags" : { "k" : 2 },
+                                 "extra" : { "v" : [ 1, "x" ] } })"));
+
+    shop::Order round_trip;
+    EXPECT_EQ(tijson::ParseInto(str, round_trip), tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(tijson::Stringify(round_trip), str);
+    EXPECT_EQ(tijson::Stringify(std::vector<bool>{true, false}), "[ true, false ]");
+}
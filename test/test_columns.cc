@@ -0,0 +1,118 @@
+#include "test_utils.h"
+
+using TYPE = tijson::Column::TYPE;
+
+static char const* records = R"([
+    { "id" : 1, "price" : 2, "name" : "a", "ok" : true, "tags" : [ 1 ], "any" : 1 },
+    { "id" : 2, "price" : 2.5, "name" : "b\n", "ok" : false, "tags" : {}, "any" : "x" },
+    { "price" : null, "id" : 3, "extra" : "e", "id" : 4 },
+    { "id" : -5, "price" : 1e1, "name" : "", "any" : null }
+])";
+
+TEST(COLUMNS, FROM_JSON)
+{
+    auto columns = tijson::Columns::FromJson(records);
+    EXPECT_EQ(columns.rows(), 4);
+    EXPECT_EQ(columns.GetColumns().size(), 7);
+    EXPECT_EQ(columns.GetColumns()[6].GetName(), "extra");
+    EXPECT_EQ(columns.Find("none"), nullptr);
+
+    auto& id = *columns.Find("id");
+    EXPECT_EQ(id.GetType(), TYPE::INT64);
+    EXPECT_EQ(id.GetInt64s(), (std::vector<int64_t>{1, 2, 4, -5}));
+    EXPECT_EQ(id.GetValidity(), (std::vector<uint64_t>{0b1111}));
+
+    /* integers are widened to double by the first other number */
+    auto& price = *columns.Find("price");
+    EXPECT_EQ(price.GetType(), TYPE::DOUBLE);
+    EXPECT_EQ(price.GetDoubles(), (std::vector<double>{2, 2.5, 0, 10}));
+    EXPECT_FALSE(price.IsValid(2));
+
+    auto& name = *columns.Find("name");
+    EXPECT_EQ(name.GetType(), TYPE::STRING);
+    EXPECT_EQ(name.GetString(1), "b\n");
+    EXPECT_EQ(name.GetString(2), "");
+    EXPECT_FALSE(name.IsValid(2));
+    EXPECT_TRUE(name.IsValid(3));
+    EXPECT_EQ(name.GetOffsets(), (std::vector<size_t>{0, 1, 3, 3, 3}));
+
+    auto& ok = *columns.Find("ok");
+    EXPECT_EQ(ok.GetType(), TYPE::BOOL);
+    EXPECT_EQ(ok.GetBools(), (std::vector<uint8_t>{1, 0, 0, 0}));
+    EXPECT_EQ(ok.GetValidity()[0], 0b0011);
+
+    /* arrays, objects and mixed types keep their json text */
+    auto& tags = *columns.Find("tags");
+    EXPECT_EQ(tags.GetType(), TYPE::JSON);
+    EXPECT_EQ(tags.GetString(0), "[ 1 ]");
+    EXPECT_EQ(tags.GetString(1), "{}");
+    auto& any = *columns.Find("any");
+    EXPECT_EQ(any.GetType(), TYPE::JSON);
+    EXPECT_EQ(any.GetString(0), "1");
+    EXPECT_EQ(any.GetString(1), "\"x\"");
+    EXPECT_FALSE(any.IsValid(3));
+
+    auto& extra = *columns.Find("extra");
+    EXPECT_EQ(extra.GetValidity()[0], 0b0100);
+    EXPECT_EQ(extra.size(), 4);
+}
+
+TEST(COLUMNS, FROM_NDJSON)
+{
+    auto columns = tijson::Columns::FromNdjson("{ \"a\" : 1 }\n\n{ \"b\" : \"x\" }\r\n{}\n");
+    EXPECT_EQ(columns.rows(), 3);
+    EXPECT_EQ(columns.Find("a")->GetInt64s(), (std::vector<int64_t>{1, 0, 0}));
+    EXPECT_EQ(columns.Find("b")->GetString(1), "x");
+    EXPECT_EQ(tijson::Columns::FromNdjson("").rows(), 0);
+    EXPECT_EQ(tijson::Columns::FromNdjson("{\"p\":1.5}\n{\"p\":2}").Find("p")->GetDoubles(),
+              (std::vector<double>{1.5, 2}));
+    EXPECT_THROW(tijson::Columns::FromNdjson("{} {}"), tijson::ParseException);
+}
+
+TEST(COLUMNS, FROM_VALUE)
+{
+    auto columns = tijson::Columns::FromValue(tijson::Parse(records));
+    EXPECT_EQ(columns.rows(), 4);
+    EXPECT_EQ(columns.Find("id")->GetInt64s(), (std::vector<int64_t>{1, 2, 4, -5}));
+    EXPECT_EQ(columns.Find("price")->GetDoubles(), (std::vector<double>{2, 2.5, 0, 10}));
+}
+
+TEST(COLUMNS, ERROR)
+{
+    EXPECT_THROW(tijson::Columns::FromJson("{}"), tijson::DecodeException);
+    EXPECT_THROW(tijson::Columns::FromJson("[ {}, 1 ]"), tijson::DecodeException);
+    EXPECT_THROW(tijson::Columns::FromJson("[ { \"a\" 1 } ]"), tijson::ParseException);
+    EXPECT_THROW(tijson::Columns::FromJson("[ { \"a\" : tru } ]"), tijson::ParseException);
+    EXPECT_THROW(tijson::Columns::FromJson("[ {} ] 1"), tijson::ParseException);
+    EXPECT_EQ(tijson::Columns::FromJson("[]").rows(), 0);
+}
+
+TEST(COLUMNS, MIXED_JSON)
+{
+    /* entries already converted to json text are not quoted again by later types */
+    auto  columns = tijson::Columns::FromJson(
+        R"([ { "a" : 1 }, { "a" : "x" }, { "a" : 2.5 }, { "a" : true }, {}, { "a" : [ "y" ] } ])");
+    auto& a       = *columns.Find("a");
+    EXPECT_EQ(a.GetType(), TYPE::JSON);
+    EXPECT_EQ(a.GetString(0), "1");
+    EXPECT_EQ(a.GetString(1), "\"x\"");
+    EXPECT_EQ(a.GetString(2), "2.5");
+    EXPECT_EQ(a.GetString(3), "true");
+    EXPECT_FALSE(a.IsValid(4));
+    EXPECT_EQ(a.GetString(5), "[ \"y\" ]");
+}
+
+TEST(COLUMNS, MANY_ROWS)
+{
+    std::string content = "[";
+    for (int i = 0; i < 200; i++)
+        content += std::string(i ? "," : "") + (i % 3 ? "{\"v\":" + std::to_string(i) + "}" : "{}");
+    content += "]";
+    auto  columns = tijson::Columns::FromJson(content);
+    auto& v       = *columns.Find("v");
+    EXPECT_EQ(v.GetValidity().size(), 4);
+    int64_t sum = 0;
+    for (size_t row = 0; row < v.size(); row++)
+        sum += v.IsValid(row) ? v.GetInt64s()[row] : 0;
+    EXPECT_EQ(sum, 199 * 200 / 2 - 3 * (66 * 67 / 2));
+}
@@ -0,0 +1,113 @@
+#include "test_utils.h"
+
+using STYLE = tijson::Formatter::STYLE;
+
+static char const* doc = R"( { "b" : [ 1.50, -0e+2, true, null ],
+                               "a" : { "s" : "x\"\u00e9\n" }, "e" : [ ], "o" : {} } )";
+
+/* code and offset of the error a formatter reports for content */
+static std::pair<tijson::PARSE_ERROR, size_t> FormatError(std::string_view content)
+{
+    try {
+        (void)tijson::Formatter::Minify(content);
+    }
+    catch (tijson::ParseException& e) {
+        return {e.GetErrorCode(), e.GetOffset()};
+    }
+    return {tijson::PARSE_ERROR::NO_ERROR, 0};
+}
+
+TEST(FORMATTER, MINIFY)
+{
+    /* key order, number text and escapes are kept */
+    EXPECT_EQ(tijson::Formatter::Minify(doc),
+              R"({"b":[1.50,-0e+2,true,null],"a":{"s":"x\"\u00e9\n"},"e":[],"o":{}})");
+    EXPECT_EQ(tijson::Formatter::Minify(" 12 "), "12");
+    EXPECT_EQ(tijson::Formatter::Minify("\"\\uD83D\\uDE00 \\/\""), "\"\\uD83D\\uDE00 \\/\"");
+    EXPECT_EQ(tijson::Parse(tijson::Formatter::Minify(doc)), tijson::Parse(doc));
+}
+
+TEST(FORMATTER, PRETTIFY)
+{
+    EXPECT_EQ(tijson::Formatter::Prettify(doc, 2), R"({
+  "b": [
+    1.50,
+    -0e+2,
+    true,
+    null
+  ],
+  "a": {
+    "s": "x\"\u00e9\n"
+  },
+  "e": [],
+  "o": {}
+})");
+    EXPECT_EQ(tijson::Formatter::Prettify("[[],[[1]]]", 1), "[\n [],\n [\n  [\n   1\n  ]\n ]\n]");
+    EXPECT_EQ(tijson::Formatter::Prettify("\"a\""), "\"a\"");
+    EXPECT_EQ(tijson::Formatter::Minify(tijson::Formatter::Prettify(doc)),
+              tijson::Formatter::Minify(doc));
+}
+
+TEST(FORMATTER, CHUNKS)
+{
+    /* split into two chunks at every position, inside tokens and escapes too */
+    std::string content = std::string(doc) + std::string(40, ' ');
+    content.insert(content.find("x\\"), std::string(37, 'y'));
+    for (auto style : {STYLE::COMPACT, STYLE::PRETTY}) {
+        std::string expected;
+        tijson::Formatter formatter(style);
+        formatter.Feed(content, expected);
+        formatter.Finish();
+        for (size_t split = 0; split <= content.size(); split++) {
+            std::string out;
+            formatter.Feed(std::string_view(content).substr(0, split), out);
+            formatter.Feed(std::string_view(content).substr(split), out);
+            formatter.Finish();
+            EXPECT_EQ(out, expected) << split;
+        }
+    }
+
+    /* one byte at a time */
+    std::string       out;
+    tijson::Formatter formatter;
+    for (char ch : content)
+        formatter.Feed(std::string_view(&ch, 1), out);
+    formatter.Finish();
+    EXPECT_EQ(out, tijson::Formatter::Minify(content));
+}
+
+TEST(FORMATTER, SAME_CODES_AS_VALIDATE)
+{
+    for (auto content :
+         {"", " ", "nul", "truex", "[ 1, 2 ", "[ 1 2 ]", "[ 1, ]", "{ \"a\" 1 }", "{ 1 : 2 }",
+          "{ \"a\" : 1 ", "{ \"a\" : 1 ]", "{ \"a\" : ", "{ \"a\" : 1, }", "\"a", "\"\\x\"",
+          "\"\\u12G4\"", "\"\\uD800\"", "\"\\uD800\\u0041\"", "\"\\uDC00\"", "\"\x01\"", "-",
+          "-a", "1.", "1.e1", "1e", "1e+", "0123", "[01]", "+1", ".5", "1 2", "[ -1.5e3 ]"})
+        EXPECT_EQ(FormatError(content).first, tijson::Validate(content))
+            << content;
+}
+
+TEST(FORMATTER, ERROR_OFFSET)
+{
+    EXPECT_EQ(FormatError("[ 1, 2 }").second, 7);
+    EXPECT_EQ(FormatError("{ \"a\" : tru }").second, 11);
+    EXPECT_EQ(FormatError("\"ab\\q\"").second, 4);
+    EXPECT_EQ(FormatError("[ 1, 2 ").second, 7);
+
+    /* offsets count the chunks fed before, and the formatter is usable after an error */
+    tijson::Formatter formatter;
+    std::string       out;
+    formatter.Feed("[ 1,", out);
+    try {
+        formatter.Feed(" 2 3 ]", out);
+        FAIL();
+    }
+    catch (tijson::ParseException& e) {
+        EXPECT_STREQ(e.what(), "MISS_COMMA_OR_SQUARE_BRACKET");
+        EXPECT_EQ(e.GetOffset(), 7);
+    }
+    out.clear();
+    formatter.Feed("[]", out);
+    formatter.Finish();
+    EXPECT_EQ(out, "[]");
+}
@@ -0,0 +1,150 @@
+#include "test_utils.h"
+
+#include <atomic>
+#include <thread>
+
+static char const* content = R"({ "name" : "cfg", "limits" : [ 1, 2.5, 3 ], "rate" : 0.1,
+                                  "nested" : { "on" : true, "tags" : [ "a", "b" ] } })";
+
+TEST(FREEZE, LAYOUTS)
+{
+    tijson::ParseOptions options;
+    options.pack_numbers = true;
+    options.lazy_numbers = true;
+    options.raw          = tijson::Projection({"/nested"});
+    auto val             = tijson::Parser::Parse(content, options);
+    EXPECT_TRUE(val["nested"].IsRaw());
+    val.Freeze();
+    EXPECT_TRUE(val.IsFrozen());
+    EXPECT_TRUE(val["nested"].IsFrozen());
+    EXPECT_FALSE(val["nested"].IsRaw());
+    EXPECT_FALSE(val["limits"].IsPackedArray());
+
+    /* a lazy number keeps its text and is converted without storing the double */
+    EXPECT_TRUE(val["rate"].IsLazyNumber());
+    EXPECT_EQ(val["rate"].GetNumber(), 0.1);
+    EXPECT_TRUE(val["rate"].IsLazyNumber());
+    EXPECT_EQ(val, tijson::Parse(content));
+
+    auto keys = std::make_shared<tijson::KeyTable>();
+    auto compact = tijson::Parser::Parse(content, keys);
+    compact.Freeze();
+    EXPECT_FALSE(compact.IsCompactObject());
+    EXPECT_EQ(compact, tijson::Parse(content));
+}
+
+TEST(FREEZE, NO_WRITES)
+{
+    auto val = tijson::Parse(content);
+    val.Freeze();
+    /* a missing key is not inserted */
+    EXPECT_THROW((void)val["missing"], tijson::AccessException);
+    EXPECT_EQ(val.MemberCount(), 4);
+    EXPECT_EQ(val["nested"]["tags"][size_t(1)].GetString(), "b");
+    EXPECT_EQ(val.Find("missing"), nullptr);
+    EXPECT_THROW((void)val["limits"].GetNumberSpan(), tijson::AccessException);
+    EXPECT_FALSE(val["limits"].IsPackedArray());
+    EXPECT_EQ(val.GetObjectView().size(), 4);
+    EXPECT_EQ(val["limits"].GetArrayView().size(), 3);
+
+    /* a copy can be written again */
+    tijson::Value copy = val;
+    EXPECT_FALSE(copy.IsFrozen());
+    EXPECT_FALSE(copy["nested"].IsFrozen());
+    copy["missing"] = 1;
+    EXPECT_EQ(copy.MemberCount(), 5);
+    EXPECT_TRUE(copy["limits"].PackNumbers());
+    EXPECT_EQ(copy["limits"].GetNumberSpan().size(), 3);
+
+    /* a move carries the flag */
+    tijson::Value moved = std::move(copy);
+    EXPECT_FALSE(moved.IsFrozen());
+    moved = std::move(val);
+    EXPECT_TRUE(moved.IsFrozen());
+    EXPECT_FALSE(val.IsFrozen());
+}
+
+TEST(FREEZE, WRITES_THROW)
+{
+    auto val = tijson::Parse(content);
+    val.Freeze();
+    EXPECT_THROW(val["nested"]["on"] = false, tijson::AccessException);
+    EXPECT_THROW(val["nested"] = "off", tijson::AccessException);
+    EXPECT_THROW(val["limits"][size_t(0)] = val["rate"], tijson::AccessException);
+    EXPECT_THROW(val["rate"].SetNumber(1), tijson::AccessException);
+    EXPECT_THROW(val.SetNull(), tijson::AccessException);
+    EXPECT_THROW(val.ShrinkToFit(), tijson::AccessException);
+    EXPECT_THROW(val.GetObject()["missing"] = 1, tijson::AccessException);
+    EXPECT_THROW(val["limits"].GetArray().clear(), tijson::AccessException);
+    EXPECT_THROW(tijson::Pointer("/nested/on").Set(val, 1), tijson::AccessException);
+    EXPECT_THROW(tijson::Pointer("/limits/0").Erase(val), tijson::AccessException);
+    tijson::ReusableParser parser;
+    EXPECT_THROW(parser.ParseInto("1", val["rate"]), tijson::AccessException);
+
+    /* a frozen value under a plain one is still guarded */
+    tijson::Value root = tijson::Object();
+    root["cfg"]        = std::move(val);
+    EXPECT_THROW(tijson::Patch::Apply(root, tijson::Parse(R"([ { "op" : "add",
+                     "path" : "/cfg/extra", "value" : 1 } ])")),
+                 tijson::AccessException);
+    EXPECT_THROW(tijson::Patch::Apply(root, tijson::Parse(R"([ { "op" : "move",
+                     "from" : "/cfg/name", "path" : "/name" } ])")),
+                 tijson::AccessException);
+    EXPECT_THROW(root["cfg"]["name"] = 1, tijson::AccessException);
+    EXPECT_EQ(root["cfg"], tijson::Parse(content));
+
+    /* the frozen root itself can be replaced */
+    root["cfg"] = 1;
+    EXPECT_FALSE(root["cfg"].IsFrozen());
+    EXPECT_EQ(root["cfg"].GetNumber(), 1);
+}
+
+TEST(FREEZE, SHARED_DOCUMENT)
+{
+    tijson::SharedDocument document(tijson::Parse("{ \"version\" : 0 }"));
+    std::atomic<bool>      stop{false};
+    std::atomic<int>       errors{0};
+
+    /* readers see whole versions only, while a writer keeps publishing new ones */
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++)
+        readers.emplace_back([&] {
+            double last = 0;
+            while (!stop) {
+                auto   snapshot = document.Load();
+                auto&  val      = *snapshot;
+                double version  = val["version"].GetNumber();
+                if (version < last || val.MemberCount() != (version == 0 ? 1 : 2) ||
+                    (version != 0 && val["items"].ItemCount() != static_cast<size_t>(version)))
+                    errors++;
+                last = version;
+            }
+        });
+    std::shared_ptr<tijson::Value const> kept = document.Load();
+    for (int version = 1; version <= 200; version++) {
+        std::string items = "[";
+        for (int i = 0; i < version; i++)
+            items += i ? ",1" : "1";
+        auto previous = document.Store(tijson::Parse("{ \"version\" : " + std::to_string(version) +
+                                                     ", \"items\" : " + items + "] }"));
+        EXPECT_EQ((*previous)["version"].GetNumber(), version - 1);
+    }
+    stop = true;
+    for (auto& reader : readers)
+        reader.join();
+    EXPECT_EQ(errors, 0);
+    EXPECT_TRUE(document.Load()->IsFrozen());
+    EXPECT_EQ((*document.Load())["version"].GetNumber(), 200);
+    /* a version held by a reader stays valid after it is replaced */
+    EXPECT_EQ((*kept)["version"].GetNumber(), 0);
+}
+
+TEST(FREEZE, MOVE_DIES)
+{
+    auto val = tijson::Parse(content);
+    val.Freeze();
+    /* a value under a frozen one may be in use by readers, it is neither moved from nor to */
+    EXPECT_DEATH(val["nested"] = tijson::Value(), "");
+    EXPECT_DEATH(tijson::Value(std::move(val["nested"])), "");
+    EXPECT_EQ(val, tijson::Parse(content));
+}
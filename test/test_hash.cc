@@ -0,0 +1,99 @@
+#include "test_utils.h"
+
+#include <unordered_map>
+
+static char const* content = R"({ "id" : 7, "tags" : [ 1, 2.0, -0 ], "user" : { "name" : "x",
+                                  "on" : true, "none" : null }, "raw" : [ "a", { } ] })";
+
+TEST(HASH, SAME_FOR_EVERY_LAYOUT)
+{
+    auto        val  = tijson::Parse(content);
+    size_t      hash = val.Hash();
+    auto        keys = std::make_shared<tijson::KeyTable>();
+    std::string reordered =
+        R"({ "raw" : [ "a", {} ], "user" : { "none" : null, "on" : true, "name" : "x" },
+             "tags" : [ 1e0, 2, 0 ], "id" : 7.0 })";
+    EXPECT_EQ(tijson::Parse(reordered).Hash(), hash);
+    EXPECT_EQ(tijson::Parser::Parse(content, keys).Hash(), hash);
+    /* all 64 bits are kept where size_t has them */
+    if (sizeof(size_t) == sizeof(uint64_t))
+        EXPECT_NE(static_cast<uint64_t>(hash) >> 32, 0u);
+
+    tijson::ParseOptions options;
+    options.pack_numbers = true;
+    options.lazy_numbers = true;
+    options.share_shapes = true;
+    EXPECT_EQ(tijson::Parser::Parse(content, options).Hash(), hash);
+    options.raw = tijson::Projection({"/raw", "/user"});
+    auto raw    = tijson::Parser::Parse(content, options);
+    EXPECT_EQ(raw.Hash(), hash);
+    /* hashing writes nothing */
+    EXPECT_TRUE(raw["raw"].IsRaw());
+    EXPECT_TRUE(raw["id"].IsLazyNumber());
+}
+
+TEST(HASH, DIFFERENT_VALUES)
+{
+    std::unordered_map<size_t, std::string> seen;
+    for (auto text : {"null", "true", "false", "0", "1", "-1", "0.5", "\"\"", "\"0\"", "[]", "{}",
+                      "[ 0 ]", "[ [] ]", "[ {} ]", "[ 1, 2 ]", "[ 2, 1 ]", "{ \"a\" : 1 }",
+                      "{ \"a\" : 2 }", "{ \"b\" : 1 }", "{ \"a\" : 1, \"b\" : 2 }",
+                      "{ \"a\" : 2, \"b\" : 1 }", "{ \"a\" : [ 1 ] }", "[ \"a\", 1 ]"}) {
+        auto [it, inserted] = seen.emplace(tijson::Parse(text).Hash(), text);
+        EXPECT_TRUE(inserted) << text << " and " << it->second;
+    }
+}
+
+TEST(HASH, FROZEN)
+{
+    auto val    = tijson::Parse(content);
+    auto frozen = tijson::Parse(content);
+    frozen.Freeze();
+    EXPECT_EQ(frozen.Hash(), val.Hash());
+    EXPECT_EQ(frozen["user"].Hash(), val["user"].Hash());
+    /* a subtree frozen first hashes the same inside the whole */
+    auto parts = tijson::Parse(content);
+    parts["user"].Freeze();
+    parts.Freeze();
+    EXPECT_EQ(parts.Hash(), val.Hash());
+    EXPECT_EQ(parts, frozen);
+
+    /* frozen values of different hashes are unequal without a walk, equal ones are compared.
+       A plain value is always compared */
+    auto other = tijson::Parse(content);
+    other["user"]["name"] = "y";
+    other.Freeze();
+    EXPECT_NE(frozen, other);
+    EXPECT_EQ(frozen["tags"], other["tags"]);
+    auto same = tijson::Parse(content);
+    same.Freeze();
+    EXPECT_EQ(frozen, same);
+    EXPECT_EQ(frozen, val);
+    EXPECT_NE(val, other);
+
+    /* a copy does not keep the stored hash, it is hashed again after a change */
+    tijson::Value copy = frozen;
+    copy["user"]["name"] = "y";
+    EXPECT_EQ(copy.Hash(), other.Hash());
+    EXPECT_NE(copy.Hash(), frozen.Hash());
+}
+
+TEST(HASH, FROZEN_STAYS_VALID)
+{
+    auto frozen = tijson::Parse(content);
+    frozen.Freeze();
+    size_t hash = frozen.Hash();
+
+    /* the stored hashes can not go stale, a member is not written */
+    EXPECT_THROW(frozen["user"]["name"] = "y", tijson::AccessException);
+    EXPECT_THROW(frozen["tags"][size_t(0)].SetNumber(5), tijson::AccessException);
+    tijson::Value taken = frozen["user"];
+    EXPECT_EQ(frozen["user"]["name"].GetString(), "x");
+    EXPECT_EQ(frozen.Hash(), hash);
+    EXPECT_EQ(frozen.Hash(), tijson::Parse(content).Hash());
+    EXPECT_EQ(frozen, tijson::Parse(content));
+    /* a copy is not frozen and is hashed again after a change */
+    EXPECT_FALSE(taken.IsFrozen());
+    taken["name"] = "y";
+    EXPECT_NE(taken.Hash(), frozen["user"].Hash());
+}
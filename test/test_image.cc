@@ -0,0 +1,126 @@
+#include "test_utils.h"
+
+#include <vector>
+
+static tijson::Value const kDocument = tijson::Parse(R"({
+    "name" : "tijson", "version" : 1.5, "stable" : true, "license" : null,
+    "tags" : [ "json", "c++", "json" ],
+    "nested" : { "b" : [ 1, { "c" : false } ], "a" : "", "c" : "x\u0000y" }
+})");
+
+TEST(IMAGE, ROUND_TRIP)
+{
+    for (auto json : {"null", "true", "false", "0", "-1.5e300", R"("")", R"("€")", "[]",
+                      "{}", R"([ [ [] ], {}, "s" ])"}) {
+        auto val   = tijson::Parse(json);
+        auto image = tijson::Image::Write(val);
+        EXPECT_EQ(image.size() % 8, 0);
+        EXPECT_EQ(tijson::Image::Open(image.data(), image.size()).ToValue(), val);
+    }
+    auto image = tijson::Image::Write(kDocument);
+    EXPECT_EQ(tijson::Image::Open(image.data(), image.size()).ToValue(), kDocument);
+}
+
+TEST(IMAGE, ACCESS)
+{
+    auto image = tijson::Image::Write(kDocument);
+    auto root  = tijson::Image::Open(image.data(), image.size());
+    EXPECT_EQ(root.GetType(), tijson::Value::TYPE::OBJECT);
+    EXPECT_EQ(root.size(), 6);
+    EXPECT_EQ(root["name"].GetString(), "tijson");
+    EXPECT_EQ(root["version"].GetNumber(), 1.5);
+    EXPECT_EQ(root["stable"].GetBool(), true);
+    EXPECT_EQ(root["license"].GetType(), tijson::Value::TYPE::NUL);
+    EXPECT_EQ(root["tags"].size(), 3);
+    EXPECT_EQ(root["tags"][2].GetString(), "json");
+    EXPECT_EQ(root["nested"]["b"][1]["c"].GetBool(), false);
+    EXPECT_EQ(root["nested"]["c"].GetString(), std::string_view("x\0y", 3));
+    EXPECT_FALSE(root.Find("missing"));
+    EXPECT_FALSE(root["nested"].Find("d"));
+
+    /* keys are sorted */
+    auto nested = root["nested"];
+    EXPECT_EQ(nested.Key(0), "a");
+    EXPECT_EQ(nested.Key(1), "b");
+    EXPECT_EQ(nested.Key(2), "c");
+    EXPECT_EQ(nested[2].GetString(), nested["c"].GetString());
+
+    EXPECT_THROW(root["missing"], tijson::AccessException);
+    EXPECT_THROW(root["tags"][3], tijson::AccessException);
+    EXPECT_THROW((void)root["name"].GetNumber(), tijson::AccessException);
+    EXPECT_THROW((void)root["name"].size(), tijson::AccessException);
+    EXPECT_THROW((void)root["tags"].Find("x"), tijson::AccessException);
+}
+
+TEST(IMAGE, POSITION_INDEPENDENT)
+{
+    auto image = tijson::Image::Write(kDocument);
+
+    /* a copy at another address reads the same, as a mapped file or shared memory would */
+    std::vector<uint64_t> moved(image.size() / 8);
+    std::memcpy(moved.data(), image.data(), image.size());
+    std::string().swap(image);
+    auto root = tijson::Image::Open(moved.data(), moved.size() * 8);
+    EXPECT_EQ(root.ToValue(), kDocument);
+
+    /* images can be appended to an aligned buffer */
+    std::string out = "12345678";
+    tijson::Image::Write(kDocument, out);
+    EXPECT_EQ(tijson::Image::Open(out.data() + 8, out.size() - 8)["tags"][1].GetString(), "c++");
+}
+
+TEST(IMAGE, ERROR_CODE)
+{
+    auto image = tijson::Image::Write(kDocument);
+    EXPECT_THROW(tijson::Image::Open(image.data(), 8), tijson::DecodeException);
+    EXPECT_THROW(tijson::Image::Open(image.data(), image.size() - 8), tijson::DecodeException);
+
+    std::vector<uint64_t> aligned(image.size() / 8 + 1);
+    std::memcpy(reinterpret_cast<char*>(aligned.data()) + 1, image.data(), image.size());
+    EXPECT_THROW(tijson::Image::Open(reinterpret_cast<char*>(aligned.data()) + 1, image.size()),
+                 tijson::DecodeException);
+
+    image[0] = 'X';
+    tijson::DecodeException e("");
+    try {
+        tijson::Image::Open(image.data(), image.size());
+    }
+    catch (tijson::DecodeException& err) {
+        e = err;
+    }
+    EXPECT_STREQ(e.what(), "INVALID_IMAGE");
+}
+
+TEST(IMAGE, CORRUPT)
+{
+    auto image = tijson::Image::Write(kDocument);
+    auto open  = [](std::string const& bytes) {
+        return tijson::Image::Open(bytes.data(), bytes.size());
+    };
+    /* the root slot follows the 16-byte header: type, 3 reserved bytes, length, payload */
+    auto     broken = image;
+    uint32_t length = 0xFFFFFFFF;
+    std::memcpy(&broken[20], &length, sizeof(length));
+    EXPECT_THROW(open(broken), tijson::DecodeException);
+    broken          = image;
+    uint64_t offset = uint64_t(1) << 40;
+    std::memcpy(&broken[24], &offset, sizeof(offset));
+    EXPECT_THROW(open(broken), tijson::DecodeException);
+    broken     = image;
+    broken[16] = 'R';
+    EXPECT_THROW(open(broken), tijson::DecodeException);
+
+    /* a truncated image whose header was fixed up to match */
+    broken        = image.substr(0, image.size() / 2 & ~size_t(7));
+    uint64_t size = broken.size();
+    std::memcpy(&broken[8], &size, sizeof(size));
+    EXPECT_THROW(open(broken), tijson::DecodeException);
+
+    /* an array that contains itself */
+    broken = tijson::Image::Write(tijson::Parse("[ [] ]"));
+    std::memcpy(&offset, &broken[24], sizeof(offset));
+    length = 1;
+    std::memcpy(&broken[offset + 4], &length, sizeof(length));
+    std::memcpy(&broken[offset + 8], &offset, sizeof(offset));
+    EXPECT_THROW(open(broken), tijson::DecodeException);
+}
@@ -0,0 +1,127 @@
+#include "test_utils.h"
+
+TEST(KEY_MATCHER, FIND)
+{
+    constexpr auto keys = tijson::MakeKeyMatcher("id", "ts", "user", "items", "", "idx");
+    static_assert(keys.Find("user") == 2);
+    static_assert(keys.Find("users") == keys.npos);
+    EXPECT_EQ(keys.Find("id"), 0);
+    EXPECT_EQ(keys.Find("ts"), 1);
+    EXPECT_EQ(keys.Find("items"), 3);
+    EXPECT_EQ(keys.Find(""), 4);
+    EXPECT_EQ(keys.Find("idx"), 5);
+    EXPECT_EQ(keys.Find("xd"), keys.npos);
+    EXPECT_EQ(keys.Find("iD"), keys.npos);
+    EXPECT_EQ(keys.Key(3), "items");
+
+    // keys that only differ in the middle need the full hash
+    constexpr auto similar = tijson::MakeKeyMatcher("a1b2c", "a1x2c", "a9b2c", "a1b9c");
+    EXPECT_EQ(similar.Find("a1x2c"), 1);
+    EXPECT_EQ(similar.Find("a1b9c"), 3);
+    EXPECT_EQ(similar.Find("a1b2c"), 0);
+    EXPECT_EQ(similar.Find("a2b2c"), similar.npos);
+}
+
+TEST(KEY_MATCHER, PARSE_OBJECT_INTO)
+{
+    constexpr auto               keys = tijson::MakeKeyMatcher("id", "name", "tags", "missing");
+    std::array<tijson::Value, 4> slots;
+    tijson::Parser::ParseObjectInto(
+        R"( { "name" : "tijson", "skip" : { "a" : [ 1, 2 ] }, "id" : 3, "tags" : [ "x" ] } )",
+        keys,
+        slots);
+    EXPECT_VALUE_EQ_NUMBER(slots[0], 3);
+    EXPECT_VALUE_EQ_STRING(slots[1], "tijson");
+    EXPECT_VALUE_EQ_STRING(slots[2].GetArray()[0], "x");
+    EXPECT_EQ(slots[3], false);
+    EXPECT_EQ(slots[3].GetParseErrorCode(), tijson::PARSE_ERROR::MISS_KEY);
+
+    tijson::ParseException e("");
+    try {
+        tijson::Parser::ParseObjectInto(
+            R"({ "id" : 1, "skip" : 2 })", keys, slots, tijson::UNKNOWN_KEY::ERROR);
+    }
+    catch (tijson::ParseException& err) {
+        e = err;
+    }
+    EXPECT_STREQ(e.what(), "UNKNOWN_KEY");
+}
+
+namespace twitter {
+struct User
+{
+    int64_t     id = 0;
+    std::string id_str, name, screen_name, location, description, url;
+    bool        protected_ = false;
+    int64_t     followers_count = 0, friends_count = 0, listed_count = 0;
+    std::string created_at;
+    int64_t     favourites_count = 0, utc_offset = 0;
+    std::string time_zone;
+    bool        geo_enabled = false, verified = false;
+    int64_t     statuses_count = 0;
+    std::string lang;
+    bool        contributors_enabled = false, is_translator = false;
+    std::string profile_background_color, profile_background_image_url;
+    std::string profile_background_image_url_https;
+    bool        profile_background_tile = false;
+    std::string profile_image_url, profile_image_url_https, profile_banner_url;
+    std::string profile_link_color, profile_sidebar_border_color, profile_sidebar_fill_color;
+    std::string profile_text_color;
+};
+TIJSON_DEFINE(User, id, id_str, name, screen_name, location, description, url, protected_,
+              followers_count, friends_count, listed_count, created_at, favourites_count,
+              utc_offset, time_zone, geo_enabled, verified, statuses_count, lang,
+              contributors_enabled, is_translator, profile_background_color,
+              profile_background_image_url, profile_background_image_url_https,
+              profile_background_tile, profile_image_url, profile_image_url_https,
+              profile_banner_url, profile_link_color, profile_sidebar_border_color,
+              profile_sidebar_fill_color, profile_text_color)
+}   // namespace twitter
+
+template<size_t N>
+static void ExpectAllFound(tijson::KeyMatcher<N> const& keys)
+{
+    for (size_t i = 0; i < N; i++) {
+        EXPECT_EQ(keys.Find(keys.Key(i)), i) << keys.Key(i);
+        EXPECT_EQ(keys.Find(std::string(keys.Key(i)) + "_"), keys.npos);
+    }
+}
+
+TEST(KEY_MATCHER, MANY_KEYS)
+{
+    /* beyond a couple of dozen keys the matcher displaces buckets instead of retrying seeds */
+    constexpr auto user = tijson::FieldMatcherOf<twitter::User>();
+    static_assert(user.size() == 32);
+    static_assert(user.Find("profile_text_color") == 31);
+    ExpectAllFound(user);
+
+    constexpr auto status = tijson::MakeKeyMatcher(
+        "id", "id_str", "name", "screen_name", "location", "description", "url", "protected",
+        "followers_count", "friends_count", "listed_count", "created_at", "favourites_count",
+        "utc_offset", "time_zone", "geo_enabled", "verified", "statuses_count", "lang",
+        "contributors_enabled", "is_translator", "is_translation_enabled",
+        "profile_background_color", "profile_background_image_url",
+        "profile_background_image_url_https", "profile_background_tile", "profile_image_url",
+        "profile_image_url_https", "profile_banner_url", "profile_link_color",
+        "profile_sidebar_border_color", "profile_sidebar_fill_color", "profile_text_color",
+        "profile_use_background_image", "default_profile", "default_profile_image", "following",
+        "follow_request_sent", "notifications", "metadata", "text", "source", "truncated",
+        "in_reply_to_status_id", "in_reply_to_status_id_str", "in_reply_to_user_id",
+        "in_reply_to_user_id_str", "in_reply_to_screen_name", "user", "geo", "coordinates",
+        "place", "contributors", "retweet_count", "favorite_count", "favorited", "retweeted",
+        "possibly_sensitive", "retweeted_status", "entities", "hashtags", "symbols", "urls",
+        "user_mentions");
+    static_assert(status.size() == 64);
+    ExpectAllFound(status);
+
+    twitter::User parsed;
+    EXPECT_EQ(tijson::ParseInto(R"({ "screen_name" : "a", "profile_text_color" : "333333",
+                                      "followers_count" : 7, "unknown" : 1 })",
+                                parsed),
+              tijson::PARSE_ERROR::NO_ERROR);
+    EXPECT_EQ(parsed.screen_name, "a");
+    EXPECT_EQ(parsed.profile_text_color, "333333");
+    EXPECT_EQ(parsed.followers_count, 7);
+
+    EXPECT_THROW(tijson::MakeKeyMatcher("id", "url", "id"), std::invalid_argument);
+}
@@ -0,0 +1,125 @@
+#include "test_utils.h"
+
+#include <thread>
+
+static char const* records = R"([
+    { "id" : 1, "name" : "a", "tags" : [ "x" ], "meta" : { "id" : "m1" } },
+    { "name" : "b", "id" : 2, "tags" : [], "meta" : { "id" : "m2" } },
+    { "id" : 3, "name" : "c\n", "tags" : [ "y", "z" ], "meta" : {} }
+])";
+
+TEST(KEY_TABLE, INTERN)
+{
+    tijson::KeyTable table;
+    auto             id = table.Intern("id");
+    EXPECT_EQ(*id, "id");
+    EXPECT_EQ(table.Intern(std::string("i") + "d"), id);
+    EXPECT_EQ(table.Find("id"), id);
+    EXPECT_EQ(table.Find("name"), nullptr);
+    EXPECT_NE(table.Intern("name"), id);
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_GT(table.MemoryUsage(), 0);
+}
+
+TEST(KEY_TABLE, PARSE)
+{
+    auto table = std::make_shared<tijson::KeyTable>();
+    auto val   = tijson::Parse(records, table);
+    EXPECT_EQ(val, tijson::Parse(records));
+    EXPECT_EQ(table->size(), 4);
+
+    auto id = table->Find("id");
+    EXPECT_TRUE(val[size_t(0)].IsCompactObject());
+    EXPECT_EQ(val[size_t(1)].Find(id)->GetNumber(), 2);
+    EXPECT_EQ(val[size_t(1)]["meta"].Find(id)->GetString(), "m2");
+    EXPECT_EQ(val[size_t(2)]["meta"].Find(id), nullptr);
+    EXPECT_EQ(val[size_t(2)].Find("name")->GetString(), "c\n");
+    EXPECT_EQ(val[size_t(2)].MemberCount(), 4);
+
+    /* a key of another table is compared by content */
+    tijson::KeyTable other;
+    EXPECT_EQ(val[size_t(0)].Find(other.Intern("id"))->GetNumber(), 1);
+    EXPECT_EQ(val[size_t(0)].Find(other.Intern("none")), nullptr);
+
+    /* values keep the table alive */
+    table.reset();
+    EXPECT_EQ(val[size_t(0)]["name"].GetString(), "a");
+    EXPECT_EQ(val[size_t(0)].MemberCount(), 4);
+}
+
+TEST(KEY_TABLE, COMPACT_OBJECT)
+{
+    auto table = std::make_shared<tijson::KeyTable>();
+    auto val   = tijson::Parse(R"({ "a" : 1, "b" : { "c" : true }, "a" : 2 })", table);
+    EXPECT_EQ(val.MemberCount(), 2);
+    EXPECT_EQ(val.Find("a")->GetNumber(), 2);
+    EXPECT_EQ(tijson::Parse(val.Stringify()), val);
+
+    std::vector<std::string> keys;
+    val.ForEachMember([&](std::string_view key, tijson::Value const&) { keys.emplace_back(key); });
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "b"}));
+
+    /* copies share the table, inserting converts to Object */
+    tijson::Value copy = val;
+    EXPECT_TRUE(copy.IsCompactObject());
+    copy["d"] = 4;
+    EXPECT_FALSE(copy.IsCompactObject());
+    EXPECT_EQ(copy.GetObject().size(), 3);
+    EXPECT_EQ(copy["b"]["c"], true);
+    EXPECT_TRUE(val.IsCompactObject());
+    EXPECT_NE(copy, val);
+    copy.GetObject().erase("d");
+    EXPECT_EQ(copy, val);
+    EXPECT_EQ(val, copy);
+
+    /* operator[] converts first, so its references survive later inserts */
+    copy      = val;
+    auto& a   = copy["a"];
+    copy["e"] = 5;
+    a         = 3;
+    EXPECT_EQ(copy.Find("a")->GetNumber(), 3);
+
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1 )", table).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET);
+
+    /* large objects are not compact */
+    std::string large = "{";
+    for (int i = 0; i < 100; i++)
+        large += (i ? ",\"k" : "\"k") + std::to_string(i % 80) + "\":" + std::to_string(i);
+    large += "}";
+    auto big = tijson::Parse(large, table);
+    EXPECT_FALSE(big.IsCompactObject());
+    EXPECT_EQ(big, tijson::Parse(large));
+    EXPECT_EQ(big["k5"].GetNumber(), 85);
+}
+
+TEST(KEY_TABLE, MEMORY)
+{
+    std::string content = "[";
+    for (int i = 0; i < 100; i++)
+        content += std::string(i ? "," : "") +
+                   R"({ "identifier_long_key" : 1, "another_long_key_name" : "v" })";
+    content += "]";
+    auto table   = std::make_shared<tijson::KeyTable>();
+    auto plain   = tijson::Parse(content);
+    auto interned = tijson::Parse(content, table);
+    EXPECT_EQ(table->size(), 2);
+    EXPECT_EQ(interned.MemoryUsage().strings, 0);
+    EXPECT_LT(interned.MemoryUsage().Total() + table->MemoryUsage(), plain.MemoryUsage().Total());
+}
+
+TEST(KEY_TABLE, THREAD_SAFE)
+{
+    auto                     table = std::make_shared<tijson::KeyTable>(true);
+    std::vector<tijson::Value> values(4);
+    std::vector<std::thread> threads;
+    for (auto& val : values)
+        threads.emplace_back([&] { val = tijson::Parse(records, table); });
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(table->size(), 4);
+    for (auto const& val : values) {
+        EXPECT_EQ(val, values[0]);
+        EXPECT_EQ(val[size_t(0)].Find(table->Find("name"))->GetString(), "a");
+    }
+}
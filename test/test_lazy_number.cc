@@ -0,0 +1,60 @@
+#include "test_utils.h"
+
+static tijson::ParseOptions const lazy = [] {
+    tijson::ParseOptions options;
+    options.lazy_numbers = true;
+    return options;
+}();
+
+TEST(LAZY_NUMBER, PASSTHROUGH)
+{
+    char const* content = R"([ 1.10, -0, 12345678901234567890123, 1E+2, 0.1 ])";
+    auto        val     = tijson::Parse(content, lazy);
+    EXPECT_TRUE(val[size_t(0)].IsLazyNumber());
+    /* unread numbers keep their text */
+    EXPECT_EQ(val.Stringify(), "[ 1.10, -0, 12345678901234567890123, 1E+2, 0.1 ]");
+
+    /* read numbers are converted once */
+    EXPECT_EQ(val[size_t(3)].GetNumber(), 100);
+    EXPECT_FALSE(val[size_t(3)].IsLazyNumber());
+    EXPECT_EQ(val[size_t(3)].Stringify(), "100");
+    EXPECT_TRUE(val[size_t(2)].IsLazyNumber());
+
+    EXPECT_FALSE(tijson::Parse("1.10").IsLazyNumber());
+}
+
+TEST(LAZY_NUMBER, COMPARE_AND_COPY)
+{
+    auto val = tijson::Parse(R"({ "a" : 2.50, "b" : 2.5, "c" : [ 1, 2 ] })", lazy);
+
+    /* a copy keeps the text, equal text compares without converting */
+    tijson::Value copy = val["c"];
+    EXPECT_TRUE(copy[size_t(0)].IsLazyNumber());
+    EXPECT_EQ(copy, val["c"]);
+    EXPECT_TRUE(copy[size_t(0)].IsLazyNumber());
+
+    EXPECT_EQ(val, tijson::Parse(R"({ "a" : 2.5, "b" : 2.50, "c" : [ 1.0, 2 ] })"));
+    EXPECT_EQ(val["a"], val["b"]);
+
+    /* lazy_numbers wins over pack_numbers, unread numbers keep their text */
+    tijson::ParseOptions options = lazy;
+    options.pack_numbers         = true;
+    auto both                    = tijson::Parse("[ 1.10, 2.50 ]", options);
+    EXPECT_FALSE(both.IsPackedArray());
+    EXPECT_TRUE(both[size_t(0)].IsLazyNumber());
+    EXPECT_EQ(both.Stringify(), "[ 1.10, 2.50 ]");
+    EXPECT_EQ(both, tijson::Parse("[ 1.1, 2.5 ]"));
+}
+
+TEST(LAZY_NUMBER, ERROR)
+{
+    EXPECT_EQ(tijson::Parse("[ 1e400 ]", lazy).GetParseErrorCode(),
+              tijson::PARSE_ERROR::NUMBER_TOO_BIG);
+    EXPECT_EQ(tijson::Parse("[ 01 ]", lazy).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET);
+    EXPECT_EQ(tijson::Parse("[ 1. ]", lazy).GetParseErrorCode(),
+              tijson::PARSE_ERROR::INVALID_VALUE);
+    EXPECT_EQ(tijson::Parse("1e10", lazy).GetNumber(), 1e10);
+    EXPECT_THROW((void)tijson::Parse("[ 1 ]", lazy)[size_t(0)].GetString(),
+                 tijson::AccessException);
+}
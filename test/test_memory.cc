@@ -0,0 +1,130 @@
+#include "test_utils.h"
+
+#include <new>
+
+/* count heap bytes requested while a deep copy is built, to check MemoryUsage is exact. The
+ * replaced global allocator is built into its own test executable, test_memory */
+static bool   counting        = false;
+static size_t counted_bytes   = 0;
+static size_t counted_objects = 0;
+
+void* operator new(size_t size)
+{
+    if (counting) {
+        counted_bytes += size;
+        counted_objects++;
+    }
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+// the deletes are kept out of line: inlined next to a new expression, free() on the pointer
+// would be reported as a mismatched deallocation
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static std::pair<size_t, size_t> CopyAllocations(tijson::Value const& val, tijson::Value& copy)
+{
+    counted_bytes = counted_objects = 0;
+    counting                        = true;
+    copy                            = val;
+    counting                        = false;
+    return {counted_bytes, counted_objects};
+}
+
+TEST(MEMORY, SCALAR)
+{
+    EXPECT_EQ(tijson::Value().MemoryUsage().Total(), 0);
+    EXPECT_EQ(tijson::Value(1.5).MemoryUsage().Total(), 0);
+    EXPECT_EQ(tijson::Value("short").MemoryUsage().Total(), 0);
+
+    std::string long_str(40, 'x');
+    auto        report = tijson::Value(long_str).MemoryUsage();
+    EXPECT_EQ(report.strings, 41);
+    EXPECT_EQ(report.allocations, 1);
+}
+
+TEST(MEMORY, EXACT)
+{
+    auto root = tijson::Parse(R"({
+        "a fairly long key that leaves the small buffer" :
+            [ 1, 2, 3, "a string long enough to allocate" ],
+        "b" : { "c" : null, "d" : [], "e" : {} },
+        "f" : [ [ [ true ] ] ]
+    })");
+    tijson::Value copy;
+    auto [bytes, objects] = CopyAllocations(root, copy);
+    auto report           = copy.MemoryUsage();
+    EXPECT_EQ(report.Total(), bytes);
+    EXPECT_EQ(report.allocations, objects);
+    EXPECT_GT(report.containers, 0);
+    EXPECT_GT(report.strings, 0);
+    EXPECT_GT(report.map_nodes, 0);
+}
+
+TEST(MEMORY, SHRINK_TO_FIT)
+{
+    std::string content = "[";
+    for (int i = 0; i < 100; i++)
+        content += std::string(i ? "," : "") + R"({"a key longer than the small buffer":")" +
+                   std::string(20 + i, 'v') + R"(","n":[1,2,3,4,5]})";
+    content += "]";
+    auto root   = tijson::Parse(content);
+    auto before = root.MemoryUsage();
+    EXPECT_GT(before.slack, 0);
+
+    auto copy = root;
+    root.ShrinkToFit();
+    auto after = root.MemoryUsage();
+    EXPECT_EQ(after.slack, 0);
+    EXPECT_LT(after.Total(), before.Total());
+    EXPECT_EQ(root, copy);
+}
+
+TEST(MEMORY, REUSABLE_PARSER)
+{
+    /* once the first documents have been parsed, documents of the same shape allocate nothing */
+    std::string docs[] = {
+        R"({ "id" : 1, "name" : "a long enough name to be on the heap", "tags" : [ 1, 2, 3 ],
+             "user" : { "k\u00e9y" : "v", "n" : null } })",
+        R"({ "name" : "another name that is also on the heap", "id" : 2, "tags" : [ 4 ],
+             "user" : { "n" : true, "k\u00e9y" : "w" } })",
+    };
+    tijson::ReusableParser parser;
+    tijson::Value          val;
+    parser.ParseInto(docs[0], val);
+    parser.ParseInto(docs[1], val);
+    parser.ParseInto(docs[0], val);
+    for (auto const& doc : docs) {
+        counted_bytes = counted_objects = 0;
+        counting                        = true;
+        parser.ParseInto(doc, val);
+        counting = false;
+        EXPECT_EQ(counted_objects, 0);
+        EXPECT_EQ(val, tijson::Parse(doc));
+    }
+}
+
+TEST(MEMORY, POINTER)
+{
+    /* resolving a pointer allocates nothing, whatever the length of its keys */
+    std::string key(40, 'k');
+    auto        root = tijson::Parse("{ \"" + key + "\" : { \"" + key + "\" : [ { \"" + key +
+                                     "\" : 1 } ] } }");
+    tijson::Pointer pointer("/" + key + "/" + key + "/0/" + key);
+    counted_objects = 0;
+    counting        = true;
+    auto found      = pointer.Get(static_cast<tijson::Value const&>(root));
+    counting        = false;
+    EXPECT_EQ(counted_objects, 0);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->GetNumber(), 1);
+}
@@ -0,0 +1,109 @@
+#include "test_utils.h"
+
+#include <numeric>
+
+static tijson::ParseOptions const packed = [] {
+    tijson::ParseOptions options;
+    options.pack_numbers = true;
+    return options;
+}();
+
+TEST(PACKED, PARSE)
+{
+    auto val = tijson::Parse(R"({ "xs" : [ 1, -2.5, 3e2 ], "mixed" : [ 1, 2, "a", 3 ],
+                                  "empty" : [], "nested" : [ [ 1, 2 ], [ 3 ] ] })",
+                             packed);
+    EXPECT_TRUE(val["xs"].IsPackedArray());
+    EXPECT_FALSE(val["mixed"].IsPackedArray());
+    EXPECT_FALSE(val["empty"].IsPackedArray());
+    EXPECT_FALSE(val["nested"].IsPackedArray());
+    EXPECT_TRUE(val["nested"].GetArray()[1].IsPackedArray());
+
+    EXPECT_EQ(val["xs"].ItemCount(), 3);
+    EXPECT_EQ(val["mixed"].ItemCount(), 4);
+    EXPECT_EQ(val["mixed"][size_t(1)].GetNumber(), 2);
+    EXPECT_EQ(val["mixed"][size_t(2)].GetString(), "a");
+
+    auto span = val["xs"].GetNumberSpan();
+    EXPECT_EQ(span.size(), 3);
+    EXPECT_EQ(std::accumulate(span.begin(), span.end(), 0.0), 298.5);
+
+    EXPECT_EQ(val, tijson::Parse(val.Stringify()));
+    EXPECT_EQ(tijson::Parse(val.Stringify()), val);
+    EXPECT_EQ(tijson::Parse("[ 1, 2, - ]", packed).GetParseErrorCode(),
+              tijson::PARSE_ERROR::INVALID_VALUE);
+    EXPECT_EQ(tijson::Parse("[ 1, 2 ", packed).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET);
+}
+
+TEST(PACKED, NUMBER_SPAN)
+{
+    /* an Array is not repacked by the span, references to its items stay valid */
+    tijson::Value const val  = tijson::Parse("[ 4, 5, 6 ]");
+    tijson::Value&      item = val[size_t(0)];
+    EXPECT_THROW((void)val.GetNumberSpan(), tijson::AccessException);
+    EXPECT_FALSE(val.IsPackedArray());
+    EXPECT_EQ(item.GetNumber(), 4);
+
+    /* it is packed on request */
+    auto copy = val;
+    EXPECT_TRUE(copy.PackNumbers());
+    EXPECT_TRUE(copy.IsPackedArray());
+    EXPECT_EQ(copy.GetNumberSpan()[2], 6);
+
+    auto mixed = tijson::Parse("[ 4, true ]");
+    EXPECT_FALSE(mixed.PackNumbers());
+    EXPECT_FALSE(mixed.IsPackedArray());
+    EXPECT_THROW((void)mixed.GetNumberSpan(), tijson::AccessException);
+    EXPECT_THROW((void)tijson::Parse("4").GetNumberSpan(), tijson::AccessException);
+    auto empty = tijson::Parse("[]");
+    EXPECT_TRUE(empty.PackNumbers());
+    EXPECT_TRUE(empty.GetNumberSpan().empty());
+}
+
+TEST(PACKED, MUTATE)
+{
+    auto          val  = tijson::Parse("[ 1, 2, 3 ]", packed);
+    tijson::Value copy = val;
+    EXPECT_TRUE(copy.IsPackedArray());
+    EXPECT_EQ(copy, val);
+
+    /* inserting any item converts the copy to Array */
+    copy.GetArray().push_back("x");
+    EXPECT_FALSE(copy.IsPackedArray());
+    EXPECT_EQ(copy.ItemCount(), 4);
+    EXPECT_NE(copy, val);
+    EXPECT_TRUE(val.IsPackedArray());
+
+    val[size_t(0)] = 10;
+    EXPECT_FALSE(val.IsPackedArray());
+    EXPECT_TRUE(val.PackNumbers());
+    EXPECT_EQ(val.GetNumberSpan()[0], 10);
+    EXPECT_THROW((void)val[size_t(3)], tijson::AccessException);
+}
+
+TEST(PACKED, MEMORY)
+{
+    std::string content = "[";
+    for (int i = 0; i < 1000; i++)
+        content += std::string(i ? "," : "") + std::to_string(i * 0.5);
+    content += "]";
+    auto plain = tijson::Parse(content);
+    auto pack  = tijson::Parse(content, packed);
+    EXPECT_EQ(pack.MemoryUsage().allocations, 1);
+    EXPECT_LT(pack.MemoryUsage().Total() * 4, plain.MemoryUsage().Total());
+
+    pack.ShrinkToFit();
+    EXPECT_EQ(pack.MemoryUsage().slack, 0);
+    EXPECT_EQ(pack.MemoryUsage().containers, 1000 * sizeof(double));
+}
+
+TEST(PACKED, CODECS)
+{
+    auto val = tijson::Parse(R"([ [ 1.5, 2, -3 ], { "a" : [ 0.25 ] } ])", packed);
+    EXPECT_EQ(tijson::MsgPack::Decode(tijson::MsgPack::Encode(val)), val);
+    EXPECT_EQ(tijson::Cbor::Decode(tijson::Cbor::Encode(val)), val);
+    auto image = tijson::Image::Write(val);
+    EXPECT_EQ(tijson::Image::Open(image.data(), image.size()).ToValue(), val);
+    EXPECT_TRUE(val[size_t(0)].IsPackedArray());
+}
@@ -59,4 +59,6 @@ TEST(PARSE_STRING, INVALID_UNICODE_SURROGATE)
     EXPECT_PARSE_THROW_MESSAGE("\"\\uD800\\\\\"", "INVALID_UNICODE_SURROGATE");
     EXPECT_PARSE_THROW_MESSAGE("\"\\uD800\\uDBFF\"", "INVALID_UNICODE_SURROGATE");
     EXPECT_PARSE_THROW_MESSAGE("\"\\uD800\\uE000\"", "INVALID_UNICODE_SURROGATE");
+    EXPECT_PARSE_THROW_MESSAGE("\"\\uDC00\"", "INVALID_UNICODE_SURROGATE");
+    EXPECT_PARSE_THROW_MESSAGE("\"\\uD834\\uDD1E\\uDFFF\"", "INVALID_UNICODE_SURROGATE");
 }
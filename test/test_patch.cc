@@ -0,0 +1,127 @@
+#include "test_utils.h"
+
+static tijson::PATCH_ERROR ApplyError(char const* doc, char const* patch, size_t offset)
+{
+    auto root = tijson::Parse(doc);
+    try {
+        tijson::Patch::Apply(root, tijson::Parse(patch));
+    }
+    catch (tijson::PatchException& e) {
+        EXPECT_EQ(e.GetOffset(), offset) << patch;
+        return e.GetErrorCode();
+    }
+    return tijson::PATCH_ERROR::NO_ERROR;
+}
+
+TEST(PATCH, DIFF)
+{
+    std::pair<char const*, char const*> cases[] = {
+        {"1", "2"},
+        {"1", "[ 1 ]"},
+        {R"({ "a" : 1, "b" : { "c" : [ 1, 2 ] } })", R"({ "b" : { "c" : [ 1, 3 ] }, "d" : 4 })"},
+        {"[ 1, 2, 3, 4, 5 ]", "[ 1, 9, 5 ]"},
+        {"[ 1, 5 ]", "[ 1, 2, 3, 4, 5 ]"},
+        {"[ [ 1 ], { \"x\" : 1 } ]", "[ [ 1, 2 ], { \"x\" : null } ]"},
+        {"{ \"a/b\" : 1, \"m~n\" : { \"~\" : 2 } }", "{ \"a/b\" : 2, \"m~n\" : {} }"},
+        {"[]", "[ 1, 2 ]"},
+        {"[ 1, 2 ]", "[]"},
+        {"{ \"a\" : [ 1 ] }", "{ \"a\" : { \"0\" : 1 } }"},
+    };
+    for (auto [from, to] : cases) {
+        auto root  = tijson::Parse(from);
+        auto patch = tijson::Patch::Diff(root, tijson::Parse(to));
+        tijson::Patch::Apply(root, patch);
+        EXPECT_EQ(root, tijson::Parse(to)) << from << " -> " << to << ": " << patch.Stringify();
+    }
+
+    /* equal documents give an empty patch, and one changed leaf one operation */
+    auto doc = tijson::Parse(R"({ "items" : [ { "id" : 1, "tags" : [ "a" ] },
+                                              { "id" : 2, "tags" : [ "b" ] } ] })");
+    EXPECT_EQ(tijson::Patch::Diff(doc, doc).ItemCount(), 0);
+    auto changed                        = doc;
+    changed["items"][size_t(1)]["id"] = 3;
+    EXPECT_EQ(tijson::Patch::Diff(doc, changed),
+              tijson::Parse(R"([ { "op" : "replace", "path" : "/items/1/id", "value" : 3 } ])"));
+}
+
+TEST(PATCH, APPLY)
+{
+    /* the examples of RFC 6902 appendix A */
+    auto root = tijson::Parse(R"({ "foo" : [ "bar", "baz" ], "q" : { "x" : 1 } })");
+    tijson::Patch::Apply(root, tijson::Parse(R"([
+        { "op" : "add", "path" : "/foo/1", "value" : "qux" },
+        { "op" : "add", "path" : "/foo/-", "value" : "end" },
+        { "op" : "remove", "path" : "/foo/0" },
+        { "op" : "replace", "path" : "/q/x", "value" : 2 },
+        { "op" : "copy", "from" : "/q", "path" : "/r" },
+        { "op" : "move", "from" : "/q/x", "path" : "/foo/0" },
+        { "op" : "test", "path" : "/r", "value" : { "x" : 2 } },
+        { "op" : "add", "path" : "/a~1b", "value" : [] }
+    ])"));
+    EXPECT_EQ(root, tijson::Parse(R"({ "foo" : [ 2, "qux", "baz", "end" ], "q" : {},
+                                       "r" : { "x" : 2 }, "a/b" : [] })"));
+
+    tijson::Patch::Apply(root, tijson::Parse(R"([ { "op" : "add", "path" : "", "value" : 1 } ])"));
+    EXPECT_EQ(root, tijson::Value(1));
+}
+
+TEST(PATCH, APPLY_ERROR)
+{
+    using tijson::PATCH_ERROR;
+    auto doc = R"({ "a" : { "b" : [ 1 ] } })";
+    EXPECT_EQ(ApplyError(doc, "{}", -1), PATCH_ERROR::INVALID_PATCH);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "jump", "path" : "/a" } ])", 0),
+              PATCH_ERROR::INVALID_PATCH);
+    EXPECT_EQ(ApplyError(doc, R"([ { "path" : "/a" } ])", 0), PATCH_ERROR::INVALID_PATCH);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "add", "path" : "a", "value" : 1 } ])", 0),
+              PATCH_ERROR::INVALID_PATCH);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "add", "path" : "/a/c" } ])", 0),
+              PATCH_ERROR::INVALID_PATCH);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "test", "path" : "/a/b/0", "value" : 1 },
+                                    { "op" : "remove", "path" : "/a/x" } ])",
+                         1),
+              PATCH_ERROR::PATH_NOT_FOUND);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "add", "path" : "/a/b/2", "value" : 1 } ])", 0),
+              PATCH_ERROR::PATH_NOT_FOUND);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "add", "path" : "/x/y", "value" : 1 } ])", 0),
+              PATCH_ERROR::PATH_NOT_FOUND);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "replace", "path" : "/x", "value" : 1 } ])", 0),
+              PATCH_ERROR::PATH_NOT_FOUND);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "test", "path" : "/a/b", "value" : [ 2 ] } ])", 0),
+              PATCH_ERROR::TEST_FAILED);
+    EXPECT_EQ(ApplyError(doc, R"([ { "op" : "move", "from" : "/a", "path" : "/a/b/0" } ])", 0),
+              PATCH_ERROR::INVALID_PATCH);
+
+    auto frozen = tijson::Parse(doc);
+    frozen.Freeze();
+    EXPECT_THROW(tijson::Patch::Apply(frozen, tijson::Parse("[]")), tijson::AccessException);
+}
+
+TEST(PATCH, MERGE)
+{
+    /* cases of RFC 7396 appendix A */
+    std::tuple<char const*, char const*, char const*> cases[] = {
+        {R"({ "a" : "b" })", R"({ "a" : "c" })", R"({ "a" : "c" })"},
+        {R"({ "a" : "b" })", R"({ "b" : "c" })", R"({ "a" : "b", "b" : "c" })"},
+        {R"({ "a" : "b" })", R"({ "a" : null })", R"({})"},
+        {R"({ "a" : [ { "b" : "c" } ] })", R"({ "a" : [ 1 ] })", R"({ "a" : [ 1 ] })"},
+        {R"([ "a", "b" ])", R"([ "c", "d" ])", R"([ "c", "d" ])"},
+        {R"({ "a" : "foo" })", "null", "null"},
+        {R"({ "e" : null })", R"({ "a" : 1 })", R"({ "e" : null, "a" : 1 })"},
+        {R"([ 1, 2 ])", R"({ "a" : "b", "c" : null })", R"({ "a" : "b" })"},
+        {"{}", R"({ "a" : { "bb" : { "ccc" : null } } })", R"({ "a" : { "bb" : {} } })"},
+    };
+    for (auto [target, patch, result] : cases) {
+        auto root = tijson::Parse(target);
+        tijson::Patch::ApplyMerge(root, tijson::Parse(patch));
+        EXPECT_EQ(root, tijson::Parse(result)) << target << " + " << patch;
+    }
+
+    auto from  = tijson::Parse(R"({ "a" : 1, "b" : { "c" : 2, "d" : 3 }, "e" : [ 1 ] })");
+    auto to    = tijson::Parse(R"({ "a" : 1, "b" : { "c" : 4 }, "e" : [ 1, 2 ], "f" : {} })");
+    auto patch = tijson::Patch::MergeDiff(from, to);
+    EXPECT_EQ(patch, tijson::Parse(R"({ "b" : { "c" : 4, "d" : null }, "e" : [ 1, 2 ],
+                                         "f" : {} })"));
+    tijson::Patch::ApplyMerge(from, patch);
+    EXPECT_EQ(from, to);
+}
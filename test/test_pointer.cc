@@ -0,0 +1,74 @@
+#include "test_utils.h"
+
+static char const* kDocument = R"({
+    "a" : { "b" : [ 0, 1, 2, { "c" : "deep" } ] },
+    "a/b" : 1, "m~n" : 2, "" : 3, " " : 4, "10" : 5
+})";
+
+TEST(POINTER, GET)
+{
+    auto root = tijson::Parse(kDocument);
+    EXPECT_EQ(*tijson::Pointer("").Get(root), root);
+    EXPECT_EQ(tijson::Pointer("/a/b/3/c").Get(root)->GetString(), "deep");
+    EXPECT_EQ(tijson::Pointer("/a/b/1").Get(root)->GetNumber(), 1);
+    EXPECT_EQ(tijson::Pointer("/a~1b").Get(root)->GetNumber(), 1);
+    EXPECT_EQ(tijson::Pointer("/m~0n").Get(root)->GetNumber(), 2);
+    EXPECT_EQ(tijson::Pointer("/").Get(root)->GetNumber(), 3);
+    EXPECT_EQ(tijson::Pointer("/ ").Get(root)->GetNumber(), 4);
+    EXPECT_EQ(tijson::Pointer("/10").Get(root)->GetNumber(), 5);
+
+    EXPECT_EQ(tijson::Pointer("/missing").Get(root), nullptr);
+    EXPECT_EQ(tijson::Pointer("/a/b/4").Get(root), nullptr);
+    EXPECT_EQ(tijson::Pointer("/a/b/01").Get(root), nullptr);
+    EXPECT_EQ(tijson::Pointer("/a/b/-").Get(root), nullptr);
+    EXPECT_EQ(tijson::Pointer("/a/b/0/x").Get(root), nullptr);
+    /* lookups never insert */
+    EXPECT_EQ(root, tijson::Parse(kDocument));
+
+    tijson::Value const& const_root = root;
+    EXPECT_EQ(tijson::Pointer("/a/b/0").Get(const_root)->GetNumber(), 0);
+
+    EXPECT_THROW(tijson::Pointer("a"), std::invalid_argument);
+    EXPECT_THROW(tijson::Pointer("/a~2"), std::invalid_argument);
+    EXPECT_EQ(tijson::Pointer("/a~1b/m~0n/").ToString(), "/a~1b/m~0n/");
+    EXPECT_EQ(tijson::Pointer("/a").Append("b/c").Append(2).ToString(), "/a/b~1c/2");
+}
+
+TEST(POINTER, SET_ERASE)
+{
+    auto root = tijson::Parse(kDocument);
+    EXPECT_TRUE(tijson::Pointer("/a/b/0").Set(root, "zero"));
+    EXPECT_TRUE(tijson::Pointer("/a/b/-").Set(root, 4.0));
+    EXPECT_TRUE(tijson::Pointer("/a/b/5").Set(root, 5.0));
+    EXPECT_TRUE(tijson::Pointer("/a/new").Set(root, true));
+    EXPECT_FALSE(tijson::Pointer("/a/b/7").Set(root, 7.0));
+    EXPECT_FALSE(tijson::Pointer("/x/y").Set(root, 1.0));
+    EXPECT_FALSE(tijson::Pointer("/a/b/0/x").Set(root, 1.0));
+    EXPECT_EQ(root["a"], tijson::Parse(R"({ "b" : [ "zero", 1, 2, { "c" : "deep" }, 4, 5 ],
+                                            "new" : true })"));
+
+    EXPECT_TRUE(tijson::Pointer("/a/b/1").Erase(root));
+    EXPECT_TRUE(tijson::Pointer("/a/new").Erase(root));
+    EXPECT_FALSE(tijson::Pointer("/a/new").Erase(root));
+    EXPECT_FALSE(tijson::Pointer("/a/b/9").Erase(root));
+    EXPECT_FALSE(tijson::Pointer("").Erase(root));
+    EXPECT_EQ(root["a"], tijson::Parse(R"({ "b" : [ "zero", 2, { "c" : "deep" }, 4, 5 ] })"));
+
+    EXPECT_TRUE(tijson::Pointer("").Set(root, 1.0));
+    EXPECT_EQ(root.GetNumber(), 1);
+}
+
+TEST(POINTER, RESOLVE)
+{
+    auto                        root = tijson::Parse(kDocument);
+    std::vector<tijson::Pointer> pointers{tijson::Pointer("/a/b/3/c"), tijson::Pointer("/10"),
+                                          tijson::Pointer("/a/b/9"),   tijson::Pointer("/a/b/0"),
+                                          tijson::Pointer(""),         tijson::Pointer("/a/b/3"),
+                                          tijson::Pointer("/a/x/y"),   tijson::Pointer("/a/b/3/c")};
+    auto result = tijson::Pointer::Resolve(root, pointers);
+    ASSERT_EQ(result.size(), pointers.size());
+    for (size_t i = 0; i < pointers.size(); i++)
+        EXPECT_EQ(result[i], pointers[i].Get(static_cast<tijson::Value const&>(root))) << i;
+    EXPECT_EQ(result[0]->GetString(), "deep");
+    EXPECT_EQ(result[2], nullptr);
+}
@@ -0,0 +1,47 @@
+#include "test_utils.h"
+
+static char const* kEvent = R"({
+    "user" : { "id" : 7, "name" : "meow", "tags" : [ "a", "b" ] },
+    "ts" : 1700000000,
+    "items" : [ { "sku" : "x-1", "qty" : 2 }, { "qty" : 1, "sku" : "y-2" }, { "qty" : 3 } ],
+    "payload" : { "deep" : [ 1, { "deeper" : [ true, false, null, "\"}]" ] } ], "n" : -1.5e10 },
+    "a/b" : { "c~d" : 1, "e" : 2 }
+})";
+
+TEST(PROJECTION, SELECT)
+{
+    auto root = tijson::Parse(kEvent, {"/user/id", "/ts", "/items/*/sku"});
+    EXPECT_EQ(root, tijson::Parse(R"({
+        "user" : { "id" : 7 }, "ts" : 1700000000,
+        "items" : [ { "sku" : "x-1" }, { "sku" : "y-2" }, {} ]
+    })"));
+
+    EXPECT_EQ(tijson::Parse(kEvent, {"/user"})["user"], tijson::Parse(kEvent)["user"]);
+    EXPECT_EQ(tijson::Parse(kEvent, {""}), tijson::Parse(kEvent));
+    EXPECT_EQ(tijson::Parse(kEvent, {"/user/tags/1", "/items/0/qty"}),
+              tijson::Parse(R"({ "user" : { "tags" : [ "b" ] }, "items" : [ { "qty" : 2 } ] })"));
+    EXPECT_EQ(tijson::Parse(kEvent, {"/a~1b/c~0d"}), tijson::Parse(R"({ "a/b" : { "c~d" : 1 } })"));
+    EXPECT_EQ(tijson::Parse(kEvent, {"/missing", "/ts/deeper"}),
+              tijson::Parse(R"({ "ts" : 1700000000 })"));
+    EXPECT_EQ(tijson::Parse(kEvent, {"/user", "/user/id"})["user"]["name"].GetString(), "meow");
+    EXPECT_EQ(tijson::Parse(R"({ "k\n" : 1, "k" : 2 })", {"/k\n"}),
+              tijson::Parse(R"({ "k\n" : 1 })"));
+    EXPECT_EQ(tijson::Parse("[ 1, 2, 3 ]", {"/*"}), tijson::Parse("[ 1, 2, 3 ]"));
+    EXPECT_EQ(tijson::Parse("42", {"/a"}), tijson::Parse("42"));
+}
+
+TEST(PROJECTION, SKIPPED_SUBTREES_ARE_VALIDATED)
+{
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1, "b" : [ 1, 2 })", {"/a"}).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_SQUARE_BRACKET);
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1, "b" : "\x" })", {"/a"}).GetParseErrorCode(),
+              tijson::PARSE_ERROR::INVALID_STRING_ESCAPE);
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1, "b" : 1e999 })", {"/a"}).GetParseErrorCode(),
+              tijson::PARSE_ERROR::NUMBER_TOO_BIG);
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1, "b" : 01 })", {"/a"}).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COMMA_OR_CURLY_BRACKET);
+    EXPECT_EQ(tijson::Parse(R"({ "a" : 1 } x)", {"/a"}).GetParseErrorCode(),
+              tijson::PARSE_ERROR::ROOT_NOT_SINGULAR);
+    EXPECT_EQ(tijson::Parse("", {"/a"}).GetParseErrorCode(), tijson::PARSE_ERROR::EXPECT_VALUE);
+    EXPECT_THROW(tijson::Projection({"a/b"}), std::invalid_argument);
+}
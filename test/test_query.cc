@@ -0,0 +1,75 @@
+#include "test_utils.h"
+
+static char const* kMessage = R"({
+    "header" : { "type" : "order", "id" : 12, "ok" : true, "a/b" : { "c~d" : null } },
+    "body" : [ { "sku" : "x-1", "qty" : 2 }, { "sku" : "y\n2", "qty" : 1.5 }, { "qty" : 3 } ],
+    "10" : "ten"
+})";
+
+TEST(QUERY, POINTER)
+{
+    auto type = tijson::Query::Compile("/header/type").First(kMessage);
+    ASSERT_TRUE(type.has_value());
+    EXPECT_EQ(type->GetType(), tijson::Value::TYPE::STRING);
+    EXPECT_EQ(type->GetText(), R"("order")");
+    EXPECT_EQ(type->GetRawString(), "order");
+    EXPECT_EQ(type->GetString(), "order");
+
+    EXPECT_EQ(tijson::Query::Compile("/header/id").First(kMessage)->GetNumber(), 12);
+    EXPECT_EQ(tijson::Query::Compile("/header/ok").First(kMessage)->GetBool(), true);
+    EXPECT_EQ(tijson::Query::Compile("/header/a~1b/c~0d").First(kMessage)->GetType(),
+              tijson::Value::TYPE::NUL);
+    EXPECT_EQ(tijson::Query::Compile("/body/1/sku").First(kMessage)->GetString(), "y\n2");
+    EXPECT_EQ(tijson::Query::Compile("/body/1/sku").First(kMessage)->GetRawString(), "y\\n2");
+    EXPECT_EQ(tijson::Query::Compile("/10").First(kMessage)->GetString(), "ten");
+    EXPECT_EQ(tijson::Query::Compile("/body/2").First(kMessage)->ToValue(),
+              tijson::Parse(R"({ "qty" : 3 })"));
+    EXPECT_EQ(tijson::Query::Compile("").First(kMessage)->ToValue(), tijson::Parse(kMessage));
+
+    EXPECT_FALSE(tijson::Query::Compile("/header/missing").First(kMessage).has_value());
+    EXPECT_FALSE(tijson::Query::Compile("/body/3").First(kMessage).has_value());
+    EXPECT_FALSE(tijson::Query::Compile("/body/01").First(kMessage).has_value());
+    EXPECT_FALSE(tijson::Query::Compile("/header/type/x").First(kMessage).has_value());
+    EXPECT_THROW((void)tijson::Query::Compile("/header/type").First(kMessage)->GetNumber(),
+                 tijson::AccessException);
+}
+
+TEST(QUERY, JSONPATH)
+{
+    auto skus = tijson::Query::Compile("$.body[*].sku").Evaluate(kMessage);
+    ASSERT_EQ(skus.size(), 2);
+    EXPECT_EQ(skus[0].GetString(), "x-1");
+    EXPECT_EQ(skus[1].GetString(), "y\n2");
+
+    auto qty = tijson::Query::Compile("$['body'][1][\"qty\"]").Evaluate(kMessage);
+    ASSERT_EQ(qty.size(), 1);
+    EXPECT_EQ(qty[0].GetNumber(), 1.5);
+
+    EXPECT_EQ(tijson::Query::Compile("$.header.*").Evaluate(kMessage).size(), 4);
+    EXPECT_EQ(tijson::Query::Compile("$.*").Evaluate(kMessage).size(), 3);
+    EXPECT_EQ(tijson::Query::Compile("$").Evaluate(kMessage).size(), 1);
+    EXPECT_EQ(tijson::Query::Compile("$.body.sku").Evaluate(kMessage).size(), 0);
+    EXPECT_EQ(tijson::Query::Compile("$.header[0]").Evaluate(kMessage).size(), 0);
+
+    EXPECT_THROW(tijson::Query::Compile("header"), std::invalid_argument);
+    EXPECT_THROW(tijson::Query::Compile("$.a["), std::invalid_argument);
+    EXPECT_THROW(tijson::Query::Compile("$.a[x]"), std::invalid_argument);
+    EXPECT_THROW(tijson::Query::Compile("$..a"), std::invalid_argument);
+}
+
+TEST(QUERY, ERROR_CODE)
+{
+    tijson::ParseException e("");
+    try {
+        (void)tijson::Query::Compile("$.*.x").Evaluate(R"({ "a" : { "x" : 1 }, "b" : [ 1, })");
+    }
+    catch (tijson::ParseException& err) {
+        e = err;
+    }
+    EXPECT_STREQ(e.what(), "INVALID_VALUE");
+    EXPECT_THROW((void)tijson::Query::Compile("/a").First(""), tijson::ParseException);
+    EXPECT_THROW((void)tijson::Query::Compile("/a").First("{} x"), tijson::ParseException);
+
+    /* a query without wildcards stops at its first match */
+    EXPECT_EQ(tijson::Query::Compile("/a").First(R"({ "a" : 1, oops)")->GetNumber(), 1);
+}
@@ -0,0 +1,102 @@
+#include "test_utils.h"
+
+using TYPE = tijson::Value::TYPE;
+
+static tijson::ParseOptions KeepRaw(tijson::Projection projection)
+{
+    tijson::ParseOptions options;
+    options.raw = std::move(projection);
+    return options;
+}
+
+TEST(RAW, SET_RAW)
+{
+    tijson::Value envelope = tijson::Object{{"id", 1}};
+    envelope["payload"].SetRaw(R"({"b":[1,2.50,"A"]})");
+    EXPECT_TRUE(envelope["payload"].IsRaw());
+    EXPECT_EQ(envelope["payload"].GetRawJson(), R"({"b":[1,2.50,"A"]})");
+    EXPECT_EQ(envelope["payload"].GetType(), TYPE::OBJECT);
+
+    /* spliced verbatim */
+    EXPECT_NE(envelope.Stringify().find(R"("payload":{"b":[1,2.50,"A"]})"), std::string::npos);
+    EXPECT_TRUE(envelope["payload"].IsRaw());
+
+    /* parsed on access */
+    EXPECT_EQ(envelope["payload"]["b"][size_t(2)].GetString(), "A");
+    EXPECT_FALSE(envelope["payload"].IsRaw());
+    EXPECT_THROW((void)envelope["payload"].GetRawJson(), tijson::AccessException);
+
+    tijson::Value num;
+    num.SetRaw(" -1.5e3 ");
+    EXPECT_EQ(num.GetType(), TYPE::NUMBER);
+    EXPECT_EQ(num.GetNumber(), -1500);
+
+    EXPECT_THROW(num.SetRaw("[1,"), tijson::ParseException);
+    EXPECT_THROW(num.SetRaw("1 2"), tijson::ParseException);
+    EXPECT_THROW(num.SetRaw(""), tijson::ParseException);
+}
+
+TEST(RAW, LAZY)
+{
+    tijson::Value val;
+    val.SetRaw("[ 1, tru ]", true);
+    EXPECT_TRUE(val.IsRaw());
+    /* the type comes from the first character, the text is checked when it is read */
+    EXPECT_EQ(val.GetType(), TYPE::ARRAY);
+    EXPECT_TRUE(val.IsArray());
+    EXPECT_FALSE(val.IsNull());
+    EXPECT_THROW((void)val.Stringify(), tijson::ParseException);
+    EXPECT_THROW((void)val[size_t(0)], tijson::ParseException);
+    EXPECT_TRUE(val.IsRaw());
+
+    val.SetRaw(" x", true);
+    EXPECT_TRUE(val.IsInvalid());
+    EXPECT_THROW((void)val.GetParseErrorCode(), tijson::ParseException);
+
+    val.SetRaw("[ true ]", true);
+    EXPECT_EQ(val.Stringify(), "[ true ]");
+    EXPECT_TRUE(val[size_t(0)].GetBool());
+}
+
+TEST(RAW, COPY_AND_COMPARE)
+{
+    tijson::Value raw;
+    raw.SetRaw(R"({ "a" : [ 1, 2 ] })");
+    tijson::Value copy = raw;
+    EXPECT_TRUE(copy.IsRaw());
+    EXPECT_GT(copy.MemoryUsage().strings, 0);
+    EXPECT_EQ(copy, raw);
+    EXPECT_TRUE(raw.IsRaw());
+
+    /* different text of the same value */
+    tijson::Value other;
+    other.SetRaw(R"({"a":[1,2]})");
+    EXPECT_EQ(other, raw);
+    EXPECT_FALSE(raw.IsRaw());
+    EXPECT_EQ(tijson::Parse(R"({ "a" : [ 1, 2 ] })"), copy);
+}
+
+TEST(RAW, PARSE_OPTION)
+{
+    char const* content = R"({ "id" : 7, "payload" : { "deep" : [ 1, 2 ] },
+                               "items" : [ { "blob" : [ true ], "n" : 1 }, 3 ] })";
+    auto val = tijson::Parse(content, KeepRaw({"/payload", "/items/*/blob"}));
+    EXPECT_FALSE(val.IsRaw());
+    EXPECT_EQ(val["id"].GetNumber(), 7);
+    EXPECT_TRUE(val["payload"].IsRaw());
+    EXPECT_EQ(val["payload"].GetRawJson(), R"({ "deep" : [ 1, 2 ] })");
+    EXPECT_TRUE(val["items"][size_t(0)]["blob"].IsRaw());
+    EXPECT_EQ(val["items"][size_t(0)]["blob"].GetRawJson(), "[ true ]");
+    EXPECT_FALSE(val["items"][size_t(0)]["n"].IsRaw());
+    EXPECT_EQ(val["items"][size_t(1)].GetNumber(), 3);
+    EXPECT_EQ(val, tijson::Parse(content));
+
+    auto whole = tijson::Parse(" [ 1 ] ", KeepRaw({""}));
+    EXPECT_EQ(whole.GetRawJson(), "[ 1 ]");
+
+    /* raw slices are checked */
+    EXPECT_EQ(tijson::Parse(R"({ "payload" : [ 1, ] })", KeepRaw({"/payload"})).GetParseErrorCode(),
+              tijson::PARSE_ERROR::INVALID_VALUE);
+    EXPECT_EQ(tijson::Parse(R"({ "payload" : 1 } x)", KeepRaw({"/payload"})).GetParseErrorCode(),
+              tijson::PARSE_ERROR::ROOT_NOT_SINGULAR);
+}
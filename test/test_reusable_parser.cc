@@ -0,0 +1,60 @@
+#include "test_utils.h"
+
+TEST(REUSABLE_PARSER, SAME_AS_PARSE)
+{
+    /* every document reuses what the ones before left, whatever its shape was */
+    tijson::ReusableParser parser;
+    tijson::Value          val;
+    for (auto content :
+         {"{ \"a\" : [ 1, \"x\", { \"b\" : null } ], \"c\" : \"y\" }", "[ 1, 2, 3, 4, 5 ]",
+          "{ \"c\" : [ true ], \"a\" : \"s\", \"d\" : {} }", "\"text\"", "[ [], {}, [ [ 1 ] ] ]",
+          "{ \"a\" : 1, \"a\" : 2, \"b\" : 3 }", "{ \"e\\\"k\" : \"\\u00e9\\n\" }", "1.5", "{}",
+          "[ { \"a\" : 1, \"b\" : 2 }, { \"b\" : 3, \"c\" : 4 }, { } ]", "null"}) {
+        parser.ParseInto(content, val);
+        EXPECT_EQ(val, tijson::Parse(content)) << content;
+        EXPECT_EQ(val.Stringify(), tijson::Parse(content).Stringify()) << content;
+    }
+    parser.ReleaseSpares();
+    EXPECT_EQ(parser.SpareCount(), 0);
+
+    /* items past the end of a shorter array are kept */
+    parser.ParseInto("[ 1, 2, { \"a\" : 3 } ]", val);
+    parser.ParseInto("[ 1 ]", val);
+    EXPECT_EQ(parser.SpareCount(), 2);
+    parser.ParseInto("[ 1, 2, { \"a\" : 4 }, 5 ]", val);
+    EXPECT_EQ(parser.SpareCount(), 0);
+    EXPECT_EQ(val, tijson::Parse("[ 1, 2, { \"a\" : 4 }, 5 ]"));
+}
+
+TEST(REUSABLE_PARSER, OTHER_LAYOUTS)
+{
+    /* values stored with ParseOptions layouts are replaced by plain ones */
+    tijson::ParseOptions options;
+    options.pack_numbers = true;
+    options.lazy_numbers = true;
+    auto val             = tijson::Parser::Parse("[ [ 1, 2 ], 3, { \"k\" : [] } ]", options);
+    auto keys            = std::make_shared<tijson::KeyTable>();
+    val[size_t(2)]       = tijson::Parser::Parse("{ \"k\" : 1 }", keys);
+    tijson::ReusableParser parser;
+    parser.ParseInto("[ [ \"a\" ], \"b\", { \"k\" : \"c\" } ]", val);
+    EXPECT_FALSE(val[size_t(1)].IsLazyNumber());
+    EXPECT_EQ(val, tijson::Parse("[ [ \"a\" ], \"b\", { \"k\" : \"c\" } ]"));
+}
+
+TEST(REUSABLE_PARSER, ERROR)
+{
+    tijson::ReusableParser parser;
+    tijson::Value          val;
+    for (auto content : {"", "[ 1, 2 ", "{ \"a\" 1 }", "{ 1 : 2 }", "[ 1 ] 2", "\"\\x\""}) {
+        try {
+            parser.ParseInto(content, val);
+            ADD_FAILURE() << content;
+        }
+        catch (tijson::ParseException& e) {
+            EXPECT_EQ(e.GetErrorCode(), tijson::Parse(content).GetParseErrorCode()) << content;
+        }
+    }
+    /* the partial document is reused by the next parse */
+    parser.ParseInto("{ \"a\" : [ 1 ] }", val);
+    EXPECT_EQ(val, tijson::Parse("{ \"a\" : [ 1 ] }"));
+}
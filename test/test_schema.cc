@@ -0,0 +1,137 @@
+#include "test_utils.h"
+
+// every document is validated twice: over the built value and over the event stream
+#define EXPECT_SCHEMA_ERROR(SCHEMA, TEST_CONTENT, TEST_ERROR_CODE)                    \
+    do {                                                                              \
+        EXPECT_EQ(SCHEMA.Validate(tijson::Parser::Parse(TEST_CONTENT)),               \
+                  tijson::SCHEMA_ERROR::TEST_ERROR_CODE);                             \
+        EXPECT_EQ(SCHEMA.ValidateStream(TEST_CONTENT), tijson::SCHEMA_ERROR::TEST_ERROR_CODE); \
+    } while (0)
+
+static tijson::Schema const& OrderSchema()
+{
+    static auto schema = tijson::Schema::Compile(tijson::Parse(R"({
+        "type" : "object",
+        "required" : [ "id", "items" ],
+        "additionalProperties" : false,
+        "properties" : {
+            "id" : { "type" : "integer", "minimum" : 1 },
+            "price" : { "type" : "number", "exclusiveMinimum" : 0, "maximum" : 1000 },
+            "status" : { "enum" : [ "new", "paid", [ 1, 2 ] ] },
+            "sku" : { "type" : "string", "pattern" : "^[a-z]+-[0-9]+$", "maxLength" : 8 },
+            "note" : { "type" : [ "string", "null" ], "minLength" : 2 },
+            "items" : {
+                "type" : "array", "minItems" : 1, "maxItems" : 3,
+                "items" : { "type" : "object", "required" : [ "n" ] }
+            }
+        }
+    })"));
+    return schema;
+}
+
+TEST(SCHEMA, VALID)
+{
+    auto const& schema = OrderSchema();
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "items" : [ { "n" : 1 } ] })", NO_ERROR);
+    EXPECT_SCHEMA_ERROR(schema,
+                        R"({ "id" : 7, "price" : 1000, "status" : [ 1, 2 ], "sku" : "ab-12",
+                             "note" : null, "items" : [ { "n" : [ ] }, { "n" : { }, "x" : 1 } ] })",
+                        NO_ERROR);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "note" : "¢¢", "items" : [ { "n" : 1 } ] })",
+                        NO_ERROR);
+}
+
+TEST(SCHEMA, INVALID)
+{
+    auto const& schema = OrderSchema();
+    EXPECT_SCHEMA_ERROR(schema, R"([ ])", TYPE_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1 })", REQUIRED_MISSING);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1.5, "items" : [ { "n" : 1 } ] })", TYPE_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 0, "items" : [ { "n" : 1 } ] })", BELOW_MINIMUM);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "price" : 0, "items" : [ { "n" : 1 } ] })",
+                        BELOW_MINIMUM);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "price" : 1e4, "items" : [ { "n" : 1 } ] })",
+                        ABOVE_MAXIMUM);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "status" : "old", "items" : [ { "n" : 1 } ] })",
+                        ENUM_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "status" : [ 1 ], "items" : [ { "n" : 1 } ] })",
+                        ENUM_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "sku" : "AB-12", "items" : [ { "n" : 1 } ] })",
+                        PATTERN_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "sku" : "abcd-1234", "items" : [ { "n" : 1 } ] })",
+                        STRING_TOO_LONG);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "note" : "¢", "items" : [ { "n" : 1 } ] })",
+                        STRING_TOO_SHORT);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "note" : 1, "items" : [ { "n" : 1 } ] })",
+                        TYPE_MISMATCH);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "items" : [ ] })", TOO_FEW_ITEMS);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "items" : [ {"n":1}, {"n":1}, {"n":1}, {"n":1} ] })",
+                        TOO_MANY_ITEMS);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "items" : [ { "m" : 1 } ] })", REQUIRED_MISSING);
+    EXPECT_SCHEMA_ERROR(schema, R"({ "id" : 1, "extra" : 1, "items" : [ { "n" : 1 } ] })",
+                        ADDITIONAL_PROPERTY);
+    EXPECT_EQ(schema.ValidateStream(R"({ "id" : 1, "items" : [ )"),
+              tijson::SCHEMA_ERROR::INVALID_JSON);
+}
+
+TEST(SCHEMA, INVALID_SCHEMA)
+{
+    auto compile = [](std::string_view content) {
+        try {
+            tijson::Schema::Compile(tijson::Parse(content));
+        }
+        catch (tijson::SchemaException& e) {
+            return e.GetErrorCode();
+        }
+        return tijson::SCHEMA_ERROR::NO_ERROR;
+    };
+    EXPECT_EQ(compile(R"({ "type" : "text" })"), tijson::SCHEMA_ERROR::INVALID_SCHEMA);
+    EXPECT_EQ(compile(R"({ "minLength" : -1 })"), tijson::SCHEMA_ERROR::INVALID_SCHEMA);
+    EXPECT_EQ(compile(R"({ "pattern" : "(" })"), tijson::SCHEMA_ERROR::INVALID_SCHEMA);
+    EXPECT_EQ(compile(R"({ "items" : 1 })"), tijson::SCHEMA_ERROR::INVALID_SCHEMA);
+    EXPECT_EQ(compile(R"({ "properties" : { "a" : true }, "title" : "t" })"),
+              tijson::SCHEMA_ERROR::NO_ERROR);
+
+    auto any = tijson::Schema::Compile(tijson::Parse("true"));
+    EXPECT_SCHEMA_ERROR(any, R"([ 1, { "a" : null } ])", NO_ERROR);
+
+    auto none = tijson::Schema::Compile(tijson::Parse("false"));
+    EXPECT_SCHEMA_ERROR(none, "1", TYPE_MISMATCH);
+    EXPECT_SCHEMA_ERROR(none, "[]", TYPE_MISMATCH);
+    auto forbidden = tijson::Schema::Compile(
+        tijson::Parse(R"({ "properties" : { "a" : false }, "items" : false })"));
+    EXPECT_SCHEMA_ERROR(forbidden, R"({ "b" : 1 })", NO_ERROR);
+    EXPECT_SCHEMA_ERROR(forbidden, R"({ "a" : null })", TYPE_MISMATCH);
+    EXPECT_SCHEMA_ERROR(forbidden, "[]", NO_ERROR);
+    EXPECT_SCHEMA_ERROR(forbidden, "[ 1 ]", TYPE_MISMATCH);
+}
+
+TEST(SCHEMA, BOUNDS)
+{
+    /* inclusive and exclusive bounds both apply, whatever the order of the keywords */
+    for (auto content : {R"({ "minimum" : 3, "exclusiveMinimum" : 5 })",
+                         R"({ "exclusiveMinimum" : 5, "minimum" : 3 })"}) {
+        auto schema = tijson::Schema::Compile(tijson::Parse(content));
+        EXPECT_SCHEMA_ERROR(schema, "4", BELOW_MINIMUM);
+        EXPECT_SCHEMA_ERROR(schema, "5", BELOW_MINIMUM);
+        EXPECT_SCHEMA_ERROR(schema, "5.5", NO_ERROR);
+    }
+    for (auto content : {R"({ "maximum" : 10, "exclusiveMaximum" : 5 })",
+                         R"({ "exclusiveMaximum" : 5, "maximum" : 10 })"}) {
+        auto schema = tijson::Schema::Compile(tijson::Parse(content));
+        EXPECT_SCHEMA_ERROR(schema, "7", ABOVE_MAXIMUM);
+        EXPECT_SCHEMA_ERROR(schema, "4", NO_ERROR);
+    }
+    auto tighter = tijson::Schema::Compile(
+        tijson::Parse(R"({ "exclusiveMinimum" : 1, "minimum" : 3, "maximum" : 8 })"));
+    EXPECT_SCHEMA_ERROR(tighter, "2", BELOW_MINIMUM);
+    EXPECT_SCHEMA_ERROR(tighter, "3", NO_ERROR);
+    EXPECT_SCHEMA_ERROR(tighter, "8", NO_ERROR);
+
+    /* draft 4 booleans modify minimum and maximum */
+    auto draft4 = tijson::Schema::Compile(tijson::Parse(R"({ "exclusiveMinimum" : true,
+        "minimum" : 3, "maximum" : 8, "exclusiveMaximum" : true })"));
+    EXPECT_SCHEMA_ERROR(draft4, "3", BELOW_MINIMUM);
+    EXPECT_SCHEMA_ERROR(draft4, "8", ABOVE_MAXIMUM);
+    EXPECT_SCHEMA_ERROR(draft4, "7.5", NO_ERROR);
+}
@@ -0,0 +1,116 @@
+#include "test_utils.h"
+
+static tijson::ParseOptions const shapes = [] {
+    tijson::ParseOptions options;
+    options.share_shapes = true;
+    return options;
+}();
+
+static char const* records = R"([
+    { "id" : 1, "name" : "a", "tags" : [ { "k" : 1 }, { "k" : 2 } ] },
+    { "id" : 2, "name" : "b", "tags" : [] },
+    { "id" : 3, "name" : "c", "tags" : [ { "k" : 3 } ] },
+    { "name" : "d", "id" : 4 },
+    { "name" : "e", "id" : 5, "tags" : null, "id" : 6 },
+    {},
+    "text"
+])";
+
+TEST(SHAPE, SHAPE)
+{
+    tijson::Shape shape;
+    EXPECT_EQ(shape.Add("id"), 0);
+    EXPECT_EQ(shape.Add("name"), 1);
+    EXPECT_EQ(shape.Add("id"), 0);
+    EXPECT_EQ(shape.size(), 2);
+    EXPECT_EQ(shape.Key(1), "name");
+    EXPECT_EQ(shape.Find("name"), 1);
+    EXPECT_EQ(shape.Find("none"), tijson::Shape::npos);
+    EXPECT_GT(shape.MemoryUsage(), sizeof(tijson::Shape));
+}
+
+TEST(SHAPE, PARSE)
+{
+    auto  val = tijson::Parse(records, shapes);
+    auto& arr = val.GetArray();
+    EXPECT_EQ(val, tijson::Parse(records));
+    EXPECT_TRUE(arr[0].IsShapedObject());
+    EXPECT_FALSE(arr[6].IsShapedObject());
+
+    EXPECT_EQ(arr[1]["name"].GetString(), "b");
+    EXPECT_EQ(arr[2]["tags"][size_t(0)]["k"].GetNumber(), 3);
+    EXPECT_EQ(arr[3].MemberCount(), 2);
+    EXPECT_EQ(arr[4]["id"].GetNumber(), 6);
+    EXPECT_EQ(arr[4].MemberCount(), 3);
+    EXPECT_EQ(arr[5].MemberCount(), 0);
+    EXPECT_EQ(arr[0].Find("none"), nullptr);
+    EXPECT_EQ(tijson::Parse(val.Stringify()), val);
+
+    /* equal objects of one shape, and equal objects of different shapes */
+    auto same = tijson::Parse(R"([ { "a" : 1, "b" : 2 }, { "a" : 1, "b" : 2 } ])", shapes);
+    EXPECT_EQ(same[size_t(0)], same[size_t(1)]);
+    auto swapped = tijson::Parse(R"([ { "a" : 1, "b" : 2 }, { "b" : 2, "a" : 1 } ])", shapes);
+    EXPECT_EQ(swapped[size_t(0)], swapped[size_t(1)]);
+    EXPECT_NE(swapped[size_t(0)], tijson::Parse(R"({ "a" : 1, "b" : 3 })"));
+
+    EXPECT_EQ(tijson::Parse(R"([ { "a" : 1 }, { "a" 1 } ])", shapes).GetParseErrorCode(),
+              tijson::PARSE_ERROR::MISS_COLON);
+}
+
+TEST(SHAPE, SHAPE_KEY)
+{
+    auto             val = tijson::Parse(records, shapes);
+    tijson::ShapeKey id("id");
+    tijson::ShapeKey tags("tags");
+    double           sum = 0;
+    for (auto const& item : val.GetArray()) {
+        if (item.GetType() != tijson::Value::TYPE::OBJECT)
+            continue;
+        if (auto member = item.Find(id))
+            sum += member->GetNumber();
+        if (auto member = item.Find(tags); member && member->GetType() == tijson::Value::TYPE::ARRAY)
+            sum += member->GetArray().size();
+    }
+    EXPECT_EQ(sum, 1 + 2 + 3 + 4 + 6 + 2 + 0 + 1);
+
+    /* plain objects are looked up by content */
+    EXPECT_EQ(tijson::Parse(R"({ "id" : 7 })").Find(id)->GetNumber(), 7);
+    EXPECT_EQ(tijson::Parse(R"({ "ids" : 7 })").Find(id), nullptr);
+}
+
+TEST(SHAPE, MUTATE)
+{
+    auto          val  = tijson::Parse(records, shapes);
+    tijson::Value copy = val[size_t(1)];
+    EXPECT_TRUE(copy.IsShapedObject());
+
+    /* inserting converts the copy to Object, the original keeps its shape */
+    copy["extra"] = true;
+    EXPECT_FALSE(copy.IsShapedObject());
+    EXPECT_EQ(copy.GetObject().size(), 4);
+    EXPECT_EQ(copy["name"].GetString(), "b");
+    EXPECT_TRUE(val[size_t(1)].IsShapedObject());
+    EXPECT_NE(copy, val[size_t(1)]);
+    copy.GetObject().erase("extra");
+    EXPECT_EQ(copy, val[size_t(1)]);
+
+    /* operator[] converts first, so its references survive later inserts */
+    auto& id = val[size_t(0)]["id"];
+    EXPECT_FALSE(val[size_t(0)].IsShapedObject());
+    val[size_t(0)]["extra"] = true;
+    id                      = 10;
+    EXPECT_EQ(val[size_t(0)].Find("id")->GetNumber(), 10);
+}
+
+TEST(SHAPE, MEMORY)
+{
+    std::string content = "[";
+    for (int i = 0; i < 100; i++)
+        content += std::string(i ? "," : "") +
+                   R"({ "identifier_long_key" : 1, "another_long_key_name" : "v" })";
+    content += "]";
+    auto plain  = tijson::Parse(content);
+    auto shaped = tijson::Parse(content, shapes);
+    EXPECT_EQ(shaped.MemoryUsage().strings, 0);
+    EXPECT_LT(shaped.MemoryUsage().Total() * 2, plain.MemoryUsage().Total());
+}
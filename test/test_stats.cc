@@ -0,0 +1,135 @@
+#include "test_utils.h"
+
+#ifdef TIJSON_ENABLE_STATS
+/* collect the stats of every call made in a scope */
+class StatsRecorder final
+{
+public:
+    StatsRecorder()
+    {
+        tijson::SetStatsCallback([this](tijson::Stats const& stats) { calls.push_back(stats); });
+    }
+    ~StatsRecorder() { tijson::SetStatsCallback(nullptr); }
+
+    std::vector<tijson::Stats> calls;
+};
+
+TEST(STATS, PARSE)
+{
+    std::string content =
+        R"({ "a" : [ 1, 2.5, [ true, false ] ], "b\n" : null, "long string value" : "x\tyé" })";
+    StatsRecorder recorder;
+    auto          root = tijson::Parser::Parse(content);
+    ASSERT_EQ(recorder.calls.size(), 1);
+    auto const& stats = recorder.calls[0];
+    EXPECT_EQ(stats.operation, tijson::Stats::OPERATION::PARSE);
+    EXPECT_EQ(stats.failed, false);
+    EXPECT_EQ(stats.bytes, content.size());
+    EXPECT_EQ(stats.nulls, 1);
+    EXPECT_EQ(stats.bools, 2);
+    EXPECT_EQ(stats.numbers, 2);
+    EXPECT_EQ(stats.numbers_converted, 2);
+    EXPECT_EQ(stats.strings, 1);
+    EXPECT_EQ(stats.arrays, 2);
+    EXPECT_EQ(stats.objects, 1);
+    EXPECT_EQ(stats.keys, 3);
+    EXPECT_EQ(stats.max_depth, 3);
+    EXPECT_EQ(stats.escapes, 2);
+    /* the long key leaves the small string buffer */
+    EXPECT_GE(stats.allocations, 6);
+    EXPECT_GT(stats.allocated_bytes, 0);
+    EXPECT_GE(stats.total_ns, stats.string_ns + stats.number_ns);
+}
+
+TEST(STATS, FAILED_PARSE)
+{
+    StatsRecorder recorder;
+    EXPECT_EQ(tijson::Parse("[ [ 1, ] ]").GetParseErrorCode(), tijson::PARSE_ERROR::INVALID_VALUE);
+    ASSERT_EQ(recorder.calls.size(), 1);
+    EXPECT_EQ(recorder.calls[0].failed, true);
+    EXPECT_EQ(recorder.calls[0].max_depth, 2);
+
+    /* the next call starts from zero depth */
+    tijson::Parse("1");
+    ASSERT_EQ(recorder.calls.size(), 2);
+    EXPECT_EQ(recorder.calls[1].failed, false);
+    EXPECT_EQ(recorder.calls[1].max_depth, 0);
+}
+
+TEST(STATS, STRINGIFY)
+{
+    auto          root = tijson::Parse(R"([ { "k" : "a/b" }, 1, null, "\"" ])");
+    StatsRecorder recorder;
+    auto          str = root.Stringify();
+    ASSERT_EQ(recorder.calls.size(), 1);
+    auto const& stats = recorder.calls[0];
+    EXPECT_EQ(stats.operation, tijson::Stats::OPERATION::STRINGIFY);
+    EXPECT_EQ(stats.bytes, str.size());
+    EXPECT_EQ(stats.arrays, 1);
+    EXPECT_EQ(stats.objects, 1);
+    EXPECT_EQ(stats.keys, 1);
+    EXPECT_EQ(stats.strings, 2);
+    EXPECT_EQ(stats.numbers, 1);
+    EXPECT_EQ(stats.nulls, 1);
+    EXPECT_EQ(stats.escapes, 2);
+    EXPECT_EQ(stats.max_depth, 2);
+
+    tijson::Stringify(std::vector<double>{1.5, 2});
+    ASSERT_EQ(recorder.calls.size(), 2);
+    EXPECT_EQ(recorder.calls[1].numbers_converted, 2);
+}
+
+namespace stats {
+struct Point
+{
+    int                        x = 0;
+    std::optional<std::string> label;
+    std::vector<double>        weights;
+    bool                       on = false;
+};
+TIJSON_DEFINE(Point, x, label, weights, on)
+}   // namespace stats
+
+TEST(STATS, BIND)
+{
+    /* bound types are counted like the Value they stand for */
+    std::string   content = R"({ "x" : 1, "label" : "a\b", "weights" : [ 0.5, 2 ], "on" : true,
+                                 "skip" : [ 1 ] })";
+    stats::Point  point;
+    StatsRecorder recorder;
+    EXPECT_EQ(tijson::ParseInto(content, point), tijson::PARSE_ERROR::NO_ERROR);
+    ASSERT_EQ(recorder.calls.size(), 1);
+    auto const& parse = recorder.calls[0];
+    EXPECT_EQ(parse.bytes, content.size());
+    EXPECT_EQ(parse.numbers, 3);
+    EXPECT_EQ(parse.strings, 1);
+    EXPECT_EQ(parse.bools, 1);
+    EXPECT_EQ(parse.arrays, 1);
+    EXPECT_EQ(parse.objects, 1);
+    EXPECT_EQ(parse.keys, 5);
+    EXPECT_EQ(parse.escapes, 1);
+    EXPECT_EQ(parse.max_depth, 2);
+
+    point.label.reset();
+    tijson::Stringify(std::vector<stats::Point>{point});
+    ASSERT_EQ(recorder.calls.size(), 2);
+    auto const& write = recorder.calls[1];
+    EXPECT_EQ(write.numbers, 3);
+    EXPECT_EQ(write.nulls, 1);
+    EXPECT_EQ(write.bools, 1);
+    EXPECT_EQ(write.arrays, 2);
+    EXPECT_EQ(write.objects, 1);
+    EXPECT_EQ(write.keys, 4);
+    EXPECT_EQ(write.max_depth, 3);
+}
+
+TEST(STATS, NO_CALLBACK)
+{
+    std::vector<tijson::Stats> calls;
+    tijson::SetStatsCallback([&](tijson::Stats const& stats) { calls.push_back(stats); });
+    tijson::SetStatsCallback(nullptr);
+    (void)tijson::Parse("[ 1 ]").Stringify();
+    EXPECT_EQ(calls.size(), 0);
+    EXPECT_EQ(tijson::CurrentStats(), nullptr);
+}
+#endif
@@ -0,0 +1,98 @@
+#include "test_utils.h"
+
+#include <random>
+
+static tijson::ParseOptions const strict = [] {
+    tijson::ParseOptions options;
+    options.strict_utf8 = true;
+    return options;
+}();
+
+/* offset of the first ill-formed sequence, decoded one code point at a time */
+static size_t ReferenceInvalidUtf8(std::string const& text)
+{
+    size_t pos = 0;
+    while (pos < text.size()) {
+        auto     lead = static_cast<unsigned char>(text[pos]);
+        size_t   len  = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        uint32_t code = len == 1 ? lead : lead & (0x7F >> len);
+        if (len == 0 || pos + len > text.size())
+            return pos;
+        for (size_t i = 1; i < len; i++) {
+            auto ch = static_cast<unsigned char>(text[pos + i]);
+            if ((ch & 0xC0) != 0x80)
+                return pos;
+            code = (code << 6) | (ch & 0x3F);
+        }
+        uint32_t min = len == 1 ? 0 : len == 2 ? 0x80 : len == 3 ? 0x800 : 0x10000;
+        if (code < min || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+            return pos;
+        pos += len;
+    }
+    return std::string::npos;
+}
+
+TEST(UTF8, FIND_INVALID)
+{
+    using tijson::Parser;
+    EXPECT_EQ(Parser::FindInvalidUtf8(""), std::string::npos);
+    EXPECT_EQ(Parser::FindInvalidUtf8("plain ascii"), std::string::npos);
+    EXPECT_EQ(Parser::FindInvalidUtf8("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF"),
+              std::string::npos);
+    EXPECT_EQ(Parser::FindInvalidUtf8("ab\x80"), 2);
+    EXPECT_EQ(Parser::FindInvalidUtf8("ab\xC0\xAF"), 2);
+    EXPECT_EQ(Parser::FindInvalidUtf8("ab\xED\xA0\x80"), 2);
+    EXPECT_EQ(Parser::FindInvalidUtf8("ab\xF4\x90\x80\x80"), 2);
+    EXPECT_EQ(Parser::FindInvalidUtf8("ab\xE2\x82"), 2);
+
+    /* errors at every position around the 16-byte blocks */
+    std::string text(70, 'a');
+    for (size_t i = 0; i < text.size(); i++) {
+        auto bad = text;
+        bad[i]   = '\xFF';
+        EXPECT_EQ(Parser::FindInvalidUtf8(bad), i);
+        auto cut = text.substr(0, i) + "\xF0\x9F\x98";
+        EXPECT_EQ(Parser::FindInvalidUtf8(cut), i);
+        EXPECT_EQ(Parser::FindInvalidUtf8(cut + "\x80" + text), std::string::npos);
+    }
+}
+
+TEST(UTF8, RANDOM)
+{
+    std::mt19937 rand(7);
+    char const*  pieces[] = {"a", "\"", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF",
+                             "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF", "\x80", "\xC1", "\xE0\x9F\x80",
+                             "\xED\xA0\x80", "\xF8"};
+    for (int round = 0; round < 3000; round++) {
+        std::string text;
+        auto        count = rand() % 60;
+        for (size_t i = 0; i < count; i++)
+            text += pieces[rand() % (round % 2 ? 8 : 13)];
+        ASSERT_EQ(tijson::Parser::FindInvalidUtf8(text), ReferenceInvalidUtf8(text)) << text;
+    }
+}
+
+TEST(UTF8, STRICT_PARSE)
+{
+    EXPECT_EQ(tijson::Parse("[ \"caf\xC3\xA9\" ]", strict)[size_t(0)].GetString(), "caf\xC3\xA9");
+    EXPECT_EQ(tijson::Parse("[ \"caf\xC3\" ]", strict).GetParseErrorCode(),
+              tijson::PARSE_ERROR::INVALID_UTF8);
+    EXPECT_EQ(tijson::Parse("[ \"caf\xC3\" ]").GetParseErrorCode(), tijson::PARSE_ERROR::NO_ERROR);
+
+    try {
+        (void)tijson::Parser::Parse("{ \"key\" : \"\xED\xA0\x80\" }", strict);
+        FAIL();
+    }
+    catch (tijson::ParseException& e) {
+        EXPECT_EQ(e.GetErrorCode(), tijson::PARSE_ERROR::INVALID_UTF8);
+        EXPECT_EQ(e.GetOffset(), 11);
+        EXPECT_STREQ(e.what(), "INVALID_UTF8");
+    }
+    try {
+        tijson::Parser::Validate(std::string(40, ' ') + "\"\xC0\x80\"");
+        FAIL();
+    }
+    catch (tijson::ParseException& e) {
+        EXPECT_EQ(e.GetOffset(), 41);
+    }
+}
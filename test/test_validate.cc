@@ -0,0 +1,49 @@
+#include "test_utils.h"
+
+#define EXPECT_VALIDATE(content, code) \
+    EXPECT_EQ(tijson::Validate(content), tijson::PARSE_ERROR::code)
+
+TEST(VALIDATE, SAME_CODES_AS_PARSE)
+{
+    for (auto content : {"", " null ", "nul", "[ 1, 2 ", "{ \"a\" 1 }", "{ 1 : 2 }",
+                         "{ \"a\" : 1 ", "\"a", "\"\\x\"", "\"\\u12G4\"", "\"\\uD800\"",
+                         "\"\\uDC00\"", "\"\x01\"", "1e400", "-", "0123",
+                         "[ true, false, null, -1.5e3 ]",
+                         "{ \"k\" : [ {}, [], \"\\u00e9\\n\" ] } "})
+        EXPECT_EQ(tijson::Validate(content), tijson::Parse(content).GetParseErrorCode())
+            << content;
+}
+
+TEST(VALIDATE, UTF8)
+{
+    EXPECT_VALIDATE("\"caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80\"", NO_ERROR);
+    EXPECT_VALIDATE("\"\xC3\"", INVALID_UTF8);           // truncated
+    EXPECT_VALIDATE("\"\xC3", INVALID_UTF8);             // truncated at the end
+    EXPECT_VALIDATE("\"\x80\"", INVALID_UTF8);           // lone continuation
+    EXPECT_VALIDATE("\"\xC0\xAF\"", INVALID_UTF8);       // overlong
+    EXPECT_VALIDATE("\"\xE0\x80\xAF\"", INVALID_UTF8);   // overlong
+    EXPECT_VALIDATE("\"\xED\xA0\x80\"", INVALID_UTF8);   // surrogate
+    EXPECT_VALIDATE("\"\xF4\x90\x80\x80\"", INVALID_UTF8);   // above U+10FFFF
+    EXPECT_VALIDATE("\"\xF5\x80\x80\x80\"", INVALID_UTF8);
+    EXPECT_VALIDATE("{ \"\xFF\" : 1 }", INVALID_UTF8);
+    /* escapes are checked too, a lone low surrogate would decode to ill-formed utf-8 */
+    EXPECT_VALIDATE("\"\\uDC00\"", INVALID_UNICODE_SURROGATE);
+
+    /* past the first 16 bytes, where whole blocks are scanned at once */
+    std::string text = "\"" + std::string(40, 'a') + "\xE2\x82\xAC" + std::string(40, 'b') + "\"";
+    EXPECT_VALIDATE(text, NO_ERROR);
+    text[50] = '\xFE';
+    EXPECT_VALIDATE(text, INVALID_UTF8);
+    text[50] = '\x1F';
+    EXPECT_VALIDATE(text, INVALID_STRING_CHAR);
+    /* the parser itself does not check utf-8 */
+    EXPECT_EQ(tijson::Parse("\"\xFF\"").GetParseErrorCode(), tijson::PARSE_ERROR::NO_ERROR);
+}
+
+TEST(VALIDATE, LONG_STRINGS)
+{
+    std::string text = "[\"" + std::string(100, 'x') + "\\\"" + std::string(20, 'y') + "\"]";
+    EXPECT_VALIDATE(text, NO_ERROR);
+    EXPECT_VALIDATE(text.substr(0, 60), MISS_QUOTATION_MARK);
+    EXPECT_EQ(tijson::Parse(text)[size_t(0)].GetString().size(), 121);
+}